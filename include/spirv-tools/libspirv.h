@@ -632,6 +632,19 @@ typedef enum {
   spv_validator_limit_max_id_bound,
 } spv_validator_limit;
 
+// The sets of checks the SPIR-V Validator can run.
+typedef enum spv_validator_level_t {
+  // Runs every check.  This is the default.
+  SPV_VALIDATOR_LEVEL_FULL,
+  // Runs the structural checks only: the module must parse, follow the
+  // logical layout, define the <id>s it uses, have a well formed control flow
+  // graph, and pass the checks of the remaining instruction families.  The
+  // image, built-in variable, block layout and ray tracing checks are
+  // skipped, so a module accepted at this level may still be invalid.
+  SPV_VALIDATOR_LEVEL_FAST,
+  SPV_FORCE_32_BIT_ENUM(spv_validator_level_t)
+} spv_validator_level_t;
+
 // Returns a string describing the given SPIR-V target environment.
 SPIRV_TOOLS_EXPORT const char* spvTargetEnvDescription(spv_target_env env);
 
@@ -779,6 +792,17 @@ SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetAllowVulkan32BitBitwise(
 SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetFriendlyNames(
     spv_validator_options options, bool val);
 
+// Records the number of threads the validator may use for the per-instruction
+// checks of function bodies.  Values of 0 and 1 validate serially, which is
+// the default.  The diagnostic reported is the same for any thread count.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetNumThreads(
+    spv_validator_options options, uint32_t num_threads);
+
+// Records the set of checks the validator runs.  Defaults to
+// SPV_VALIDATOR_LEVEL_FULL.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetLevel(
+    spv_validator_options options, spv_validator_level_t level);
+
 // Creates an optimizer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvOptimizerOptionsDestroy|.
@@ -838,6 +862,15 @@ SPIRV_TOOLS_EXPORT void spvReducerOptionsSetFailOnValidationError(
 SPIRV_TOOLS_EXPORT void spvReducerOptionsSetTargetFunction(
     spv_reducer_options options, uint32_t target_function);
 
+// Sets the number of candidate reductions the reducer may evaluate
+// concurrently.  Values of 0 and 1 evaluate one candidate at a time, which is
+// the default.  With more threads the interestingness function is called
+// from several threads at once, so it must be thread-safe.  The result of the
+// reduction does not depend on the number of threads as long as the
+// interestingness function is deterministic.
+SPIRV_TOOLS_EXPORT void spvReducerOptionsSetNumThreads(
+    spv_reducer_options options, uint32_t num_threads);
+
 // Creates a fuzzer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvFuzzerOptionsDestroy|.
@@ -170,6 +170,18 @@ class SPIRV_TOOLS_EXPORT ValidatorOptions {
     spvValidatorOptionsSetFriendlyNames(options_, val);
   }
 
+  // Records the number of threads the validator may use for the
+  // per-instruction checks of function bodies.  Values of 0 and 1 validate
+  // serially.
+  void SetNumThreads(uint32_t num_threads) {
+    spvValidatorOptionsSetNumThreads(options_, num_threads);
+  }
+
+  // Records the set of checks the validator runs.  See spv_validator_level_t.
+  void SetLevel(spv_validator_level_t level) {
+    spvValidatorOptionsSetLevel(options_, level);
+  }
+
  private:
   spv_validator_options options_;
 };
@@ -243,6 +255,11 @@ class SPIRV_TOOLS_EXPORT ReducerOptions {
     spvReducerOptionsSetTargetFunction(options_, target_function);
   }
 
+  // See spvReducerOptionsSetNumThreads.
+  void set_num_threads(uint32_t num_threads) {
+    spvReducerOptionsSetNumThreads(options_, num_threads);
+  }
+
  private:
   spv_reducer_options options_;
 };
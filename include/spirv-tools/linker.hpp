@@ -84,6 +84,23 @@ class SPIRV_TOOLS_EXPORT LinkerOptions {
     has_fnvar_capabilities_ = fnvar_capabilities;
   }
 
+  // Returns whether the input modules should be loaded and merged one at a
+  // time rather than all being loaded up front.
+  //
+  // In streaming mode the instructions of each input module are moved into
+  // the linked module instead of being copied, and the types identical to a
+  // type of a previous module are merged as they are read, so that at most
+  // one input module is held in memory besides the linked one.  The output is
+  // the same as in the default mode, except for the ids when the inputs have
+  // NonSemantic DebugLine or DebugNoLine instructions: the loader adds some of
+  // those, and in this mode it takes their ids from the linked module rather
+  // than from their own module.  This mode is ignored when generating a
+  // multitarget module, which needs all the input modules at once.
+  bool GetStreaming() const { return streaming_; }
+
+  // Sets whether the input modules should be loaded and merged one at a time.
+  void SetStreaming(bool streaming) { streaming_ = streaming; }
+
   std::vector<std::string> GetInFiles() const { return in_files_; }
   void SetInFiles(std::vector<std::string> in_files) { in_files_ = in_files; }
 
@@ -96,6 +113,7 @@ class SPIRV_TOOLS_EXPORT LinkerOptions {
   std::string fnvar_targets_csv_{""};
   std::string fnvar_architectures_csv_{""};
   bool has_fnvar_capabilities_ = false;
+  bool streaming_{false};
   std::vector<std::string> in_files_{{}};
 };
 
@@ -220,6 +220,18 @@ class SPIRV_TOOLS_EXPORT Optimizer {
            std::vector<uint32_t>* optimized_binary,
            const spv_optimizer_options opt_options) const;
 
+  // Loads |base_binary| as the module template of this optimizer.  When the
+  // module-level instructions (everything preceding the first function) of a
+  // binary given to Run() are identical to those of the template, they are
+  // copied from the already loaded template instead of being parsed again.
+  // This speeds up optimizing many variants of a shader which share their
+  // types, constants and decorations.  Binaries that do not match the
+  // template are loaded as usual.
+  //
+  // Returns false if |base_binary| cannot be loaded, in which case no template
+  // is used.  Should be called before calling Run().
+  bool SetModuleTemplate(const uint32_t* base_binary, size_t base_binary_size);
+
   // Returns a vector of strings with all the pass names added to this
   // optimizer's pass manager. These strings are valid until the associated
   // pass manager is destroyed.
@@ -235,6 +247,14 @@ class SPIRV_TOOLS_EXPORT Optimizer {
   // |out| output stream.
   Optimizer& SetTimeReport(std::ostream* out);
 
+  // Sets the option to profile each pass.  For every pass, the profile holds
+  // its wall time, the analyses it built and invalidated, the instructions it
+  // created and killed, the bytes it allocated for instructions and basic
+  // blocks, and its def-use updates.  After the passes ran, the profile is
+  // written to |out| as JSON, or as Chrome trace events if |chrome_trace| is
+  // true.  If |out| is null, then no profile is recorded.
+  Optimizer& SetPassProfile(std::ostream* out, bool chrome_trace = false);
+
   // Sets the option to validate the module after each pass.
   Optimizer& SetValidateAfterAll(bool validate);
 
@@ -181,9 +181,33 @@ class Parser {
   // Returns the endian-corrected word at the given position.
   uint32_t peekAt(size_t index) const {
     assert(index < _.num_words);
+    if (!_.requires_endian_conversion) return _.words[index];
     return spvFixWord(_.words[index], _.endian);
   }
 
+  // Records |type_id| as the type of the result id |id|.  Returns false if
+  // |id| was already defined.
+  bool recordTypeOfId(uint32_t id, uint32_t type_id) {
+    if (id < _.dense_id_types.size()) {
+      IdType& entry = _.dense_id_types[id];
+      if (entry.defined) return false;
+      entry = {type_id, true};
+      return true;
+    }
+    return _.sparse_id_types.emplace(id, type_id).second;
+  }
+
+  // Returns the type recorded for the result id |id|, or nullptr if |id| is
+  // not defined yet.
+  const uint32_t* findTypeOfId(uint32_t id) const {
+    if (id < _.dense_id_types.size()) {
+      const IdType& entry = _.dense_id_types[id];
+      return entry.defined ? &entry.type_id : nullptr;
+    }
+    auto iter = _.sparse_id_types.find(id);
+    return iter == _.sparse_id_types.end() ? nullptr : &iter->second;
+  }
+
   // Data members
 
   const spvtools::AssemblyGrammar grammar_;        // SPIR-V syntax utility.
@@ -196,6 +220,12 @@ class Parser {
   // passed to the callback as raw OpUnknown data instead of returning an error.
   bool handle_unknown_opcodes_ = false;
 
+  // The type of a result id, if it was defined.
+  struct IdType {
+    uint32_t type_id;
+    bool defined;
+  };
+
   // Describes the format of a typed literal number.
   struct NumberType {
     spv_number_kind_t type;
@@ -236,10 +266,15 @@ class Parser {
     // Cleared by parseInstruction immediately before calling emitAsUnknown.
     bool retry_instruction_as_unknown_ = false;
 
-    // Maps a result ID to its type ID.  By convention:
+    // Map a result ID to its type ID.  By convention:
     //  - a result ID that is a type definition maps to itself.
     //  - a result ID without a type maps to 0.  (E.g. for OpLabel)
-    std::unordered_map<uint32_t, uint32_t> id_to_type_id;
+    // The ids below the bound of the module are looked up in a vector, so
+    // that most modules need no hashing.  The vector is no longer than the
+    // module, since every id takes a word to define, and the other ids go to
+    // the map.
+    std::vector<IdType> dense_id_types;
+    std::unordered_map<uint32_t, uint32_t> sparse_id_types;
     // Maps a type ID to its number type description.
     std::unordered_map<uint32_t, NumberType> type_id_to_number_type_info;
     // Maps an ExtInstImport id to the extended instruction type.
@@ -288,6 +323,9 @@ spv_result_t Parser::parseModule() {
     return diagnostic(SPV_ERROR_INTERNAL)
            << "Internal error: unhandled header parse failure";
   }
+  _.dense_id_types.resize(
+      std::min(static_cast<size_t>(header.bound), _.num_words), {0, false});
+
   if (parsed_header_fn_) {
     if (auto error = parsed_header_fn_(user_data_, _.endian, header.magic,
                                        header.version, header.generator,
@@ -318,9 +356,12 @@ spv_result_t Parser::parseInstruction() {
 
   // If the module's endianness is different from the host native endianness,
   // then converted_words contains the endian-translated words in the
-  // instruction.
-  _.endian_converted_words.clear();
-  _.endian_converted_words.push_back(first_word);
+  // instruction.  Otherwise the instruction is handed out in place, and
+  // converted_words stays empty.
+  if (_.requires_endian_conversion) {
+    _.endian_converted_words.clear();
+    _.endian_converted_words.push_back(first_word);
+  }
 
   // After a successful parse of the instruction, the inst.operands member
   // will point to this vector's storage.
@@ -354,9 +395,9 @@ spv_result_t Parser::parseInstruction() {
     }
     // Repopulate endian_converted_words from scratch.  The operand loop may
     // have partially filled it before the unknown enum was detected.
-    _.endian_converted_words.clear();
-    _.endian_converted_words.push_back(first_word);
     if (_.requires_endian_conversion) {
+      _.endian_converted_words.clear();
+      _.endian_converted_words.push_back(first_word);
       for (uint16_t i = 1; i < inst_word_count; i++) {
         _.endian_converted_words.push_back(peekAt(inst_offset + i));
       }
@@ -433,12 +474,10 @@ spv_result_t Parser::parseInstruction() {
   // Check the computed length of the endian-converted words vector against
   // the declared number of words in the instruction.  If endian conversion
   // is required, then they should match.  If no endian conversion was
-  // performed, then the vector only contains the initial opcode/word-count
-  // word.
+  // performed, then the vector is not used.
   assert(!_.requires_endian_conversion ||
          (inst_word_count == _.endian_converted_words.size()));
-  assert(_.requires_endian_conversion ||
-         (_.endian_converted_words.size() == 1));
+  assert(_.requires_endian_conversion || _.endian_converted_words.empty());
 
   if (_.requires_endian_conversion) {
     // We must wait until here to set this pointer, because the vector might
@@ -512,15 +551,15 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       inst->result_id = word;
       // Save the result ID to type ID mapping.
       // In the grammar, type ID always appears before result ID.
-      if (_.id_to_type_id.find(inst->result_id) != _.id_to_type_id.end())
-        return diagnostic(SPV_ERROR_INVALID_ID)
-               << "Id " << inst->result_id << " is defined more than once";
-      // Record it.
       // A regular value maps to its type.  Some instructions (e.g. OpLabel)
       // have no type Id, and will map to 0.  The result Id for a
       // type-generating instruction (e.g. OpTypeInt) maps to itself.
-      _.id_to_type_id[inst->result_id] =
-          spvOpcodeGeneratesType(opcode) ? inst->result_id : inst->type_id;
+      if (!recordTypeOfId(inst->result_id, spvOpcodeGeneratesType(opcode)
+                                               ? inst->result_id
+                                               : inst->type_id)) {
+        return diagnostic(SPV_ERROR_INVALID_ID)
+               << "Id " << inst->result_id << " is defined more than once";
+      }
       break;
 
     case SPV_OPERAND_TYPE_ID:
@@ -627,13 +666,12 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
         // The literal operands have the same type as the value
         // referenced by the selector Id.
         const uint32_t selector_id = peekAt(inst_offset + 1);
-        const auto type_id_iter = _.id_to_type_id.find(selector_id);
-        if (type_id_iter == _.id_to_type_id.end() ||
-            type_id_iter->second == 0) {
+        const uint32_t* selector_type_id = findTypeOfId(selector_id);
+        if (selector_type_id == nullptr || *selector_type_id == 0) {
           return diagnostic() << "Invalid OpSwitch: selector id " << selector_id
                               << " has no type";
         }
-        uint32_t type_id = type_id_iter->second;
+        uint32_t type_id = *selector_type_id;
 
         if (selector_id == type_id) {
           // Recall that by convention, a result ID that is a type definition
@@ -42,17 +42,6 @@ class CFA {
     bb_iter iter;   ///< Iterator to the current child node being processed
   };
 
-  /// Returns true if a block with @p id is found in the @p work_list vector
-  ///
-  /// @param[in] work_list  Set of blocks visited in the depth first
-  /// traversal
-  ///                       of the CFG
-  /// @param[in] id         The ID of the block being checked
-  ///
-  /// @return true if the edge work_list.back().block->id() => id is a back-edge
-  static bool FindInWorkList(const std::vector<block_info>& work_list,
-                             uint32_t id);
-
  public:
   /// @brief Depth first traversal starting from the \p entry BasicBlock
   ///
@@ -109,15 +98,17 @@ class CFA {
 
   /// @brief Calculates dominator edges for a set of blocks
   ///
-  /// Computes dominators using the algorithm of Cooper, Harvey, and Kennedy
-  /// "A Simple, Fast Dominance Algorithm", 2001.
+  /// Computes dominators using the Semi-NCA algorithm described in Georgiadis,
+  /// Tarjan, and Werneck "Finding Dominators in Practice", 2006, which is a
+  /// variant of the algorithm of Lengauer and Tarjan.  The blocks are indexed
+  /// densely by their position in @p postorder, so the computation does not
+  /// look up blocks in hash tables after the initial numbering.
   ///
   /// The algorithm assumes there is a unique root node (a node without
   /// predecessors), and it is therefore at the end of the postorder vector.
   ///
   /// This function calculates the dominator edges for a set of blocks in the
   /// CFG.
-  /// Uses the dominator algorithm by Cooper et al.
   ///
   /// @param[in] postorder        A vector of blocks in post order traversal
   /// order
@@ -128,10 +119,9 @@ class CFA {
   ///
   /// @return the dominator tree of the graph, as a vector of pairs of nodes.
   /// The first node in the pair is a node in the graph. The second node in the
-  /// pair is its immediate dominator in the sense of Cooper et.al., where a
-  /// block
-  /// without predecessors (such as the root node) is its own immediate
-  /// dominator.
+  /// pair is its immediate dominator, where the root node and the blocks that
+  /// are not reachable from it are their own immediate dominator.  The pairs
+  /// are in the order of @p postorder.
   static std::vector<std::pair<BB*, BB*>> CalculateDominators(
       const std::vector<cbb_ptr>& postorder, get_blocks_func predecessor_func);
 
@@ -153,15 +143,6 @@ class CFA {
       get_blocks_func succ_func, get_blocks_func pred_func);
 };
 
-template <class BB>
-bool CFA<BB>::FindInWorkList(const std::vector<block_info>& work_list,
-                             uint32_t id) {
-  for (const auto& b : work_list) {
-    if (b.block->id() == id) return true;
-  }
-  return false;
-}
-
 template <class BB>
 void CFA<BB>::DepthFirstTraversal(const BB* entry,
                                   get_blocks_func successor_func,
@@ -184,7 +165,10 @@ void CFA<BB>::DepthFirstTraversal(
   assert(postorder && "The postorder function cannot be empty.");
   assert(terminal && "The terminal function cannot be empty.");
 
-  std::unordered_set<uint32_t> processed;
+  // Maps the id of each processed block to whether it is in the work list, so
+  // that a single lookup per edge tells whether the edge leads to a new block
+  // or is a back-edge.
+  std::unordered_map<uint32_t, bool> on_work_list;
 
   /// NOTE: work_list is the sequence of nodes from the root node to the node
   /// being processed in the traversal
@@ -193,24 +177,24 @@ void CFA<BB>::DepthFirstTraversal(
 
   work_list.push_back({entry, std::begin(*successor_func(entry))});
   preorder(entry);
-  processed.insert(entry->id());
+  on_work_list[entry->id()] = true;
 
   while (!work_list.empty()) {
     block_info& top = work_list.back();
     if (terminal(top.block) || top.iter == end(*successor_func(top.block))) {
       postorder(top.block);
+      on_work_list[top.block->id()] = false;
       work_list.pop_back();
     } else {
       BB* child = *top.iter;
       top.iter++;
-      if (backedge && FindInWorkList(work_list, child->id())) {
-        backedge(top.block, child);
-      }
-      if (processed.count(child->id()) == 0) {
+      const auto processed = on_work_list.emplace(child->id(), true);
+      if (processed.second) {
         preorder(child);
         work_list.emplace_back(
             block_info{child, std::begin(*successor_func(child))});
-        processed.insert(child->id());
+      } else if (backedge && processed.first->second) {
+        backedge(top.block, child);
       }
     }
   }
@@ -219,91 +203,121 @@ void CFA<BB>::DepthFirstTraversal(
 template <class BB>
 std::vector<std::pair<BB*, BB*>> CFA<BB>::CalculateDominators(
     const std::vector<cbb_ptr>& postorder, get_blocks_func predecessor_func) {
-  struct block_detail {
-    size_t dominator;  ///< The index of blocks's dominator in post order array
-    size_t postorder_index;  ///< The index of the block in the post order array
-  };
-  const size_t undefined_dom = postorder.size();
-
-  std::unordered_map<cbb_ptr, block_detail> idoms;
-  for (size_t i = 0; i < postorder.size(); i++) {
-    idoms[postorder[i]] = {undefined_dom, i};
+  const size_t num_blocks = postorder.size();
+  if (num_blocks == 0) return {};
+
+  // Number the blocks by their position in |postorder|, and get the edges
+  // between them in terms of those numbers.  Predecessors that are not in
+  // |postorder| are ignored.
+  std::unordered_map<cbb_ptr, size_t> postorder_index;
+  postorder_index.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) {
+    postorder_index[postorder[i]] = i;
   }
-  idoms[postorder.back()].dominator = idoms[postorder.back()].postorder_index;
-
-  bool changed = true;
-  while (changed) {
-    changed = false;
-    for (auto b = postorder.rbegin() + 1; b != postorder.rend(); ++b) {
-      const std::vector<BB*>& predecessors = *predecessor_func(*b);
-      // Find the first processed/reachable predecessor that is reachable
-      // in the forward traversal.
-      auto res = std::find_if(std::begin(predecessors), std::end(predecessors),
-                              [&idoms, undefined_dom](BB* pred) {
-                                return idoms.count(pred) &&
-                                       idoms[pred].dominator != undefined_dom;
-                              });
-      if (res == end(predecessors)) continue;
-      const BB* idom = *res;
-      size_t idom_idx = idoms[idom].postorder_index;
-
-      // all other predecessors
-      for (const auto* p : predecessors) {
-        if (idom == p) continue;
-        // Only consider nodes reachable in the forward traversal.
-        // Otherwise the intersection doesn't make sense and will never
-        // terminate.
-        if (!idoms.count(p)) continue;
-        if (idoms[p].dominator != undefined_dom) {
-          size_t finger1 = idoms[p].postorder_index;
-          size_t finger2 = idom_idx;
-          while (finger1 != finger2) {
-            while (finger1 < finger2) {
-              finger1 = idoms[postorder[finger1]].dominator;
-            }
-            while (finger2 < finger1) {
-              finger2 = idoms[postorder[finger2]].dominator;
-            }
-          }
-          idom_idx = finger1;
-        }
-      }
-      if (idoms[*b].dominator != idom_idx) {
-        idoms[*b].dominator = idom_idx;
-        changed = true;
+  std::vector<std::vector<size_t>> preds(num_blocks);
+  std::vector<std::vector<size_t>> succs(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) {
+    for (const BB* p : *predecessor_func(postorder[i])) {
+      const auto it = postorder_index.find(p);
+      if (it == postorder_index.end()) continue;
+      preds[i].push_back(it->second);
+      succs[it->second].push_back(i);
+    }
+  }
+
+  // Number the blocks reachable from the root in depth first preorder, and
+  // record the parent of each of them in the depth first spanning tree.
+  // |vertex| maps preorder numbers back to postorder indices.
+  const size_t undefined = num_blocks;
+  std::vector<size_t> preorder_number(num_blocks, undefined);
+  std::vector<size_t> vertex;
+  std::vector<size_t> parent;
+  vertex.reserve(num_blocks);
+  parent.reserve(num_blocks);
+  {
+    std::vector<std::pair<size_t, size_t>> stack;  // (block, next successor)
+    const size_t root = num_blocks - 1;
+    preorder_number[root] = 0;
+    vertex.push_back(root);
+    parent.push_back(0);
+    stack.push_back({root, 0});
+    while (!stack.empty()) {
+      auto& top = stack.back();
+      if (top.second == succs[top.first].size()) {
+        stack.pop_back();
+        continue;
       }
+      const size_t child = succs[top.first][top.second++];
+      if (preorder_number[child] != undefined) continue;
+      preorder_number[child] = vertex.size();
+      parent.push_back(preorder_number[top.first]);
+      vertex.push_back(child);
+      stack.push_back({child, 0});
     }
   }
 
-  std::vector<std::pair<bb_ptr, bb_ptr>> out;
-  for (auto idom : idoms) {
-    // At this point if there is no dominator for the node, just make it
-    // reflexive.
-    auto dominator = std::get<1>(idom).dominator;
-    if (dominator == undefined_dom) {
-      dominator = std::get<1>(idom).postorder_index;
+  // Compute the semidominators in reverse preorder, using a forest with path
+  // compression to find the minimum semidominator on a tree path.  The
+  // forest is made of the blocks processed so far, linked to their parents.
+  const size_t num_reachable = vertex.size();
+  std::vector<size_t> semi(num_reachable);
+  std::vector<size_t> label(num_reachable);
+  std::vector<size_t> ancestor(num_reachable, undefined);
+  for (size_t v = 0; v < num_reachable; v++) {
+    semi[v] = v;
+    label[v] = v;
+  }
+  std::vector<size_t> path;
+  auto eval = [&semi, &label, &ancestor, &path, undefined](size_t v) {
+    if (ancestor[v] == undefined) return v;
+    // Compress the path from |v| to the root of its tree, starting from the
+    // top, so that each node gets the minimum label of its ancestors.
+    size_t u = v;
+    while (ancestor[ancestor[u]] != undefined) {
+      path.push_back(u);
+      u = ancestor[u];
+    }
+    while (!path.empty()) {
+      const size_t x = path.back();
+      path.pop_back();
+      const size_t a = ancestor[x];
+      if (semi[label[a]] < semi[label[x]]) label[x] = label[a];
+      ancestor[x] = ancestor[a];
+    }
+    return label[v];
+  };
+  for (size_t w = num_reachable - 1; w > 0; w--) {
+    for (size_t p : preds[vertex[w]]) {
+      const size_t v = preorder_number[p];
+      if (v == undefined) continue;
+      const size_t u = eval(v);
+      if (semi[u] < semi[w]) semi[w] = semi[u];
     }
+    ancestor[w] = parent[w];
+  }
+
+  // The immediate dominator of a block is its nearest common ancestor, in the
+  // dominator tree, with its semidominator.  Blocks are processed in preorder
+  // so that the dominators of their ancestors are already known.
+  std::vector<size_t> idom(num_reachable, 0);
+  for (size_t w = 1; w < num_reachable; w++) {
+    size_t d = parent[w];
+    while (d > semi[w]) d = idom[d];
+    idom[w] = d;
+  }
+
+  std::vector<std::pair<bb_ptr, bb_ptr>> out;
+  out.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) {
+    // Blocks without a dominator are their own dominator.
+    size_t dominator = i;
+    const size_t w = preorder_number[i];
+    if (w != undefined && w != 0) dominator = vertex[idom[w]];
     // NOTE: performing a const cast for convenient usage with
     // UpdateImmediateDominators
-    out.push_back({const_cast<BB*>(std::get<0>(idom)),
+    out.push_back({const_cast<BB*>(postorder[i]),
                    const_cast<BB*>(postorder[dominator])});
   }
-
-  // Sort by postorder index to generate a deterministic ordering of edges.
-  std::sort(
-      out.begin(), out.end(),
-      [&idoms](const std::pair<bb_ptr, bb_ptr>& lhs,
-               const std::pair<bb_ptr, bb_ptr>& rhs) {
-        assert(lhs.first);
-        assert(lhs.second);
-        assert(rhs.first);
-        assert(rhs.second);
-        auto lhs_indices = std::make_pair(idoms[lhs.first].postorder_index,
-                                          idoms[lhs.second].postorder_index);
-        auto rhs_indices = std::make_pair(idoms[rhs.first].postorder_index,
-                                          idoms[rhs.second].postorder_index);
-        return lhs_indices < rhs_indices;
-      });
   return out;
 }
 
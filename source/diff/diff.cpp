@@ -14,6 +14,9 @@
 
 #include "source/diff/diff.h"
 
+#include <atomic>
+#include <thread>
+
 #include "source/diff/lcs.h"
 #include "source/disassemble.h"
 #include "source/ext_inst.h"
@@ -493,6 +496,15 @@ class Differ {
                                                const opt::Instruction* dst_inst,
                                                uint32_t flexibility);
 
+  // Returns the ids used by the instructions of |src_body| that are not
+  // matched yet.  Matching any of them may change the diff of the body.
+  IdGroup GetUnmatchedIdsUsedByBody(const InstructionList& src_body);
+
+  // Calls |work| with every index below |count|, using up to
+  // |options_.num_threads| threads.  |work| must not change the differ.
+  void ForEachIndexInParallel(size_t count,
+                              const std::function<void(size_t)>& work);
+
   // Helper functions to retrieve information pertaining to an id
   const opt::Instruction* GetInst(const IdInstructions& id_to, uint32_t id);
   uint32_t GetConstantUint(const IdInstructions& id_to, uint32_t constant_id);
@@ -1666,7 +1678,7 @@ void Differ::BestEffortMatchFunctions(const IdGroup& src_func_ids,
       return match_rate > other.match_rate;
     }
   };
-  std::vector<MatchResult> all_match_results;
+  std::vector<MatchResult> candidates;
 
   for (const uint32_t src_func_id : src_func_ids) {
     if (id_map_.IsSrcMapped(src_func_id)) {
@@ -1685,19 +1697,27 @@ void Differ::BestEffortMatchFunctions(const IdGroup& src_func_ids,
         continue;
       }
 
-      DiffMatch src_match_result, dst_match_result;
-      float match_rate = MatchFunctionBodies(
-          src_func_insts.at(src_func_id), dst_func_insts.at(dst_func_id),
-          &src_match_result, &dst_match_result);
-
-      // Only consider the functions a match if there's at least 60% match.
-      // This is an arbitrary limit that should be tuned.
-      constexpr float pass_match_rate = 0.6f;
-      if (match_rate >= pass_match_rate) {
-        all_match_results.emplace_back(
-            MatchResult{src_func_id, dst_func_id, std::move(src_match_result),
-                        std::move(dst_match_result), match_rate});
-      }
+      candidates.push_back({src_func_id, dst_func_id, {}, {}, 0.0f});
+    }
+  }
+
+  // The id map doesn't change while the candidates are diffed, so they can be
+  // diffed in any order.
+  ForEachIndexInParallel(candidates.size(), [&](size_t index) {
+    MatchResult& candidate = candidates[index];
+    candidate.match_rate = MatchFunctionBodies(
+        src_func_insts.at(candidate.src_id),
+        dst_func_insts.at(candidate.dst_id), &candidate.src_match,
+        &candidate.dst_match);
+  });
+
+  std::vector<MatchResult> all_match_results;
+  for (MatchResult& candidate : candidates) {
+    // Only consider the functions a match if there's at least 60% match.
+    // This is an arbitrary limit that should be tuned.
+    constexpr float pass_match_rate = 0.6f;
+    if (candidate.match_rate >= pass_match_rate) {
+      all_match_results.push_back(std::move(candidate));
     }
   }
 
@@ -1825,6 +1845,49 @@ void Differ::MatchIdsInFunctionBodies(const InstructionList& src_body,
   }
 }
 
+IdGroup Differ::GetUnmatchedIdsUsedByBody(const InstructionList& src_body) {
+  IdGroup unmatched_ids;
+  auto add_if_unmatched = [this, &unmatched_ids](uint32_t id) {
+    if (!id_map_.IsSrcMapped(id)) {
+      unmatched_ids.push_back(id);
+    }
+  };
+
+  for (const opt::Instruction* src_inst : src_body) {
+    if (src_inst->HasResultType()) {
+      add_if_unmatched(src_inst->type_id());
+    }
+    src_inst->ForEachInId(
+        [&add_if_unmatched](const uint32_t* id) { add_if_unmatched(*id); });
+  }
+
+  return unmatched_ids;
+}
+
+void Differ::ForEachIndexInParallel(size_t count,
+                                    const std::function<void(size_t)>& work) {
+  const size_t num_threads =
+      std::min(static_cast<size_t>(options_.num_threads), count);
+  if (num_threads <= 1) {
+    for (size_t index = 0; index < count; ++index) {
+      work(index);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_index(0);
+  auto worker = [&next_index, count, &work]() {
+    for (size_t index = next_index++; index < count; index = next_index++) {
+      work(index);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+}
+
 void Differ::MatchVariablesUsedByMatchedInstructions(
     const opt::Instruction* src_inst, const opt::Instruction* dst_inst,
     uint32_t flexibility) {
@@ -2546,6 +2609,18 @@ void Differ::MatchFunctions() {
   // and processed, so that more of the global variables can be matched before
   // attempting to match the rest of the functions.  They can contribute to the
   // precision of the diff of those functions.
+  struct FunctionDiff {
+    uint32_t src_id;
+    uint32_t dst_id;
+    DiffMatch src_match;
+    DiffMatch dst_match;
+    // Whether the functions have been diffed, and the ids used by the src
+    // function that were not matched at the time.
+    bool is_diffed;
+    IdGroup unmatched_ids;
+  };
+  std::vector<FunctionDiff> function_diffs;
+
   for (const uint32_t src_func_id : src_func_ids) {
     const uint32_t dst_func_id = id_map_.MappedDstId(src_func_id);
     if (dst_func_id == 0) {
@@ -2553,20 +2628,47 @@ void Differ::MatchFunctions() {
     }
 
     // Since these functions are definite matches, match their parameters for a
-    // better diff.
+    // better diff.  Parameters are only used in their own function, so this
+    // doesn't affect the diff of the other functions.
     MatchFunctionParamIds(src_funcs_[src_func_id], dst_funcs_[dst_func_id]);
-
-    // Take the diff of the two functions.
-    DiffMatch src_match_result, dst_match_result;
-    MatchFunctionBodies(src_func_insts_[src_func_id],
-                        dst_func_insts_[dst_func_id], &src_match_result,
-                        &dst_match_result);
+    function_diffs.push_back({src_func_id, dst_func_id, {}, {}, false, {}});
+  }
+
+  // With multiple threads, take the diff of all the functions with the ids
+  // matched so far.
+  if (options_.num_threads > 1) {
+    auto diff_function = [this, &function_diffs](size_t index) {
+      FunctionDiff& function_diff = function_diffs[index];
+      const InstructionList& src_body =
+          src_func_insts_.at(function_diff.src_id);
+      MatchFunctionBodies(src_body, dst_func_insts_.at(function_diff.dst_id),
+                          &function_diff.src_match, &function_diff.dst_match);
+      function_diff.is_diffed = true;
+      function_diff.unmatched_ids = GetUnmatchedIdsUsedByBody(src_body);
+    };
+    ForEachIndexInParallel(function_diffs.size(), diff_function);
+  }
+
+  for (FunctionDiff& function_diff : function_diffs) {
+    const InstructionList& src_body = src_func_insts_[function_diff.src_id];
+    const InstructionList& dst_body = dst_func_insts_[function_diff.dst_id];
+
+    // Take the diff of the two functions, unless it was taken already and the
+    // previous functions didn't match any of the ids it depends on.
+    const bool is_diff_current =
+        function_diff.is_diffed &&
+        std::none_of(function_diff.unmatched_ids.begin(),
+                     function_diff.unmatched_ids.end(),
+                     [this](uint32_t id) { return id_map_.IsSrcMapped(id); });
+    if (!is_diff_current) {
+      MatchFunctionBodies(src_body, dst_body, &function_diff.src_match,
+                          &function_diff.dst_match);
+    }
 
     // Match ids between the two function bodies; which can also result in
     // global variables getting matched.
-    MatchIdsInFunctionBodies(src_func_insts_[src_func_id],
-                             dst_func_insts_[dst_func_id], src_match_result,
-                             dst_match_result, 0);
+    MatchIdsInFunctionBodies(src_body, dst_body, function_diff.src_match,
+                             function_diff.dst_match, 0);
   }
 
   // Best effort match functions with matching return and argument types.
@@ -15,6 +15,8 @@
 #ifndef SOURCE_DIFF_DIFF_H_
 #define SOURCE_DIFF_DIFF_H_
 
+#include <cstdint>
+
 #include "source/opt/ir_context.h"
 
 namespace spvtools {
@@ -27,6 +29,9 @@ struct Options {
   bool no_header = false;
   bool color_output = false;
   bool dump_id_map = false;
+  // The number of threads used to diff function bodies.  The output does not
+  // depend on it.
+  uint32_t num_threads = 1;
 };
 
 // Given two SPIR-V modules, this function outputs the textual diff of their
@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <stack>
 #include <vector>
 
@@ -31,13 +32,18 @@ using DiffMatch = std::vector<bool>;
 
 // Helper class to find the longest common subsequence between two function
 // bodies.
+//
+// Small sequences are matched with a memoized table of size src x dst.  Larger
+// ones are matched with Myers' O(ND) algorithm in its linear space variant,
+// where D is the number of elements that don't match.  When D is large, the
+// search for the best split of a range is cut short, like GNU diff does, so the
+// result may not be the longest common subsequence for very different large
+// sequences.
 template <typename Sequence>
 class LongestCommonSubsequence {
  public:
   LongestCommonSubsequence(const Sequence& src, const Sequence& dst)
-      : src_(src),
-        dst_(dst),
-        table_(src.size(), std::vector<DiffMatchEntry>(dst.size())) {}
+      : src_(src), dst_(dst) {}
 
   // Given two sequences, it creates a matching between them.  The elements are
   // simply marked as matched in src and dst, with any unmatched element in src
@@ -49,14 +55,61 @@ class LongestCommonSubsequence {
                DiffMatch* src_match_result, DiffMatch* dst_match_result);
 
  private:
+  // Sequences whose table would have more entries than this use the linear
+  // space algorithm.
+  static constexpr size_t kMaxTableSize = 1 << 22;
+  // The least number of edits after which the linear space algorithm gives up
+  // on finding the best split of a range.
+  static constexpr uint32_t kMinCostLimit = 4096;
+
   struct DiffMatchIndex {
     uint32_t src_offset;
     uint32_t dst_offset;
   };
 
+  // The ranges [src_begin, src_end) and [dst_begin, dst_end) of src and dst,
+  // and positions in them, as used by the linear space algorithm.
+  struct DiffRange {
+    int64_t src_begin;
+    int64_t src_end;
+    int64_t dst_begin;
+    int64_t dst_end;
+  };
+  struct DiffPoint {
+    int64_t src_offset;
+    int64_t dst_offset;
+  };
+
   template <typename T>
   void CalculateLCS(std::function<bool(T src_elem, T dst_elem)> match);
   void RetrieveMatch(DiffMatch* src_match_result, DiffMatch* dst_match_result);
+
+  template <typename T>
+  uint32_t CalculateLinearSpaceLCS(
+      std::function<bool(T src_elem, T dst_elem)> match,
+      DiffMatch* src_match_result, DiffMatch* dst_match_result);
+  // Returns a point through which a shortest edit script of |range| goes, or
+  // a point where the search was cut short.
+  template <typename T>
+  DiffPoint FindMiddleSnake(
+      const std::function<bool(T src_elem, T dst_elem)>& match,
+      const DiffRange& range);
+  template <typename T>
+  bool DoElementsMatch(const std::function<bool(T src_elem, T dst_elem)>& match,
+                       int64_t src_offset, int64_t dst_offset) {
+    return match(src_[static_cast<size_t>(src_offset)],
+                 dst_[static_cast<size_t>(dst_offset)]);
+  }
+  // The furthest reaching points of the forward and backward searches, by
+  // diagonal.  Diagonal k holds the points whose src and dst offsets differ by
+  // k, and ranges from -dst.size() - 1 to src.size() + 1.
+  int64_t& Forward(int64_t diagonal) {
+    return forward_[static_cast<size_t>(diagonal + diagonal_offset_)];
+  }
+  int64_t& Backward(int64_t diagonal) {
+    return backward_[static_cast<size_t>(diagonal + diagonal_offset_)];
+  }
+
   bool IsInBound(DiffMatchIndex index) {
     return index.src_offset < src_.size() && index.dst_offset < dst_.size();
   }
@@ -106,6 +159,11 @@ class LongestCommonSubsequence {
   };
 
   std::vector<std::vector<DiffMatchEntry>> table_;
+
+  std::vector<int64_t> forward_;
+  std::vector<int64_t> backward_;
+  int64_t diagonal_offset_ = 0;
+  uint32_t cost_limit_ = 0;
 };
 
 template <typename Sequence>
@@ -113,6 +171,11 @@ template <typename T>
 uint32_t LongestCommonSubsequence<Sequence>::Get(
     std::function<bool(T src_elem, T dst_elem)> match,
     DiffMatch* src_match_result, DiffMatch* dst_match_result) {
+  if (!dst_.empty() && src_.size() > kMaxTableSize / dst_.size()) {
+    return CalculateLinearSpaceLCS(match, src_match_result, dst_match_result);
+  }
+
+  table_.assign(src_.size(), std::vector<DiffMatchEntry>(dst_.size()));
   CalculateLCS(match);
   RetrieveMatch(src_match_result, dst_match_result);
   return GetMemoizedLength({0, 0});
@@ -218,6 +281,199 @@ void LongestCommonSubsequence<Sequence>::RetrieveMatch(
   }
 }
 
+template <typename Sequence>
+template <typename T>
+uint32_t LongestCommonSubsequence<Sequence>::CalculateLinearSpaceLCS(
+    std::function<bool(T src_elem, T dst_elem)> match,
+    DiffMatch* src_match_result, DiffMatch* dst_match_result) {
+  // Myers' algorithm finds a shortest edit script, whose unchanged elements
+  // form the LCS.  In linear space, it finds the middle of such a script by
+  // searching forward from the start and backward from the end at the same
+  // time, and then does the same with the ranges before and after it.  See
+  // "An O(ND) Difference Algorithm and Its Variations", E. Myers, 1986.
+  //
+  // Like with the table, matching elements at the start of a range are always
+  // matched, which is optimal when the match is an equivalence.
+  src_match_result->assign(src_.size(), false);
+  dst_match_result->assign(dst_.size(), false);
+
+  const int64_t src_size = static_cast<int64_t>(src_.size());
+  const int64_t dst_size = static_cast<int64_t>(dst_.size());
+  forward_.resize(src_.size() + dst_.size() + 3);
+  backward_.resize(src_.size() + dst_.size() + 3);
+  diagonal_offset_ = dst_size + 1;
+
+  // Give up on finding the middle of a range after about sqrt(N+M) edits.
+  cost_limit_ = 1;
+  for (size_t diagonals = forward_.size(); diagonals != 0; diagonals >>= 2) {
+    cost_limit_ <<= 1;
+  }
+  cost_limit_ = std::max(cost_limit_, kMinCostLimit);
+
+  uint32_t match_length = 0;
+  auto mark_matched = [&](int64_t src_offset, int64_t dst_offset) {
+    (*src_match_result)[static_cast<size_t>(src_offset)] = true;
+    (*dst_match_result)[static_cast<size_t>(dst_offset)] = true;
+    ++match_length;
+  };
+
+  std::stack<DiffRange> to_compare;
+  to_compare.push({0, src_size, 0, dst_size});
+
+  while (!to_compare.empty()) {
+    DiffRange range = to_compare.top();
+    to_compare.pop();
+
+    // Match the common prefix and suffix of the range.
+    while (range.src_begin < range.src_end &&
+           range.dst_begin < range.dst_end &&
+           DoElementsMatch(match, range.src_begin, range.dst_begin)) {
+      mark_matched(range.src_begin++, range.dst_begin++);
+    }
+    while (range.src_begin < range.src_end &&
+           range.dst_begin < range.dst_end &&
+           DoElementsMatch(match, range.src_end - 1, range.dst_end - 1)) {
+      mark_matched(--range.src_end, --range.dst_end);
+    }
+
+    // If either side is exhausted, the rest of the other is unmatched.
+    if (range.src_begin == range.src_end || range.dst_begin == range.dst_end) {
+      continue;
+    }
+
+    const DiffPoint middle = FindMiddleSnake(match, range);
+    to_compare.push(
+        {middle.src_offset, range.src_end, middle.dst_offset, range.dst_end});
+    to_compare.push({range.src_begin, middle.src_offset, range.dst_begin,
+                     middle.dst_offset});
+  }
+
+  return match_length;
+}
+
+template <typename Sequence>
+template <typename T>
+typename LongestCommonSubsequence<Sequence>::DiffPoint
+LongestCommonSubsequence<Sequence>::FindMiddleSnake(
+    const std::function<bool(T src_elem, T dst_elem)>& match,
+    const DiffRange& range) {
+  // The searches proceed by number of edits.  After each edit, they follow the
+  // matching elements along the diagonal.  The forward search keeps the largest
+  // src offset reached on each diagonal, and the backward search the smallest.
+  // Once they overlap on a diagonal, the point where they do is on a shortest
+  // edit script.
+  const int64_t min_diagonal = range.src_begin - range.dst_end;
+  const int64_t max_diagonal = range.src_end - range.dst_begin;
+  const int64_t forward_mid = range.src_begin - range.dst_begin;
+  const int64_t backward_mid = range.src_end - range.dst_end;
+  const bool odd = ((forward_mid - backward_mid) & 1) != 0;
+  const int64_t kNone = std::numeric_limits<int64_t>::max();
+
+  int64_t forward_min = forward_mid;
+  int64_t forward_max = forward_mid;
+  int64_t backward_min = backward_mid;
+  int64_t backward_max = backward_mid;
+  Forward(forward_mid) = range.src_begin;
+  Backward(backward_mid) = range.src_end;
+
+  for (uint32_t cost = 1;; ++cost) {
+    // Extend the forward search by one edit, with sentinels on the diagonals
+    // just outside of the searched ones.
+    if (forward_min > min_diagonal) {
+      Forward(--forward_min - 1) = -1;
+    } else {
+      ++forward_min;
+    }
+    if (forward_max < max_diagonal) {
+      Forward(++forward_max + 1) = -1;
+    } else {
+      --forward_max;
+    }
+    for (int64_t k = forward_max; k >= forward_min; k -= 2) {
+      const int64_t from_below = Forward(k - 1);
+      const int64_t from_above = Forward(k + 1);
+      int64_t x = from_below < from_above ? from_above : from_below + 1;
+      int64_t y = x - k;
+      while (x < range.src_end && y < range.dst_end &&
+             DoElementsMatch(match, x, y)) {
+        ++x;
+        ++y;
+      }
+      Forward(k) = x;
+      if (odd && backward_min <= k && k <= backward_max && Backward(k) <= x) {
+        return {x, y};
+      }
+    }
+
+    // Extend the backward search by one edit.
+    if (backward_min > min_diagonal) {
+      Backward(--backward_min - 1) = kNone;
+    } else {
+      ++backward_min;
+    }
+    if (backward_max < max_diagonal) {
+      Backward(++backward_max + 1) = kNone;
+    } else {
+      --backward_max;
+    }
+    for (int64_t k = backward_max; k >= backward_min; k -= 2) {
+      const int64_t from_below = Backward(k - 1);
+      const int64_t from_above = Backward(k + 1);
+      int64_t x = from_below < from_above ? from_below : from_above - 1;
+      int64_t y = x - k;
+      while (x > range.src_begin && y > range.dst_begin &&
+             DoElementsMatch(match, x - 1, y - 1)) {
+        --x;
+        --y;
+      }
+      Backward(k) = x;
+      if (!odd && forward_min <= k && k <= forward_max && x <= Forward(k)) {
+        return {x, y};
+      }
+    }
+
+    if (cost < cost_limit_) {
+      continue;
+    }
+
+    // The sequences are too different for the search to be worth finishing.
+    // Split the range at the point furthest from its start that the forward
+    // search reached, or at the point furthest from its end that the backward
+    // search reached, whichever got further.
+    DiffPoint forward_best = {range.src_begin, range.dst_begin};
+    for (int64_t k = forward_max; k >= forward_min; k -= 2) {
+      int64_t x = std::min(Forward(k), range.src_end);
+      int64_t y = x - k;
+      if (y > range.dst_end) {
+        x = range.dst_end + k;
+        y = range.dst_end;
+      }
+      if (x + y > forward_best.src_offset + forward_best.dst_offset) {
+        forward_best = {x, y};
+      }
+    }
+    DiffPoint backward_best = {range.src_end, range.dst_end};
+    for (int64_t k = backward_max; k >= backward_min; k -= 2) {
+      int64_t x = std::max(Backward(k), range.src_begin);
+      int64_t y = x - k;
+      if (y < range.dst_begin) {
+        x = range.dst_begin + k;
+        y = range.dst_begin;
+      }
+      if (x + y < backward_best.src_offset + backward_best.dst_offset) {
+        backward_best = {x, y};
+      }
+    }
+    const int64_t forward_progress = forward_best.src_offset +
+                                     forward_best.dst_offset - range.src_begin -
+                                     range.dst_begin;
+    const int64_t backward_progress = range.src_end + range.dst_end -
+                                      backward_best.src_offset -
+                                      backward_best.dst_offset;
+    return backward_progress < forward_progress ? forward_best : backward_best;
+  }
+}
+
 }  // namespace diff
 }  // namespace spvtools
 
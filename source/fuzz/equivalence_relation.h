@@ -70,6 +70,32 @@ namespace fuzz {
 template <typename T, typename PointerHashT, typename PointerEqualsT>
 class EquivalenceRelation {
  public:
+  EquivalenceRelation() = default;
+
+  // Makes a deep copy of |other|.  The values are registered in the same order
+  // and the trees have the same shape, so the copy behaves exactly like
+  // |other|.
+  EquivalenceRelation(const EquivalenceRelation& other) {
+    std::unordered_map<const T*, const T*> copy_of;
+    for (auto& value : other.owned_values_) {
+      auto copy = MakeUnique<T>(*value);
+      copy_of[value.get()] = copy.get();
+      value_set_.insert(copy.get());
+      owned_values_.push_back(std::move(copy));
+    }
+    for (auto& entry : other.parent_) {
+      parent_[copy_of.at(entry.first)] = copy_of.at(entry.second);
+    }
+    for (auto& entry : other.children_) {
+      auto& children = children_[copy_of.at(entry.first)];
+      for (auto child : entry.second) {
+        children.push_back(copy_of.at(child));
+      }
+    }
+  }
+
+  EquivalenceRelation& operator=(const EquivalenceRelation&) = delete;
+
   // Requires that |value1| and |value2| are already registered in the
   // equivalence relation.  Merges the equivalence classes associated with
   // |value1| and |value2|.
@@ -172,6 +198,13 @@ class EquivalenceRelation {
     return result;
   }
 
+  // Returns the canonical pointer to |value|, which must already be known to
+  // the equivalence relation.
+  const T* GetOwnedValue(const T& value) const {
+    assert(Exists(value));
+    return *value_set_.find(&value);
+  }
+
   // Returns true if and only if |value| is known to be part of the equivalence
   // relation.
   bool Exists(const T& value) const {
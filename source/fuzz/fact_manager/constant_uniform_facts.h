@@ -30,6 +30,10 @@ class ConstantUniformFacts {
  public:
   explicit ConstantUniformFacts(opt::IRContext* ir_context);
 
+  // Copies the facts of |other| about a module of which |ir_context| is a copy.
+  ConstantUniformFacts(const ConstantUniformFacts& other,
+                       opt::IRContext* ir_context);
+
   // See method in FactManager which delegates to this method.
   bool MaybeAddFact(const protobufs::FactConstantUniform& fact);
 
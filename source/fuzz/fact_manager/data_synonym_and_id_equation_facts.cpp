@@ -55,6 +55,26 @@ DataSynonymAndIdEquationFacts::DataSynonymAndIdEquationFacts(
     opt::IRContext* ir_context)
     : ir_context_(ir_context) {}
 
+DataSynonymAndIdEquationFacts::DataSynonymAndIdEquationFacts(
+    const DataSynonymAndIdEquationFacts& other, opt::IRContext* ir_context)
+    : synonymous_(other.synonymous_),
+      closure_computation_required_(other.closure_computation_required_),
+      ir_context_(ir_context) {
+  // The equations refer to the data descriptors owned by |other.synonymous_|;
+  // make them refer to the copies owned by |synonymous_| instead.
+  for (const auto& entry : other.id_equations_) {
+    OperationSet& equations =
+        id_equations_[synonymous_.GetOwnedValue(*entry.first)];
+    for (const Operation& operation : entry.second) {
+      Operation copy = {operation.opcode, {}};
+      for (const auto* operand : operation.operands) {
+        copy.operands.push_back(synonymous_.GetOwnedValue(*operand));
+      }
+      equations.insert(std::move(copy));
+    }
+  }
+}
+
 bool DataSynonymAndIdEquationFacts::MaybeAddFact(
     const protobufs::FactDataSynonym& fact,
     const DeadBlockFacts& dead_block_facts,
@@ -38,6 +38,10 @@ class DataSynonymAndIdEquationFacts {
  public:
   explicit DataSynonymAndIdEquationFacts(opt::IRContext* ir_context);
 
+  // Copies the facts of |other| about a module of which |ir_context| is a copy.
+  DataSynonymAndIdEquationFacts(const DataSynonymAndIdEquationFacts& other,
+                                opt::IRContext* ir_context);
+
   // See method in FactManager which delegates to this method. Returns true if
   // neither |fact.data1()| nor |fact.data2()| contain an
   // irrelevant id. Otherwise, returns false. |dead_block_facts| and
@@ -23,6 +23,10 @@ namespace fact_manager {
 DeadBlockFacts::DeadBlockFacts(opt::IRContext* ir_context)
     : ir_context_(ir_context) {}
 
+DeadBlockFacts::DeadBlockFacts(const DeadBlockFacts& other,
+                              opt::IRContext* ir_context)
+    : dead_block_ids_(other.dead_block_ids_), ir_context_(ir_context) {}
+
 bool DeadBlockFacts::MaybeAddFact(const protobufs::FactBlockIsDead& fact) {
   if (!fuzzerutil::MaybeFindBlock(ir_context_, fact.block_id())) {
     return false;
@@ -30,6 +30,9 @@ class DeadBlockFacts {
  public:
   explicit DeadBlockFacts(opt::IRContext* ir_context);
 
+  // Copies the facts of |other| about a module of which |ir_context| is a copy.
+  DeadBlockFacts(const DeadBlockFacts& other, opt::IRContext* ir_context);
+
   // Marks |fact.block_id()| as being dead. Returns true if |fact.block_id()|
   // represents a result id of some OpLabel instruction in |ir_context_|.
   // Returns false otherwise.
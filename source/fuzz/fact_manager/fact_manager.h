@@ -44,6 +44,10 @@ class FactManager {
  public:
   explicit FactManager(opt::IRContext* ir_context);
 
+  // Copies the facts of |other| about a module of which |ir_context| is a copy,
+  // such as one made by opt::IRContext::Clone.
+  FactManager(const FactManager& other, opt::IRContext* ir_context);
+
   // Adds all the facts from |facts|, checking them for validity with respect to
   // |ir_context_|. Warnings about invalid facts are communicated via
   // |message_consumer|; such facts are otherwise ignored.
@@ -35,6 +35,10 @@ class IrrelevantValueFacts {
  public:
   explicit IrrelevantValueFacts(opt::IRContext* ir_context);
 
+  // Copies the facts of |other| about a module of which |ir_context| is a copy.
+  IrrelevantValueFacts(const IrrelevantValueFacts& other,
+                       opt::IRContext* ir_context);
+
   // See method in FactManager which delegates to this method. Returns true if
   // |fact.pointer_id()| is a result id of pointer type in the |ir_context_| and
   // |fact.pointer_id()| does not participate in DataSynonym facts. Returns
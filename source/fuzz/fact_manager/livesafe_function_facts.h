@@ -30,6 +30,10 @@ class LivesafeFunctionFacts {
  public:
   explicit LivesafeFunctionFacts(opt::IRContext* ir_context);
 
+  // Copies the facts of |other| about a module of which |ir_context| is a copy.
+  LivesafeFunctionFacts(const LivesafeFunctionFacts& other,
+                        opt::IRContext* ir_context);
+
   // See method in FactManager which delegates to this method. Returns true if
   // |fact.function_id()| is a result id of some non-entry-point function in
   // |ir_context_|. Returns false otherwise.
@@ -66,6 +66,11 @@ const spvtools::MessageConsumer kSilentMessageConsumer =
     [](spv_message_level_t, const char*, const spv_position_t&,
        const char*) -> void {};
 
+ModuleSupplier MakeModuleCopySupplier(
+    std::shared_ptr<const opt::IRContext> module) {
+  return [module]() { return module->Clone(); };
+}
+
 bool BuildIRContext(spv_target_env target_env,
                     const spvtools::MessageConsumer& message_consumer,
                     const std::vector<uint32_t>& binary_in,
@@ -39,6 +39,13 @@ extern const spvtools::MessageConsumer kSilentMessageConsumer;
 // Function type that produces a SPIR-V module.
 using ModuleSupplier = std::function<std::unique_ptr<opt::IRContext>()>;
 
+// Returns a supplier that produces in-memory copies of |module|, so that the
+// module is parsed once however many times it is supplied.  Copying only reads
+// |module|, so the supplier, and other suppliers sharing |module|, can be
+// invoked concurrently.
+ModuleSupplier MakeModuleCopySupplier(
+    std::shared_ptr<const opt::IRContext> module);
+
 // Builds a new opt::IRContext object. Returns true if successful and changes
 // the |ir_context| parameter. Otherwise (if any errors occur), returns false
 // and |ir_context| remains unchanged.
@@ -24,6 +24,7 @@
 #include "source/fuzz/transformation.h"
 #include "source/fuzz/transformation_context.h"
 #include "source/opt/build_module.h"
+#include "source/spirv_constant.h"
 #include "source/util/make_unique.h"
 
 namespace spvtools {
@@ -70,31 +71,21 @@ Replayer::ReplayerResult Replayer::Run() {
             nullptr, nullptr, protobufs::TransformationSequence()};
   }
 
-  // Initial binary should be valid.
-  if (!tools.Validate(&binary_in_[0], binary_in_.size(), validator_options_)) {
+  // Initial binary should be valid.  A checkpoint was reached from it, so there
+  // is no need to check it again when resuming from one.
+  if (!resume_from_ &&
+      !tools.Validate(&binary_in_[0], binary_in_.size(), validator_options_)) {
     consumer_(SPV_MSG_INFO, nullptr, {},
               "Initial binary is invalid; stopping.");
     return {Replayer::ReplayerResultStatus::kInitialBinaryInvalid, nullptr,
             nullptr, protobufs::TransformationSequence()};
   }
 
-  // Build the module from the input binary.
-  std::unique_ptr<opt::IRContext> ir_context =
-      BuildModule(target_env_, consumer_, binary_in_.data(), binary_in_.size());
-  assert(ir_context);
-
-  // For replay validation, we track the last valid SPIR-V binary that was
-  // observed. Initially this is the input binary.
-  std::vector<uint32_t> last_valid_binary;
-  if (validate_during_replay_) {
-    last_valid_binary = binary_in_;
-  }
-
   // We find the smallest id that is (a) not in use by the original module, and
   // (b) not used by any transformation in the sequence to be replayed.  This
   // serves as a starting id from which to issue overflow ids if they are
   // required during replay.
-  uint32_t first_overflow_id = ir_context->module()->id_bound();
+  uint32_t first_overflow_id = binary_in_[SPV_INDEX_BOUND];
   for (auto& transformation : transformation_sequence_in_.transformation()) {
     auto fresh_ids = Transformation::FromMessage(transformation)->GetFreshIds();
     if (!fresh_ids.empty()) {
@@ -104,28 +95,66 @@ Replayer::ReplayerResult Replayer::Run() {
     }
   }
 
-  std::unique_ptr<TransformationContext> transformation_context =
-      MakeUnique<TransformationContext>(
-          MakeUnique<FactManager>(ir_context.get()), validator_options_,
-          MakeUnique<CounterOverflowIdSource>(first_overflow_id));
-  transformation_context->GetFactManager()->AddInitialFacts(consumer_,
-                                                            initial_facts_);
+  std::unique_ptr<opt::IRContext> ir_context;
+  std::unique_ptr<TransformationContext> transformation_context;
+  CounterOverflowIdSource* overflow_id_source;
+  protobufs::TransformationSequence transformation_sequence_out;
+
+  // A checkpoint can be resumed from if the overflow ids it issued, if any,
+  // are the ones this replay would have issued.
+  if (resume_from_ &&
+      (resume_from_->overflow_id_source->GetIssuedOverflowIds().empty() ||
+       resume_from_->first_overflow_id == first_overflow_id)) {
+    assert(resume_from_->num_applied_transformations <=
+               num_transformations_to_apply_ &&
+           "The checkpoint is beyond the transformations to be replayed.");
+    ir_context = resume_from_->ir_context->Clone();
+    auto overflow_ids =
+        resume_from_->first_overflow_id == first_overflow_id
+            ? MakeUnique<CounterOverflowIdSource>(
+                  *resume_from_->overflow_id_source)
+            : MakeUnique<CounterOverflowIdSource>(first_overflow_id);
+    overflow_id_source = overflow_ids.get();
+    transformation_context = MakeUnique<TransformationContext>(
+        MakeUnique<FactManager>(*resume_from_->fact_manager, ir_context.get()),
+        validator_options_, std::move(overflow_ids));
+    for (uint32_t i = 0; i < resume_from_->num_applied_transformations; i++) {
+      *transformation_sequence_out.add_transformation() =
+          transformation_sequence_in_.transformation(static_cast<int>(i));
+    }
+  } else {
+    // Build the module from the input binary.
+    ir_context = BuildModule(target_env_, consumer_, binary_in_.data(),
+                             binary_in_.size());
+    assert(ir_context);
+    auto overflow_ids = MakeUnique<CounterOverflowIdSource>(first_overflow_id);
+    overflow_id_source = overflow_ids.get();
+    transformation_context = MakeUnique<TransformationContext>(
+        MakeUnique<FactManager>(ir_context.get()), validator_options_,
+        std::move(overflow_ids));
+    transformation_context->GetFactManager()->AddInitialFacts(consumer_,
+                                                              initial_facts_);
+  }
+
+  // For replay validation, we track the last valid SPIR-V binary that was
+  // observed. Initially this is the input binary.
+  std::vector<uint32_t> last_valid_binary;
+  if (validate_during_replay_) {
+    last_valid_binary = binary_in_;
+  }
 
   // We track the largest id bound observed, to ensure that it only increases
   // as transformations are applied.
   uint32_t max_observed_id_bound = ir_context->module()->id_bound();
   (void)(max_observed_id_bound);  // Keep release-mode compilers happy.
 
-  protobufs::TransformationSequence transformation_sequence_out;
-
-  // Consider the transformation proto messages in turn.
-  uint32_t counter = 0;
-  for (auto& message : transformation_sequence_in_.transformation()) {
-    if (counter >= num_transformations_to_apply_) {
-      break;
-    }
-    counter++;
-
+  // Consider the transformation proto messages in turn, skipping those that
+  // led to the checkpoint we resumed from, if any.
+  for (uint32_t counter = static_cast<uint32_t>(
+           transformation_sequence_out.transformation_size());
+       counter < num_transformations_to_apply_; counter++) {
+    const auto& message =
+        transformation_sequence_in_.transformation(static_cast<int>(counter));
     auto transformation = Transformation::FromMessage(message);
 
     // Check whether the transformation can be applied.
@@ -158,6 +187,21 @@ Replayer::ReplayerResult Replayer::Run() {
         // The binary was valid, so it becomes the latest valid binary.
         last_valid_binary = std::move(binary_to_validate);
       }
+
+      const auto num_applied = static_cast<uint32_t>(
+          transformation_sequence_out.transformation_size());
+      if (checkpoints_ && num_applied % checkpoint_interval_ == 0) {
+        Checkpoint checkpoint;
+        checkpoint.num_applied_transformations = num_applied;
+        checkpoint.ir_context = ir_context->Clone();
+        checkpoint.fact_manager =
+            MakeUnique<FactManager>(*transformation_context->GetFactManager(),
+                                    checkpoint.ir_context.get());
+        checkpoint.first_overflow_id = first_overflow_id;
+        checkpoint.overflow_id_source =
+            MakeUnique<CounterOverflowIdSource>(*overflow_id_source);
+        checkpoints_->push_back(std::move(checkpoint));
+      }
     }
   }
 
@@ -166,5 +210,16 @@ Replayer::ReplayerResult Replayer::Run() {
           std::move(transformation_sequence_out)};
 }
 
+void Replayer::ResumeFrom(const Checkpoint* checkpoint) {
+  resume_from_ = checkpoint;
+}
+
+void Replayer::RecordCheckpoints(uint32_t interval,
+                                 std::vector<Checkpoint>* checkpoints) {
+  assert(interval > 0 && "Checkpoints need a positive interval.");
+  checkpoint_interval_ = interval;
+  checkpoints_ = checkpoints;
+}
+
 }  // namespace fuzz
 }  // namespace spvtools
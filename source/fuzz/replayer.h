@@ -18,6 +18,8 @@
 #include <memory>
 #include <vector>
 
+#include "source/fuzz/counter_overflow_id_source.h"
+#include "source/fuzz/fact_manager/fact_manager.h"
 #include "source/fuzz/protobufs/spirvfuzz_protobufs.h"
 #include "source/fuzz/transformation_context.h"
 #include "source/opt/ir_context.h"
@@ -46,6 +48,20 @@ class Replayer {
     protobufs::TransformationSequence applied_transformations;
   };
 
+  // The state of a replay once it has applied its first
+  // |num_applied_transformations| transformations.  A replay of any sequence
+  // whose first transformations are exactly those can resume from this state
+  // instead of starting again from the input binary.
+  struct Checkpoint {
+    uint32_t num_applied_transformations;
+    std::unique_ptr<opt::IRContext> ir_context;
+    std::unique_ptr<FactManager> fact_manager;
+    // The first id that the replay's source of overflow ids was created with,
+    // and a copy of that source.
+    uint32_t first_overflow_id;
+    std::unique_ptr<CounterOverflowIdSource> overflow_id_source;
+  };
+
   Replayer(spv_target_env target_env, MessageConsumer consumer,
            const std::vector<uint32_t>& binary_in,
            const protobufs::FactSequence& initial_facts,
@@ -73,6 +89,19 @@ class Replayer {
   // sequence, and null pointers for the IR context and transformation context.
   ReplayerResult Run();
 
+  // Makes Run() start from |checkpoint| rather than from |binary_in_|.  The
+  // first |checkpoint->num_applied_transformations| transformations of
+  // |transformation_sequence_in_| must be the ones that were applied to reach
+  // |checkpoint|, which must outlive the replay.  If the checkpoint used
+  // overflow ids that this replay would not have used, the replay starts from
+  // |binary_in_| after all.
+  void ResumeFrom(const Checkpoint* checkpoint);
+
+  // Makes Run() add a checkpoint to |checkpoints| each time the number of
+  // transformations it applied becomes a multiple of |interval|.
+  void RecordCheckpoints(uint32_t interval,
+                         std::vector<Checkpoint>* checkpoints);
+
  private:
   // Target environment.
   const spv_target_env target_env_;
@@ -97,6 +126,13 @@ class Replayer {
 
   // Options to control validation
   spv_validator_options validator_options_;
+
+  // The checkpoint to resume from, if any.
+  const Checkpoint* resume_from_ = nullptr;
+
+  // Where to record checkpoints, if anywhere, and how often.
+  std::vector<Checkpoint>* checkpoints_ = nullptr;
+  uint32_t checkpoint_interval_ = 0;
 };
 
 }  // namespace fuzz
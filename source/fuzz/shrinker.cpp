@@ -29,6 +29,11 @@ namespace fuzz {
 
 namespace {
 
+// The number of replay checkpoints to keep along the current best sequence of
+// transformations.  More checkpoints mean shorter replays, but each of them
+// holds a copy of the module.
+const uint32_t kMaxCheckpoints = 32;
+
 // A helper to get the size of a protobuf transformation sequence in a less
 // verbose manner.
 uint32_t NumRemainingTransformations(
@@ -103,15 +108,26 @@ Shrinker::ShrinkerResult Shrinker::Run() {
             std::vector<uint32_t>(), protobufs::TransformationSequence()};
   }
 
+  // Replaying a sequence with a chunk removed gives the same states as
+  // replaying the current best sequence, up to the start of the chunk.  So
+  // rather than replaying every candidate from the initial binary, we keep
+  // checkpoints at regular intervals along the current best sequence, and
+  // resume from the last one before the chunk.  They are ordered by the number
+  // of transformations that were applied to reach them.
+  std::vector<Replayer::Checkpoint> checkpoints;
+  const uint32_t checkpoint_interval =
+      std::max(1u, NumRemainingTransformations(transformation_sequence_in_) /
+                       kMaxCheckpoints);
+
   // Run a replay of the initial transformation sequence to check that it
   // succeeds.
-  auto initial_replay_result =
-      Replayer(target_env_, consumer_, binary_in_, initial_facts_,
-               transformation_sequence_in_,
-               static_cast<uint32_t>(
-                   transformation_sequence_in_.transformation_size()),
-               validate_during_replay_, validator_options_)
-          .Run();
+  Replayer initial_replayer(
+      target_env_, consumer_, binary_in_, initial_facts_,
+      transformation_sequence_in_,
+      static_cast<uint32_t>(transformation_sequence_in_.transformation_size()),
+      validate_during_replay_, validator_options_);
+  initial_replayer.RecordCheckpoints(checkpoint_interval, &checkpoints);
+  auto initial_replay_result = initial_replayer.Run();
   if (initial_replay_result.status !=
       Replayer::ReplayerResultStatus::kComplete) {
     return {ShrinkerResultStatus::kReplayFailed, std::vector<uint32_t>(),
@@ -190,14 +206,26 @@ Shrinker::ShrinkerResult Shrinker::Run() {
       // replay might be even smaller than the transformations with the chunk
       // removed, because removing those transformations might make further
       // transformations inapplicable.
-      auto replay_result =
-          Replayer(
-              target_env_, consumer_, binary_in_, initial_facts_,
-              transformations_with_chunk_removed,
-              static_cast<uint32_t>(
-                  transformations_with_chunk_removed.transformation_size()),
-              validate_during_replay_, validator_options_)
-              .Run();
+      const uint32_t chunk_start =
+          static_cast<uint32_t>(chunk_index) * chunk_size;
+      size_t num_usable_checkpoints = checkpoints.size();
+      while (num_usable_checkpoints > 0 &&
+             checkpoints[num_usable_checkpoints - 1]
+                     .num_applied_transformations > chunk_start) {
+        num_usable_checkpoints--;
+      }
+      std::vector<Replayer::Checkpoint> new_checkpoints;
+      Replayer replayer(
+          target_env_, consumer_, binary_in_, initial_facts_,
+          transformations_with_chunk_removed,
+          static_cast<uint32_t>(
+              transformations_with_chunk_removed.transformation_size()),
+          validate_during_replay_, validator_options_);
+      if (num_usable_checkpoints > 0) {
+        replayer.ResumeFrom(&checkpoints[num_usable_checkpoints - 1]);
+      }
+      replayer.RecordCheckpoints(checkpoint_interval, &new_checkpoints);
+      auto replay_result = replayer.Run();
       if (replay_result.status != Replayer::ReplayerResultStatus::kComplete) {
         // Replay should not fail; if it does, we need to abort shrinking.
         return {ShrinkerResultStatus::kReplayFailed, std::vector<uint32_t>(),
@@ -221,6 +249,19 @@ Shrinker::ShrinkerResult Shrinker::Run() {
         current_best_transformations =
             std::move(replay_result.applied_transformations);
         progress_this_round = true;
+
+        // The checkpoints before the chunk are on the way to the new best
+        // sequence too; the later ones are replaced by those of the replay,
+        // which may have started again from the initial binary.
+        checkpoints.resize(num_usable_checkpoints);
+        while (!checkpoints.empty() && !new_checkpoints.empty() &&
+               checkpoints.back().num_applied_transformations >=
+                   new_checkpoints.front().num_applied_transformations) {
+          checkpoints.pop_back();
+        }
+        for (auto& checkpoint : new_checkpoints) {
+          checkpoints.push_back(std::move(checkpoint));
+        }
       }
       // Either way, this was a shrink attempt, so increment our count of shrink
       // attempts.
@@ -29,6 +29,7 @@
 
 #include "fnvar.h"
 #include "source/diagnostic.h"
+#include "source/opcode.h"
 #include "source/opt/build_module.h"
 #include "source/opt/compact_ids_pass.h"
 #include "source/opt/decoration_manager.h"
@@ -37,8 +38,11 @@
 #include "source/opt/remove_duplicates_pass.h"
 #include "source/opt/remove_unused_interface_variables_pass.h"
 #include "source/opt/type_manager.h"
+#include "source/operand.h"
 #include "source/spirv_constant.h"
+#include "source/spirv_endian.h"
 #include "source/table2.h"
+#include "source/util/hash_combine.h"
 #include "source/util/make_unique.h"
 #include "source/util/string_utils.h"
 #include "spirv-tools/libspirv.hpp"
@@ -77,6 +81,14 @@ struct LinkageEntry {
 };
 using LinkageTable = std::vector<LinkageEntry>;
 
+// Computes the ID bound of the linked module from the |id_bounds| of the input
+// modules, and returns it in |max_id_bound|.
+//
+// |max_id_bound| should not be null.
+spv_result_t GetLinkedIdBound(const MessageConsumer& consumer,
+                              const std::vector<uint32_t>& id_bounds,
+                              uint32_t* max_id_bound);
+
 // Shifts the IDs used in each binary of |modules| so that they occupy a
 // disjoint range from the other binaries, and compute the new ID bound which
 // is returned in |max_id_bound|.
@@ -88,15 +100,32 @@ spv_result_t ShiftIdsInModules(const MessageConsumer& consumer,
                                std::vector<opt::Module*>* modules,
                                uint32_t* max_id_bound);
 
-// Generates the header for the linked module and returns it in |header|.
+// Generates the header for the linked module from the SPIR-V |versions| of
+// the input modules, and returns it in |header|.
 //
-// |header| should not be null, |modules| should not be empty and pointers
-// should be non-null. |max_id_bound| should be strictly greater than 0.
+// |header| should not be null and |versions| should not be empty.
+// |max_id_bound| should be strictly greater than 0.
 spv_result_t GenerateHeader(const MessageConsumer& consumer,
-                            const std::vector<opt::Module*>& modules,
+                            const std::vector<uint32_t>& versions,
                             uint32_t max_id_bound, opt::ModuleHeader* header,
                             const LinkerOptions& options);
 
+// Checks that |module|, the input module at |index|, has a memory model, and
+// that its addressing and memory models are the ones of
+// |linked_memory_model_inst|, the memory model of the first input module.
+spv_result_t CheckMemoryModel(const MessageConsumer& consumer,
+                              const Instruction* linked_memory_model_inst,
+                              const Module& module, size_t index);
+
+// Appends the entry point |inst| to |linked_module|, unless |entry_points|
+// already contains its execution model and name.  In that case an error is
+// returned, otherwise the execution model and name are added to
+// |entry_points|.
+spv_result_t AddEntryPoint(
+    const MessageConsumer& consumer, std::unique_ptr<Instruction> inst,
+    std::vector<std::pair<uint32_t, std::string>>* entry_points,
+    Module* linked_module);
+
 // Merge all the modules from |in_modules| into a single module owned by
 // |linked_context|.
 //
@@ -105,6 +134,28 @@ spv_result_t MergeModules(const MessageConsumer& consumer,
                           const std::vector<Module*>& in_modules,
                           IRContext* linked_context);
 
+// Builds the modules from the |num_binaries| |binaries| of |binary_sizes|
+// words, all at once, and merges them into the module of |linked_context|.
+// This performs phases 1 to 3 of Link().  The built modules are returned in
+// |ir_contexts|, since |variant_defs| refers to them when |make_multitarget|
+// is true.
+spv_result_t LoadAndMergeModules(
+    const MessageConsumer& consumer, spv_target_env env,
+    const uint32_t* const* binaries, const size_t* binary_sizes,
+    size_t num_binaries, const LinkerOptions& options, bool make_multitarget,
+    std::vector<std::unique_ptr<IRContext>>* ir_contexts,
+    VariantDefs* variant_defs, IRContext* linked_context);
+
+// Like LoadAndMergeModules(), but builds the modules one at a time, directly
+// in |linked_context|, and moves their instructions into the linked module
+// instead of cloning them.  The types of each module that are identical to a
+// type of a previous module are merged as the module is read.
+spv_result_t StreamModules(const MessageConsumer& consumer, spv_target_env env,
+                           const uint32_t* const* binaries,
+                           const size_t* binary_sizes, size_t num_binaries,
+                           const LinkerOptions& options,
+                           IRContext* linked_context);
+
 // Compute all pairs of import and export and return it in |linkings_to_do|.
 //
 // |linkings_to_do should not be null. Built-in symbols will be ignored.
@@ -160,6 +211,27 @@ spv_result_t VerifyIds(const MessageConsumer& consumer,
 spv_result_t VerifyLimits(const MessageConsumer& consumer,
                           const opt::IRContext& linked_context);
 
+spv_result_t GetLinkedIdBound(const MessageConsumer& consumer,
+                              const std::vector<uint32_t>& id_bounds,
+                              uint32_t* max_id_bound) {
+  spv_position_t position = {};
+
+  const size_t id_bound =
+      std::accumulate(id_bounds.begin(), id_bounds.end(),
+                      static_cast<size_t>(1),
+                      [](const size_t& accumulation, uint32_t module_bound) {
+                        return accumulation + module_bound - 1u;
+                      });
+  if (id_bound > std::numeric_limits<uint32_t>::max())
+    return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_DATA)
+           << "Too many IDs (" << id_bound
+           << "): combining all modules would overflow the 32-bit word of the "
+              "SPIR-V header.";
+
+  *max_id_bound = static_cast<uint32_t>(id_bound);
+  return SPV_SUCCESS;
+}
+
 spv_result_t ShiftIdsInModules(const MessageConsumer& consumer,
                                std::vector<opt::Module*>* modules,
                                uint32_t* max_id_bound) {
@@ -175,26 +247,21 @@ spv_result_t ShiftIdsInModules(const MessageConsumer& consumer,
     return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_DATA)
            << "|max_id_bound| of ShiftIdsInModules should not be null.";
 
-  const size_t id_bound =
-      std::accumulate(modules->begin(), modules->end(), static_cast<size_t>(1),
-                      [](const size_t& accumulation, opt::Module* module) {
-                        return accumulation + module->IdBound() - 1u;
-                      });
-  if (id_bound > std::numeric_limits<uint32_t>::max())
-    return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_DATA)
-           << "Too many IDs (" << id_bound
-           << "): combining all modules would overflow the 32-bit word of the "
-              "SPIR-V header.";
-
-  *max_id_bound = static_cast<uint32_t>(id_bound);
+  std::vector<uint32_t> id_bounds;
+  id_bounds.reserve(modules->size());
+  for (const Module* module : *modules) id_bounds.push_back(module->IdBound());
+  spv_result_t res = GetLinkedIdBound(consumer, id_bounds, max_id_bound);
+  if (res != SPV_SUCCESS) return res;
 
   uint32_t id_offset = modules->front()->IdBound() - 1u;
   for (auto module_iter = modules->begin() + 1; module_iter != modules->end();
        ++module_iter) {
     Module* module = *module_iter;
-    module->ForEachInst([&id_offset](Instruction* insn) {
-      insn->ForEachId([&id_offset](uint32_t* id) { *id += id_offset; });
-    });
+    module->ForEachInst(
+        [&id_offset](Instruction* insn) {
+          insn->ForEachId([&id_offset](uint32_t* id) { *id += id_offset; });
+        },
+        /* run_on_debug_line_insts = */ true);
     id_offset += module->IdBound() - 1u;
 
     // Invalidate the DefUseManager
@@ -205,21 +272,21 @@ spv_result_t ShiftIdsInModules(const MessageConsumer& consumer,
 }
 
 spv_result_t GenerateHeader(const MessageConsumer& consumer,
-                            const std::vector<opt::Module*>& modules,
+                            const std::vector<uint32_t>& versions,
                             uint32_t max_id_bound, opt::ModuleHeader* header,
                             const LinkerOptions& options) {
   spv_position_t position = {};
 
-  if (modules.empty())
+  if (versions.empty())
     return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_DATA)
-           << "|modules| of GenerateHeader should not be empty.";
+           << "|versions| of GenerateHeader should not be empty.";
   if (max_id_bound == 0u)
     return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_DATA)
            << "|max_id_bound| of GenerateHeader should not be null.";
 
-  uint32_t linked_version = modules.front()->version();
-  for (std::size_t i = 1; i < modules.size(); ++i) {
-    const uint32_t module_version = modules[i]->version();
+  uint32_t linked_version = versions.front();
+  for (std::size_t i = 1; i < versions.size(); ++i) {
+    const uint32_t module_version = versions[i];
     if (options.GetUseHighestVersion()) {
       linked_version = std::max(linked_version, module_version);
     } else if (module_version != linked_version) {
@@ -243,6 +310,99 @@ spv_result_t GenerateHeader(const MessageConsumer& consumer,
   return SPV_SUCCESS;
 }
 
+spv_result_t CheckMemoryModel(const MessageConsumer& consumer,
+                              const Instruction* linked_memory_model_inst,
+                              const Module& module, size_t index) {
+  spv_position_t position = {};
+
+  const Instruction* memory_model_inst = module.GetMemoryModel();
+  if (memory_model_inst == nullptr)
+    return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
+           << "Input module " << (index + 1)
+           << " is lacking an OpMemoryModel instruction.";
+  if (index == 0) return SPV_SUCCESS;
+
+  const uint32_t linked_addressing_model =
+      linked_memory_model_inst->GetSingleWordOperand(0u);
+  const uint32_t module_addressing_model =
+      memory_model_inst->GetSingleWordOperand(0u);
+  if (module_addressing_model != linked_addressing_model) {
+    const spvtools::OperandDesc* linked_desc = nullptr;
+    const spvtools::OperandDesc* module_desc = nullptr;
+    spvtools::LookupOperand(SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                            linked_addressing_model, &linked_desc);
+    spvtools::LookupOperand(SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                            module_addressing_model, &module_desc);
+    return DiagnosticStream(position, consumer, "", SPV_ERROR_INTERNAL)
+           << "Conflicting addressing models: " << linked_desc->name().data()
+           << " (input modules 1 through " << index << ") vs "
+           << module_desc->name().data() << " (input module " << (index + 1)
+           << ").";
+  }
+
+  const uint32_t linked_memory_model =
+      linked_memory_model_inst->GetSingleWordOperand(1u);
+  const uint32_t module_memory_model =
+      memory_model_inst->GetSingleWordOperand(1u);
+  if (module_memory_model != linked_memory_model) {
+    const spvtools::OperandDesc* linked_desc = nullptr;
+    const spvtools::OperandDesc* module_desc = nullptr;
+    spvtools::LookupOperand(SPV_OPERAND_TYPE_MEMORY_MODEL, linked_memory_model,
+                            &linked_desc);
+    spvtools::LookupOperand(SPV_OPERAND_TYPE_MEMORY_MODEL, module_memory_model,
+                            &module_desc);
+    return DiagnosticStream(position, consumer, "", SPV_ERROR_INTERNAL)
+           << "Conflicting memory models: " << linked_desc->name().data()
+           << " (input modules 1 through " << index << ") vs "
+           << module_desc->name().data() << " (input module " << (index + 1)
+           << ").";
+  }
+
+  return SPV_SUCCESS;
+}
+
+spv_result_t AddEntryPoint(
+    const MessageConsumer& consumer, std::unique_ptr<Instruction> inst,
+    std::vector<std::pair<uint32_t, std::string>>* entry_points,
+    Module* linked_module) {
+  spv_position_t position = {};
+
+  const uint32_t model = inst->GetSingleWordInOperand(0);
+  const std::string name =
+      inst->opcode() == spv::Op::OpConditionalEntryPointINTEL
+          ? inst->GetOperand(3).AsString()
+          : inst->GetOperand(2).AsString();
+  const auto i =
+      std::find_if(entry_points->begin(), entry_points->end(),
+                   [model, name](const std::pair<uint32_t, std::string>& v) {
+                     return v.first == model && v.second == name;
+                   });
+  if (i != entry_points->end()) {
+    const spvtools::OperandDesc* desc = nullptr;
+    spvtools::LookupOperand(SPV_OPERAND_TYPE_EXECUTION_MODEL, model, &desc);
+    return DiagnosticStream(position, consumer, "", SPV_ERROR_INTERNAL)
+           << "The entry point \"" << name << "\", with execution model "
+           << desc->name().data() << ", was already defined.";
+  }
+  linked_module->AddEntryPoint(std::move(inst));
+  entry_points->emplace_back(model, name);
+  return SPV_SUCCESS;
+}
+
+// If the module of |linked_context| uses SPIR-V 1.1 or higher, adds an
+// OpModuleProcessed instruction about the linking step to it.
+void AddModuleProcessedInst(IRContext* linked_context) {
+  Module* linked_module = linked_context->module();
+  if (linked_module->version() >= SPV_SPIRV_VERSION_WORD(1, 1)) {
+    const std::string processed_string("Linked by SPIR-V Tools Linker");
+    std::vector<uint32_t> processed_words =
+        spvtools::utils::MakeVector(processed_string);
+    linked_module->AddDebug3Inst(std::unique_ptr<Instruction>(
+        new Instruction(linked_context, spv::Op::OpModuleProcessed, 0u, 0u,
+                        {{SPV_OPERAND_TYPE_LITERAL_STRING, processed_words}})));
+  }
+}
+
 spv_result_t MergeModules(const MessageConsumer& consumer,
                           const std::vector<Module*>& input_modules,
                           IRContext* linked_context) {
@@ -272,54 +432,10 @@ spv_result_t MergeModules(const MessageConsumer& consumer,
 
   const Instruction* linked_memory_model_inst =
       input_modules.front()->GetMemoryModel();
-  if (linked_memory_model_inst == nullptr) {
-    return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
-           << "Input module 1 is lacking an OpMemoryModel instruction.";
-  }
-  const uint32_t linked_addressing_model =
-      linked_memory_model_inst->GetSingleWordOperand(0u);
-  const uint32_t linked_memory_model =
-      linked_memory_model_inst->GetSingleWordOperand(1u);
-
-  for (std::size_t i = 1; i < input_modules.size(); ++i) {
-    const Module* module = input_modules[i];
-    const Instruction* memory_model_inst = module->GetMemoryModel();
-    if (memory_model_inst == nullptr)
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
-             << "Input module " << (i + 1)
-             << " is lacking an OpMemoryModel instruction.";
-
-    const uint32_t module_addressing_model =
-        memory_model_inst->GetSingleWordOperand(0u);
-    if (module_addressing_model != linked_addressing_model) {
-      const spvtools::OperandDesc* linked_desc = nullptr;
-      const spvtools::OperandDesc* module_desc = nullptr;
-      spvtools::LookupOperand(SPV_OPERAND_TYPE_ADDRESSING_MODEL,
-                              linked_addressing_model, &linked_desc);
-      spvtools::LookupOperand(SPV_OPERAND_TYPE_ADDRESSING_MODEL,
-                              module_addressing_model, &module_desc);
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_INTERNAL)
-             << "Conflicting addressing models: " << linked_desc->name().data()
-             << " (input modules 1 through " << i << ") vs "
-             << module_desc->name().data() << " (input module " << (i + 1)
-             << ").";
-    }
-
-    const uint32_t module_memory_model =
-        memory_model_inst->GetSingleWordOperand(1u);
-    if (module_memory_model != linked_memory_model) {
-      const spvtools::OperandDesc* linked_desc = nullptr;
-      const spvtools::OperandDesc* module_desc = nullptr;
-      spvtools::LookupOperand(SPV_OPERAND_TYPE_MEMORY_MODEL,
-                              linked_memory_model, &linked_desc);
-      spvtools::LookupOperand(SPV_OPERAND_TYPE_MEMORY_MODEL,
-                              module_memory_model, &module_desc);
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_INTERNAL)
-             << "Conflicting memory models: " << linked_desc->name().data()
-             << " (input modules 1 through " << i << ") vs "
-             << module_desc->name().data() << " (input module " << (i + 1)
-             << ").";
-    }
+  for (std::size_t i = 0; i < input_modules.size(); ++i) {
+    spv_result_t res = CheckMemoryModel(consumer, linked_memory_model_inst,
+                                        *input_modules[i], i);
+    if (res != SPV_SUCCESS) return res;
   }
   linked_module->SetMemoryModel(std::unique_ptr<Instruction>(
       linked_memory_model_inst->Clone(linked_context)));
@@ -327,26 +443,10 @@ spv_result_t MergeModules(const MessageConsumer& consumer,
   std::vector<std::pair<uint32_t, std::string>> entry_points;
   for (const auto& module : input_modules)
     for (const auto& inst : module->entry_points()) {
-      const uint32_t model = inst.GetSingleWordInOperand(0);
-      const std::string name =
-          inst.opcode() == spv::Op::OpConditionalEntryPointINTEL
-              ? inst.GetOperand(3).AsString()
-              : inst.GetOperand(2).AsString();
-      const auto i = std::find_if(
-          entry_points.begin(), entry_points.end(),
-          [model, name](const std::pair<uint32_t, std::string>& v) {
-            return v.first == model && v.second == name;
-          });
-      if (i != entry_points.end()) {
-        const spvtools::OperandDesc* desc = nullptr;
-        spvtools::LookupOperand(SPV_OPERAND_TYPE_EXECUTION_MODEL, model, &desc);
-        return DiagnosticStream(position, consumer, "", SPV_ERROR_INTERNAL)
-               << "The entry point \"" << name << "\", with execution model "
-               << desc->name().data() << ", was already defined.";
-      }
-      linked_module->AddEntryPoint(
-          std::unique_ptr<Instruction>(inst.Clone(linked_context)));
-      entry_points.emplace_back(model, name);
+      spv_result_t res = AddEntryPoint(
+          consumer, std::unique_ptr<Instruction>(inst.Clone(linked_context)),
+          &entry_points, linked_module);
+      if (res != SPV_SUCCESS) return res;
     }
 
   for (const auto& module : input_modules)
@@ -374,16 +474,7 @@ spv_result_t MergeModules(const MessageConsumer& consumer,
       linked_module->AddExtInstDebugInfo(
           std::unique_ptr<Instruction>(inst.Clone(linked_context)));
 
-  // If the generated module uses SPIR-V 1.1 or higher, add an
-  // OpModuleProcessed instruction about the linking step.
-  if (linked_module->version() >= SPV_SPIRV_VERSION_WORD(1, 1)) {
-    const std::string processed_string("Linked by SPIR-V Tools Linker");
-    std::vector<uint32_t> processed_words =
-        spvtools::utils::MakeVector(processed_string);
-    linked_module->AddDebug3Inst(std::unique_ptr<Instruction>(
-        new Instruction(linked_context, spv::Op::OpModuleProcessed, 0u, 0u,
-                        {{SPV_OPERAND_TYPE_LITERAL_STRING, processed_words}})));
-  }
+  AddModuleProcessedInst(linked_context);
 
   for (const auto& module : input_modules)
     for (const auto& inst : module->annotations())
@@ -411,6 +502,285 @@ spv_result_t MergeModules(const MessageConsumer& consumer,
   return SPV_SUCCESS;
 }
 
+spv_result_t LoadAndMergeModules(
+    const MessageConsumer& consumer, spv_target_env env,
+    const uint32_t* const* binaries, const size_t* binary_sizes,
+    size_t num_binaries, const LinkerOptions& options, bool make_multitarget,
+    std::vector<std::unique_ptr<IRContext>>* ir_contexts,
+    VariantDefs* variant_defs, IRContext* linked_context) {
+  spv_position_t position = {};
+
+  std::vector<Module*> modules;
+  modules.reserve(num_binaries);
+  for (size_t i = 0u; i < num_binaries; ++i) {
+    const uint32_t schema = binaries[i][4u];
+    if (schema != 0u) {
+      position.index = 4u;
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
+             << "Schema is non-zero for module " << i + 1 << ".";
+    }
+
+    std::unique_ptr<IRContext> ir_context =
+        BuildModule(env, consumer, binaries[i], binary_sizes[i]);
+    if (ir_context == nullptr)
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
+             << "Failed to build module " << i + 1 << " out of " << num_binaries
+             << ".";
+    modules.push_back(ir_context->module());
+    ir_contexts->push_back(std::move(ir_context));
+  }
+
+  if (make_multitarget) {
+    if (!variant_defs->ProcessFnVar(options, modules)) {
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_FNVAR)
+             << variant_defs->GetErr();
+    }
+    if (!variant_defs->ProcessVariantDefs()) {
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_FNVAR)
+             << variant_defs->GetErr();
+    }
+  }
+
+  // Phase 1: Shift the IDs used in each binary so that they occupy a disjoint
+  //          range from the other binaries, and compute the new ID bound.
+  uint32_t max_id_bound = 0u;
+  spv_result_t res = ShiftIdsInModules(consumer, &modules, &max_id_bound);
+  if (res != SPV_SUCCESS) return res;
+
+  // Phase 2: Generate the header
+  std::vector<uint32_t> versions;
+  versions.reserve(modules.size());
+  for (const Module* module : modules) versions.push_back(module->version());
+  opt::ModuleHeader header;
+  res = GenerateHeader(consumer, versions, max_id_bound, &header, options);
+  if (res != SPV_SUCCESS) return res;
+  linked_context->module()->SetHeader(header);
+
+  if (make_multitarget) {
+    variant_defs->GenerateHeader(linked_context);
+  }
+
+  // Phase 3: Merge all the binaries into a single one.
+  return MergeModules(consumer, modules, linked_context);
+}
+
+// Hashes the words describing a type in MergeTypes().
+struct TypeWordsHash {
+  size_t operator()(const std::vector<uint32_t>& words) const {
+    return utils::hash_combine(0, words);
+  }
+};
+
+// Maps the opcode and operand words of the types merged by MergeTypes() to
+// their result id.
+using TypeTable =
+    std::unordered_map<std::vector<uint32_t>, uint32_t, TypeWordsHash>;
+
+// Replaces each type of |module| that has the same opcode and operands as a
+// type of |types|, once the types it uses have been replaced, by that type,
+// and adds the other types of |module| to |types|.  Only undecorated types
+// whose operands are all defined before them are merged; the remaining
+// duplicates are left for RemoveDuplicatesPass.  Like that pass, this keeps
+// the first of the identical types and removes the names of the other ones.
+void MergeTypes(Module* module, TypeTable* types) {
+  // Decorated types, and pointer types that are forward declared, are left
+  // alone.
+  std::unordered_set<uint32_t> pinned_ids;
+  for (const auto& inst : module->annotations())
+    inst.ForEachInId(
+        [&pinned_ids](const uint32_t* id) { pinned_ids.insert(*id); });
+  for (const auto& inst : module->types_values())
+    if (inst.opcode() == spv::Op::OpTypeForwardPointer)
+      pinned_ids.insert(inst.GetSingleWordInOperand(0u));
+
+  std::unordered_map<uint32_t, uint32_t> replacements;
+  std::unordered_set<uint32_t> defined_ids;
+  std::vector<Instruction*> to_remove;
+  for (auto& inst : module->types_values()) {
+    const uint32_t result_id = inst.result_id();
+    if (!spvOpcodeGeneratesType(inst.opcode()) || pinned_ids.count(result_id)) {
+      defined_ids.insert(result_id);
+      continue;
+    }
+
+    std::vector<uint32_t> words = {static_cast<uint32_t>(inst.opcode())};
+    bool can_merge = true;
+    for (uint32_t i = 0; i < inst.NumInOperands(); ++i) {
+      const opt::Operand& operand = inst.GetInOperand(i);
+      if (!spvIsInIdType(operand.type)) {
+        words.insert(words.end(), operand.words.begin(), operand.words.end());
+        continue;
+      }
+      const uint32_t id = operand.words[0];
+      const auto replacement = replacements.find(id);
+      if (replacement != replacements.end()) {
+        words.push_back(replacement->second);
+      } else {
+        if (!defined_ids.count(id)) can_merge = false;
+        words.push_back(id);
+      }
+    }
+    defined_ids.insert(result_id);
+    if (!can_merge) continue;
+
+    const auto entry = types->emplace(std::move(words), result_id);
+    if (!entry.second) {
+      replacements[result_id] = entry.first->second;
+      to_remove.push_back(&inst);
+    }
+  }
+  if (replacements.empty()) return;
+
+  for (auto& inst : module->debugs2()) {
+    if (replacements.count(inst.GetSingleWordOperand(0u)))
+      to_remove.push_back(&inst);
+  }
+  for (Instruction* inst : to_remove) {
+    inst->RemoveFromList();
+    delete inst;
+  }
+
+  module->ForEachInst([&replacements](Instruction* inst) {
+    inst->ForEachId([&replacements](uint32_t* id) {
+      const auto replacement = replacements.find(*id);
+      if (replacement != replacements.end()) *id = replacement->second;
+    });
+  });
+}
+
+// Moves the instructions in |insts| to |linked_module| using |add|.
+void MoveInstructions(opt::IteratorRange<Module::inst_iterator> insts,
+                      Module* linked_module,
+                      void (Module::*add)(std::unique_ptr<Instruction>)) {
+  for (auto it = insts.begin(); it != insts.end();) {
+    Instruction* inst = &*it;
+    ++it;
+    inst->RemoveFromList();
+    (linked_module->*add)(std::unique_ptr<Instruction>(inst));
+  }
+}
+
+spv_result_t StreamModules(const MessageConsumer& consumer, spv_target_env env,
+                           const uint32_t* const* binaries,
+                           const size_t* binary_sizes, size_t num_binaries,
+                           const LinkerOptions& options,
+                           IRContext* linked_context) {
+  spv_position_t position = {};
+
+  // The header of the linked module only depends on the headers of the input
+  // modules, so it is generated before any of them is built.
+  std::vector<uint32_t> versions;
+  std::vector<uint32_t> id_bounds;
+  versions.reserve(num_binaries);
+  id_bounds.reserve(num_binaries);
+  for (size_t i = 0u; i < num_binaries; ++i) {
+    const spv_const_binary_t binary = {binaries[i], binary_sizes[i]};
+    spv_endianness_t endian;
+    if (binary_sizes[i] < SPV_INDEX_INSTRUCTION ||
+        spvBinaryEndianness(&binary, &endian) != SPV_SUCCESS)
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
+             << "Failed to build module " << i + 1 << " out of " << num_binaries
+             << ".";
+
+    const uint32_t schema = binaries[i][SPV_INDEX_SCHEMA];
+    if (schema != 0u) {
+      position.index = 4u;
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
+             << "Schema is non-zero for module " << i + 1 << ".";
+    }
+    versions.push_back(
+        spvFixWord(binaries[i][SPV_INDEX_VERSION_NUMBER], endian));
+    id_bounds.push_back(spvFixWord(binaries[i][SPV_INDEX_BOUND], endian));
+  }
+
+  // Phase 1: Compute the new ID bound; the IDs are shifted as each module is
+  //          built.
+  uint32_t max_id_bound = 0u;
+  spv_result_t res = GetLinkedIdBound(consumer, id_bounds, &max_id_bound);
+  if (res != SPV_SUCCESS) return res;
+
+  // Phase 2: Generate the header
+  opt::ModuleHeader header;
+  res = GenerateHeader(consumer, versions, max_id_bound, &header, options);
+  if (res != SPV_SUCCESS) return res;
+  Module* linked_module = linked_context->module();
+  linked_module->SetHeader(header);
+
+  // Phase 3: Build each binary and move it into the linked module.  The
+  //          instructions are created in |linked_context|, so that they can
+  //          be moved rather than cloned.
+  std::vector<std::pair<uint32_t, std::string>> entry_points;
+  TypeTable types;
+  uint32_t id_offset = 0u;
+  for (size_t i = 0u; i < num_binaries; ++i) {
+    Module module;
+    module.SetContext(linked_context);
+    if (!LoadModule(env, consumer, binaries[i], binary_sizes[i], true,
+                    &module))
+      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
+             << "Failed to build module " << i + 1 << " out of " << num_binaries
+             << ".";
+
+    // The loader takes the ids of the debug line instructions it adds from
+    // |linked_context|, so they are unique already.  Only the ids below the
+    // bound of the module are its own.
+    const uint32_t module_id_bound = id_bounds[i];
+    if (id_offset != 0u) {
+      module.ForEachInst(
+          [id_offset, module_id_bound](Instruction* insn) {
+            insn->ForEachId([id_offset, module_id_bound](uint32_t* id) {
+              if (*id < module_id_bound) *id += id_offset;
+            });
+          },
+          /* run_on_debug_line_insts = */ true);
+    }
+    id_offset += module_id_bound - 1u;
+
+    const Instruction* linked_memory_model_inst =
+        i == 0u ? module.GetMemoryModel() : linked_module->GetMemoryModel();
+    res = CheckMemoryModel(consumer, linked_memory_model_inst, module, i);
+    if (res != SPV_SUCCESS) return res;
+    if (i == 0u) {
+      linked_module->SetMemoryModel(std::unique_ptr<Instruction>(
+          linked_memory_model_inst->Clone(linked_context)));
+    }
+
+    MergeTypes(&module, &types);
+
+    MoveInstructions(module.capabilities(), linked_module,
+                     &Module::AddCapability);
+    MoveInstructions(module.extensions(), linked_module,
+                     &Module::AddExtension);
+    MoveInstructions(module.ext_inst_imports(), linked_module,
+                     &Module::AddExtInstImport);
+    const auto entry_point_insts = module.entry_points();
+    for (auto it = entry_point_insts.begin(); it != entry_point_insts.end();) {
+      Instruction* inst = &*it;
+      ++it;
+      inst->RemoveFromList();
+      res = AddEntryPoint(consumer, std::unique_ptr<Instruction>(inst),
+                          &entry_points, linked_module);
+      if (res != SPV_SUCCESS) return res;
+    }
+    MoveInstructions(module.execution_modes(), linked_module,
+                     &Module::AddExecutionMode);
+    MoveInstructions(module.debugs1(), linked_module, &Module::AddDebug1Inst);
+    MoveInstructions(module.debugs2(), linked_module, &Module::AddDebug2Inst);
+    MoveInstructions(module.debugs3(), linked_module, &Module::AddDebug3Inst);
+    MoveInstructions(module.ext_inst_debuginfo(), linked_module,
+                     &Module::AddExtInstDebugInfo);
+    MoveInstructions(module.annotations(), linked_module,
+                     &Module::AddAnnotationInst);
+    MoveInstructions(module.types_values(), linked_module, &Module::AddType);
+    for (auto& func : module.ReleaseFunctions())
+      linked_module->AddFunction(std::move(func));
+  }
+
+  AddModuleProcessedInst(linked_context);
+
+  return SPV_SUCCESS;
+}
+
 spv_result_t GetImportExportPairs(const MessageConsumer& consumer,
                                   const opt::IRContext& linked_context,
                                   const DefUseManager& def_use_manager,
@@ -834,62 +1204,25 @@ spv_result_t Link(const Context& context, const uint32_t* const* binaries,
     return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
            << "No modules were given.";
 
-  std::vector<std::unique_ptr<IRContext>> ir_contexts;
-  std::vector<Module*> modules;
-  modules.reserve(num_binaries);
-  for (size_t i = 0u; i < num_binaries; ++i) {
-    const uint32_t schema = binaries[i][4u];
-    if (schema != 0u) {
-      position.index = 4u;
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
-             << "Schema is non-zero for module " << i + 1 << ".";
-    }
-
-    std::unique_ptr<IRContext> ir_context = BuildModule(
-        c_context->target_env, consumer, binaries[i], binary_sizes[i]);
-    if (ir_context == nullptr)
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_INVALID_BINARY)
-             << "Failed to build module " << i + 1 << " out of " << num_binaries
-             << ".";
-    modules.push_back(ir_context->module());
-    ir_contexts.push_back(std::move(ir_context));
-  }
-
   const bool make_multitarget = !options.GetFnVarArchitecturesCsv().empty() ||
                                 !options.GetFnVarTargetsCsv().empty();
 
-  VariantDefs variant_defs;
-
-  if (make_multitarget) {
-    if (!variant_defs.ProcessFnVar(options, modules)) {
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_FNVAR)
-             << variant_defs.GetErr();
-    }
-    if (!variant_defs.ProcessVariantDefs()) {
-      return DiagnosticStream(position, consumer, "", SPV_ERROR_FNVAR)
-             << variant_defs.GetErr();
-    }
-  }
-
-  // Phase 1: Shift the IDs used in each binary so that they occupy a disjoint
-  //          range from the other binaries, and compute the new ID bound.
-  uint32_t max_id_bound = 0u;
-  spv_result_t res = ShiftIdsInModules(consumer, &modules, &max_id_bound);
-  if (res != SPV_SUCCESS) return res;
-
-  // Phase 2: Generate the header
-  opt::ModuleHeader header;
-  res = GenerateHeader(consumer, modules, max_id_bound, &header, options);
-  if (res != SPV_SUCCESS) return res;
+  // Phases 1 to 3: Build the input modules and merge them into a single one.
+  // The streaming mode cannot be used for a multitarget module, which needs
+  // all the input modules at once.
   IRContext linked_context(c_context->target_env, consumer);
-  linked_context.module()->SetHeader(header);
-
-  if (make_multitarget) {
-    variant_defs.GenerateHeader(&linked_context);
+  std::vector<std::unique_ptr<IRContext>> ir_contexts;
+  VariantDefs variant_defs;
+  spv_result_t res;
+  if (options.GetStreaming() && !make_multitarget) {
+    res = StreamModules(consumer, c_context->target_env, binaries,
+                        binary_sizes, num_binaries, options, &linked_context);
+  } else {
+    res = LoadAndMergeModules(consumer, c_context->target_env, binaries,
+                              binary_sizes, num_binaries, options,
+                              make_multitarget, &ir_contexts, &variant_defs,
+                              &linked_context);
   }
-
-  // Phase 3: Merge all the binaries into a single one.
-  res = MergeModules(consumer, modules, &linked_context);
   if (res != SPV_SUCCESS) return res;
 
   if (options.GetVerifyIds()) {
@@ -18,7 +18,6 @@
 
 #include "source/opt/ir_context.h"
 #include "source/opt/reflect.h"
-#include "source/util/make_unique.h"
 
 namespace spvtools {
 namespace opt {
@@ -28,12 +27,27 @@ constexpr uint32_t kLoopMergeMergeBlockIdInIdx = 0;
 constexpr uint32_t kSelectionMergeMergeBlockIdInIdx = 0;
 }  // namespace
 
+void* BasicBlock::operator new(size_t size) {
+  return utils::Arena::Allocate(nullptr, size);
+}
+
+void* BasicBlock::operator new(size_t size, IRContext* c) {
+  return utils::Arena::Allocate(c ? c->arena() : nullptr, size);
+}
+
+void BasicBlock::operator delete(void* ptr) { utils::Arena::Deallocate(ptr); }
+
+void BasicBlock::operator delete(void* ptr, IRContext*) {
+  utils::Arena::Deallocate(ptr);
+}
+
 BasicBlock* BasicBlock::Clone(IRContext* context) const {
   Instruction* label_clone = GetLabelInst()->Clone(context);
   if (!label_clone) {
     return nullptr;
   }
-  BasicBlock* clone = new BasicBlock(std::unique_ptr<Instruction>(label_clone));
+  BasicBlock* clone =
+      new (context) BasicBlock(std::unique_ptr<Instruction>(label_clone));
   for (const auto& inst : insts_) {
     // Use the incoming context
     Instruction* inst_clone = inst.Clone(context);
@@ -246,9 +260,10 @@ BasicBlock* BasicBlock::SplitBasicBlock(IRContext* context, uint32_t label_id,
                                         iterator iter) {
   assert(!insts_.empty());
 
-  std::unique_ptr<BasicBlock> new_block_temp = MakeUnique<BasicBlock>(
-      MakeUnique<Instruction>(context, spv::Op::OpLabel, 0, label_id,
-                              std::initializer_list<Operand>{}));
+  std::unique_ptr<BasicBlock> new_block_temp(
+      new (context) BasicBlock(std::unique_ptr<Instruction>(
+          new (context) Instruction(context, spv::Op::OpLabel, 0, label_id,
+                                    std::initializer_list<Operand>{}))));
   BasicBlock* new_block = new_block_temp.get();
   function_->InsertBasicBlockAfter(std::move(new_block_temp), this);
 
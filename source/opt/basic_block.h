@@ -50,6 +50,13 @@ class BasicBlock {
 
   explicit BasicBlock(const BasicBlock& bb) = delete;
 
+  // Like instructions, basic blocks created with |new (c) BasicBlock(...)| are
+  // allocated from the arena of the context |c|.
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, IRContext* c);
+  static void operator delete(void* ptr);
+  static void operator delete(void* ptr, IRContext* c);
+
   // Creates a clone of the basic block in the given |context|
   //
   // The parent function will default to null and needs to be explicitly set by
@@ -194,9 +194,23 @@ void MergeWithSuccessor(IRContext* context, Function* func,
 
   EliminateOpPhiInstructions(context, &*sbi);
 
+  // The edges leaving sbi must be dropped from the CFG while sbi still has
+  // its terminator.  bi's only successor was sbi, so it gets sbi's
+  // successors once the instructions are moved.
+  const bool update_cfg = context->AreAnalysesValid(IRContext::kAnalysisCFG);
+  if (update_cfg) context->cfg()->ForgetBlock(&*sbi);
+
   // Now actually move the instructions.
   bi->AddInstructions(&*sbi);
 
+  if (update_cfg) context->cfg()->AddEdges(&*bi);
+  if (auto* dominators = context->FindDominatorAnalysis(func)) {
+    dominators->GetDomTree().MergeBlocks(&*bi, &*sbi);
+  }
+  if (auto* post_dominators = context->FindPostDominatorAnalysis(func)) {
+    post_dominators->GetDomTree().MergeBlocks(&*bi, &*sbi);
+  }
+
   if (merge_inst) {
     if (pred_is_header && lab_id == merge_inst->GetSingleWordInOperand(0u)) {
       // Merging the header and merge blocks, so remove the structured control
@@ -33,7 +33,8 @@ namespace blockmergeutil {
 bool CanMergeWithSuccessor(IRContext* context, BasicBlock* block);
 
 // Requires that |bi| has a successor that can be safely merged into |bi|, and
-// performs the merge.
+// performs the merge.  The CFG and the dominator trees of |func| are kept up
+// to date if they are valid.
 void MergeWithSuccessor(IRContext* context, Function* func,
                         Function::iterator bi);
 
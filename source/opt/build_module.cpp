@@ -58,11 +58,21 @@ std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
                                             const uint32_t* binary,
                                             const size_t size,
                                             bool extra_line_tracking) {
+  auto irContext = MakeUnique<opt::IRContext>(env, consumer);
+  if (!LoadModule(env, consumer, binary, size, extra_line_tracking,
+                  irContext->module())) {
+    return nullptr;
+  }
+  return irContext;
+}
+
+bool LoadModule(spv_target_env env, MessageConsumer consumer,
+                const uint32_t* binary, size_t size, bool extra_line_tracking,
+                opt::Module* module) {
   auto context = spvContextCreate(env);
   SetContextMessageConsumer(context, consumer);
 
-  auto irContext = MakeUnique<opt::IRContext>(env, consumer);
-  opt::IrLoader loader(consumer, irContext->module());
+  opt::IrLoader loader(consumer, module);
   loader.SetExtraLineTracking(extra_line_tracking);
 
   spv_result_t status = spvBinaryParse(context, &loader, binary, size,
@@ -71,7 +81,7 @@ std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
 
   spvContextDestroy(context);
 
-  return status == SPV_SUCCESS ? std::move(irContext) : nullptr;
+  return status == SPV_SUCCESS;
 }
 
 std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
@@ -41,6 +41,15 @@ std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
                                             const uint32_t* binary,
                                             size_t size);
 
+// Parses the given SPIR-V |binary| of |size| words into |module|, which should
+// be empty and have a context.  The instructions are created in the context of
+// |module|, and the extra OpLine instructions injected when
+// |extra_line_tracking| is true take their ids from it.  Returns false if
+// errors occur and sends the errors to |consumer|.
+bool LoadModule(spv_target_env env, MessageConsumer consumer,
+                const uint32_t* binary, size_t size, bool extra_line_tracking,
+                opt::Module* module);
+
 // Builds a Module and returns the owning IRContext from the given
 // SPIR-V assembly |text|.  The |text| will be encoded according to the given
 // target |env|. Returns nullptr if errors occur and sends the errors to
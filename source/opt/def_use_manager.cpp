@@ -14,20 +14,96 @@
 
 #include "source/opt/def_use_manager.h"
 
+#include <algorithm>
+
 namespace spvtools {
 namespace opt {
 namespace analysis {
 
+DefUseManager::IdEntry& DefUseManager::GetIdEntry(uint32_t id) {
+  if (id >= ids_.size()) {
+    ids_.resize(std::max<size_t>(id + 1, ids_.size() * 2));
+  }
+  return ids_[id];
+}
+
+const DefUseManager::UserList* DefUseManager::GetUsers(uint32_t id) const {
+  if (id >= ids_.size()) return nullptr;
+  return &ids_[id].users;
+}
+
+const DefUseManager::UsedIds* DefUseManager::GetUsedIds(
+    const Instruction* inst) const {
+  const uint32_t unique_id = inst->unique_id();
+  if (unique_id >= used_ids_.size() || !used_ids_[unique_id].analyzed) {
+    return nullptr;
+  }
+  return &used_ids_[unique_id];
+}
+
+void DefUseManager::AddUser(UserList* list, Instruction* user) {
+  const uint32_t unique_id = user->unique_id();
+  std::vector<UserSlot>& slots = list->slots;
+  // Instructions are mostly analyzed in the order they were created.
+  if (slots.empty() || slots.back().unique_id < unique_id) {
+    slots.push_back({unique_id, user});
+    return;
+  }
+
+  auto iter = std::lower_bound(slots.begin(), slots.end(), unique_id,
+                               [](const UserSlot& slot, uint32_t id) {
+                                 return slot.unique_id < id;
+                               });
+  if (iter != slots.end() && iter->unique_id == unique_id) {
+    if (iter->user == nullptr) {
+      iter->user = user;
+      --list->num_removed;
+    }
+    return;
+  }
+  slots.insert(iter, {unique_id, user});
+}
+
+void DefUseManager::RemoveUser(UserList* list, const Instruction* user) {
+  const uint32_t unique_id = user->unique_id();
+  std::vector<UserSlot>& slots = list->slots;
+  auto iter = std::lower_bound(slots.begin(), slots.end(), unique_id,
+                               [](const UserSlot& slot, uint32_t id) {
+                                 return slot.unique_id < id;
+                               });
+  if (iter == slots.end() || iter->unique_id != unique_id ||
+      iter->user == nullptr) {
+    return;
+  }
+
+  // Removing from the middle of a large list is expensive, so users are only
+  // marked as removed, and the list is compacted once half of it is unused.
+  iter->user = nullptr;
+  ++list->num_removed;
+  if (list->num_removed * 2 > slots.size()) {
+    slots.erase(std::remove_if(slots.begin(), slots.end(),
+                               [](const UserSlot& slot) {
+                                 return slot.user == nullptr;
+                               }),
+                slots.end());
+    list->num_removed = 0;
+  }
+}
+
 void DefUseManager::AnalyzeInstDef(Instruction* inst) {
+  ++num_updates_;
   const uint32_t def_id = inst->result_id();
   if (def_id != 0) {
-    auto iter = id_to_def_.find(def_id);
-    if (iter != id_to_def_.end()) {
+    IdEntry& entry = GetIdEntry(def_id);
+    if (entry.def != nullptr) {
       // Clear the original instruction that defining the same result id of the
       // new instruction.
-      ClearInst(iter->second);
+      ClearInst(entry.def);
+      // The users of an original instruction that was never analyzed are not
+      // users of the new one.
+      if (entry.def != nullptr && entry.def != inst) entry.users = UserList();
     }
-    id_to_def_[def_id] = inst;
+    entry.def = inst;
   } else {
     ClearInst(inst);
   }
@@ -37,12 +113,14 @@ void DefUseManager::AnalyzeInstUse(Instruction* inst) {
   // Create entry for the given instruction. Note that the instruction may
   // not have any in-operands. In such cases, we still need a entry for those
   // instructions so this manager knows it has seen the instruction later.
-  auto* used_ids = &inst_to_used_ids_[inst];
-  if (used_ids->size()) {
-    EraseUseRecordsOfOperandIds(inst);
-    used_ids = &inst_to_used_ids_[inst];
+  ++num_updates_;
+  EraseUseRecordsOfOperandIds(inst);
+  const uint32_t unique_id = inst->unique_id();
+  if (unique_id >= used_ids_.size()) {
+    used_ids_.resize(std::max<size_t>(unique_id + 1, used_ids_.size() * 2));
   }
-  used_ids->clear();  // It might have existed before.
+  UsedIds& used_ids = used_ids_[unique_id];
+  used_ids.analyzed = true;
 
   for (uint32_t i = 0; i < inst->NumOperands(); ++i) {
     switch (inst->GetOperand(i).type) {
@@ -52,10 +130,9 @@ void DefUseManager::AnalyzeInstUse(Instruction* inst) {
       case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
       case SPV_OPERAND_TYPE_SCOPE_ID: {
         uint32_t use_id = inst->GetSingleWordOperand(i);
-        Instruction* def = GetDef(use_id);
-        assert(def && "Definition is not registered.");
-        id_to_users_.insert(UserEntry{def, inst});
-        used_ids->push_back(use_id);
+        assert(GetDef(use_id) && "Definition is not registered.");
+        AddUser(&GetIdEntry(use_id).users, inst);
+        used_ids.ids.push_back(use_id);
       } break;
       default:
         break;
@@ -73,42 +150,55 @@ void DefUseManager::AnalyzeInstDefUse(Instruction* inst) {
 
 void DefUseManager::UpdateDefUse(Instruction* inst) {
   const uint32_t def_id = inst->result_id();
-  if (def_id != 0) {
-    auto iter = id_to_def_.find(def_id);
-    if (iter == id_to_def_.end()) {
-      AnalyzeInstDef(inst);
-    }
+  if (def_id != 0 && GetDef(def_id) == nullptr) {
+    AnalyzeInstDef(inst);
   }
   AnalyzeInstUse(inst);
 }
 
 Instruction* DefUseManager::GetDef(uint32_t id) {
-  auto iter = id_to_def_.find(id);
-  if (iter == id_to_def_.end()) return nullptr;
-  return iter->second;
+  if (id >= ids_.size()) return nullptr;
+  return ids_[id].def;
 }
 
 const Instruction* DefUseManager::GetDef(uint32_t id) const {
-  const auto iter = id_to_def_.find(id);
-  if (iter == id_to_def_.end()) return nullptr;
-  return iter->second;
+  if (id >= ids_.size()) return nullptr;
+  return ids_[id].def;
 }
 
-DefUseManager::IdToUsersMap::const_iterator DefUseManager::UsersBegin(
-    const Instruction* def) const {
-  return id_to_users_.lower_bound(
-      UserEntry{const_cast<Instruction*>(def), nullptr});
-}
-
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const IdToUsersMap::const_iterator& cached_end,
-                                const Instruction* inst) const {
-  return (iter != cached_end && iter->def == inst);
+DefUseManager::IdToDefMap DefUseManager::id_to_defs() const {
+  IdToDefMap id_to_def;
+  for (uint32_t id = 0; id < ids_.size(); ++id) {
+    if (ids_[id].def != nullptr) id_to_def[id] = ids_[id].def;
+  }
+  return id_to_def;
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const Instruction* inst) const {
-  return UsersNotEnd(iter, id_to_users_.end(), inst);
+bool DefUseManager::WhileEachUserOfId(
+    uint32_t id, const std::function<bool(Instruction*)>& f) const {
+  // |f| may add or remove users, and may grow the table, so the list is
+  // looked up again after each call, and the position following the last
+  // visited user is searched for if the list changed.
+  size_t index = 0;
+  while (true) {
+    const UserList* list = GetUsers(id);
+    if (list == nullptr || index >= list->slots.size()) return true;
+    const UserSlot slot = list->slots[index];
+    if (slot.user != nullptr && !f(slot.user)) return false;
+
+    list = GetUsers(id);
+    if (index < list->slots.size() &&
+        list->slots[index].unique_id == slot.unique_id) {
+      ++index;
+    } else {
+      auto next = std::upper_bound(list->slots.begin(), list->slots.end(),
+                                   slot.unique_id,
+                                   [](uint32_t unique_id, const UserSlot& s) {
+                                     return unique_id < s.unique_id;
+                                   });
+      index = next - list->slots.begin();
+    }
+  }
 }
 
 bool DefUseManager::WhileEachUser(
@@ -117,12 +207,7 @@ bool DefUseManager::WhileEachUser(
   assert(def && (!def->HasResultId() || def == GetDef(def->result_id())) &&
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
-
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    if (!f(iter->user)) return false;
-  }
-  return true;
+  return WhileEachUserOfId(def->result_id(), f);
 }
 
 bool DefUseManager::WhileEachUser(
@@ -151,19 +236,18 @@ bool DefUseManager::WhileEachUse(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    Instruction* user = iter->user;
+  const uint32_t def_id = def->result_id();
+  return WhileEachUserOfId(def_id, [def_id, &f](Instruction* user) {
     for (uint32_t idx = 0; idx != user->NumOperands(); ++idx) {
       const Operand& op = user->GetOperand(idx);
       if (op.type != SPV_OPERAND_TYPE_RESULT_ID && spvIsIdType(op.type)) {
-        if (def->result_id() == op.words[0]) {
+        if (def_id == op.words[0]) {
           if (!f(user, idx)) return false;
         }
       }
     }
-  }
-  return true;
+    return true;
+  });
 }
 
 bool DefUseManager::WhileEachUse(
@@ -220,6 +304,16 @@ std::vector<Instruction*> DefUseManager::GetAnnotations(uint32_t id) const {
 
 void DefUseManager::AnalyzeDefUse(Module* module) {
   if (!module) return;
+  // Size the tables once for the whole module.
+  ids_.resize(module->IdBound());
+  uint32_t max_unique_id = 0;
+  module->ForEachInst(
+      [&max_unique_id](Instruction* inst) {
+        max_unique_id = std::max(max_unique_id, inst->unique_id());
+      },
+      true);
+  used_ids_.resize(max_unique_id + 1);
+
   // Analyze all the defs before any uses to catch forward references.
   module->ForEachInst(
       std::bind(&DefUseManager::AnalyzeInstDef, this, std::placeholders::_1),
@@ -227,80 +321,101 @@ void DefUseManager::AnalyzeDefUse(Module* module) {
   module->ForEachInst(
       std::bind(&DefUseManager::AnalyzeInstUse, this, std::placeholders::_1),
       true);
+  // Only the updates made after the manager was built are of interest.
+  num_updates_ = 0;
 }
 
 void DefUseManager::ClearInst(Instruction* inst) {
-  auto iter = inst_to_used_ids_.find(inst);
-  if (iter != inst_to_used_ids_.end()) {
-    EraseUseRecordsOfOperandIds(inst);
-    if (inst->result_id() != 0) {
-      // Remove all uses of this inst.
-      auto users_begin = UsersBegin(inst);
-      auto end = id_to_users_.end();
-      auto new_end = users_begin;
-      for (; UsersNotEnd(new_end, end, inst); ++new_end) {
-      }
-      id_to_users_.erase(users_begin, new_end);
-      id_to_def_.erase(inst->result_id());
-    }
+  if (GetUsedIds(inst) == nullptr) return;
+  ++num_updates_;
+  EraseUseRecordsOfOperandIds(inst);
+  const uint32_t def_id = inst->result_id();
+  if (def_id != 0 && def_id < ids_.size()) {
+    // Remove all uses of this inst.
+    if (ids_[def_id].def == inst) ids_[def_id].users = UserList();
+    ids_[def_id].def = nullptr;
   }
 }
 
 void DefUseManager::EraseUseRecordsOfOperandIds(const Instruction* inst) {
   // Go through all ids used by this instruction, remove this instruction's
   // uses of them.
-  auto iter = inst_to_used_ids_.find(inst);
-  if (iter != inst_to_used_ids_.end()) {
-    for (auto use_id : iter->second) {
-      id_to_users_.erase(
-          UserEntry{GetDef(use_id), const_cast<Instruction*>(inst)});
-    }
-    inst_to_used_ids_.erase(iter);
+  const uint32_t unique_id = inst->unique_id();
+  if (unique_id >= used_ids_.size()) return;
+  UsedIds& used_ids = used_ids_[unique_id];
+  for (uint32_t use_id : used_ids.ids) {
+    if (use_id < ids_.size()) RemoveUser(&ids_[use_id].users, inst);
   }
+  used_ids.ids.clear();
+  used_ids.analyzed = false;
 }
 
 bool CompareAndPrintDifferences(const DefUseManager& lhs,
                                 const DefUseManager& rhs) {
   bool same = true;
 
-  if (lhs.id_to_def_ != rhs.id_to_def_) {
-    for (auto p : lhs.id_to_def_) {
-      if (rhs.id_to_def_.find(p.first) == rhs.id_to_def_.end()) {
-        printf("Diff in id_to_def: missing value in rhs\n");
-      }
-    }
-    for (auto p : rhs.id_to_def_) {
-      if (lhs.id_to_def_.find(p.first) == lhs.id_to_def_.end()) {
-        printf("Diff in id_to_def: missing value in lhs\n");
-      }
+  const size_t num_ids = std::max(lhs.ids_.size(), rhs.ids_.size());
+  bool same_defs = true;
+  for (uint32_t id = 0; id < num_ids; ++id) {
+    const Instruction* lhs_def = lhs.GetDef(id);
+    const Instruction* rhs_def = rhs.GetDef(id);
+    if (lhs_def == rhs_def) continue;
+    if (rhs_def == nullptr) {
+      printf("Diff in id_to_def: missing value in rhs\n");
+    } else if (lhs_def == nullptr) {
+      printf("Diff in id_to_def: missing value in lhs\n");
     }
-    same = false;
+    same_defs = false;
   }
-
-  if (lhs.id_to_users_ != rhs.id_to_users_) {
-    for (auto p : lhs.id_to_users_) {
-      if (rhs.id_to_users_.count(p) == 0) {
+  same = same && same_defs;
+
+  // Returns the users recorded in |users|, or none if it is null.
+  auto live_users = [](const DefUseManager::UserList* users) {
+    std::vector<const Instruction*> result;
+    if (users == nullptr) return result;
+    for (const auto& slot : users->slots) {
+      if (slot.user != nullptr) result.push_back(slot.user);
+    }
+    return result;
+  };
+  for (uint32_t id = 0; id < num_ids; ++id) {
+    if (lhs.GetDef(id) != rhs.GetDef(id)) continue;
+    const auto lhs_users = live_users(lhs.GetUsers(id));
+    const auto rhs_users = live_users(rhs.GetUsers(id));
+    if (lhs_users == rhs_users) continue;
+    for (const Instruction* user : lhs_users) {
+      if (std::find(rhs_users.begin(), rhs_users.end(), user) ==
+          rhs_users.end()) {
         printf("Diff in id_to_users: missing value in rhs\n");
       }
     }
-    for (auto p : rhs.id_to_users_) {
-      if (lhs.id_to_users_.count(p) == 0) {
+    for (const Instruction* user : rhs_users) {
+      if (std::find(lhs_users.begin(), lhs_users.end(), user) ==
+          lhs_users.end()) {
         printf("Diff in id_to_users: missing value in lhs\n");
       }
     }
     same = false;
   }
 
-  if (lhs.inst_to_used_ids_ != rhs.inst_to_used_ids_) {
-    for (auto p : lhs.inst_to_used_ids_) {
-      if (rhs.inst_to_used_ids_.count(p.first) == 0) {
-        printf("Diff in inst_to_used_ids: missing value in rhs\n");
-      }
-    }
-    for (auto p : rhs.inst_to_used_ids_) {
-      if (lhs.inst_to_used_ids_.count(p.first) == 0) {
-        printf("Diff in inst_to_used_ids: missing value in lhs\n");
-      }
+  const size_t num_insts =
+      std::max(lhs.used_ids_.size(), rhs.used_ids_.size());
+  for (uint32_t unique_id = 0; unique_id < num_insts; ++unique_id) {
+    const DefUseManager::UsedIds* lhs_used =
+        unique_id < lhs.used_ids_.size() && lhs.used_ids_[unique_id].analyzed
+            ? &lhs.used_ids_[unique_id]
+            : nullptr;
+    const DefUseManager::UsedIds* rhs_used =
+        unique_id < rhs.used_ids_.size() && rhs.used_ids_[unique_id].analyzed
+            ? &rhs.used_ids_[unique_id]
+            : nullptr;
+    if (lhs_used == nullptr && rhs_used == nullptr) continue;
+    if (rhs_used == nullptr) {
+      printf("Diff in inst_to_used_ids: missing value in rhs\n");
+    } else if (lhs_used == nullptr) {
+      printf("Diff in inst_to_used_ids: missing value in lhs\n");
+    } else if (lhs_used->ids == rhs_used->ids) {
+      continue;
     }
     same = false;
   }
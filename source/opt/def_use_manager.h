@@ -15,63 +15,23 @@
 #ifndef SOURCE_OPT_DEF_USE_MANAGER_H_
 #define SOURCE_OPT_DEF_USE_MANAGER_H_
 
-#include <set>
 #include <unordered_map>
 #include <vector>
 
 #include "source/opt/instruction.h"
 #include "source/opt/module.h"
+#include "source/util/small_vector.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
 namespace opt {
 namespace analysis {
 
-// Definition should never be null. User can be null, however, such an entry
-// should be used only for searching (e.g. all users of a particular definition)
-// and never stored in a container.
-struct UserEntry {
-  Instruction* def;
-  Instruction* user;
-};
-
-inline bool operator==(const UserEntry& lhs, const UserEntry& rhs) {
-  return lhs.def == rhs.def && lhs.user == rhs.user;
-}
-
-// Orders UserEntry for use in associative containers (i.e. less than ordering).
-//
-// The definition of an UserEntry is treated as the major key and the users as
-// the minor key so that all the users of a particular definition are
-// consecutive in a container.
-//
-// A null user always compares less than a real user. This is done to provide
-// easy values to search for the beginning of the users of a particular
-// definition (i.e. using {def, nullptr}).
-struct UserEntryLess {
-  bool operator()(const UserEntry& lhs, const UserEntry& rhs) const {
-    // If lhs.def and rhs.def are both null, fall through to checking the
-    // second entries.
-    if (!lhs.def && rhs.def) return true;
-    if (lhs.def && !rhs.def) return false;
-
-    // If neither definition is null, then compare unique ids.
-    if (lhs.def && rhs.def) {
-      if (lhs.def->unique_id() < rhs.def->unique_id()) return true;
-      if (rhs.def->unique_id() < lhs.def->unique_id()) return false;
-    }
-
-    // Return false on equality.
-    if (!lhs.user && !rhs.user) return false;
-    if (!lhs.user) return true;
-    if (!rhs.user) return false;
-
-    // If neither user is null then compare unique ids.
-    return lhs.user->unique_id() < rhs.user->unique_id();
-  }
-};
-
 // A class for analyzing and managing defs and uses in an Module.
+//
+// Definitions and their users are kept in tables indexed by result id, and the
+// ids used by each instruction in a table indexed by its unique id, so that
+// the analysis of a module does not need any hashing or tree nodes.
 class DefUseManager {
  public:
   using IdToDefMap = std::unordered_map<uint32_t, Instruction*>;
@@ -172,8 +132,9 @@ class DefUseManager {
   // instructions which decorate the decoration group will not be returned.
   std::vector<Instruction*> GetAnnotations(uint32_t id) const;
 
-  // Returns the map from ids to their def instructions.
-  const IdToDefMap& id_to_defs() const { return id_to_def_; }
+  // Returns a map from ids to their def instructions.  The map is built on
+  // each call.
+  IdToDefMap id_to_defs() const;
 
   // Clear the internal def-use record of the given instruction |inst|. This
   // method will update the use information of the operand ids of |inst|. The
@@ -192,35 +153,69 @@ class DefUseManager {
   // uses.
   void UpdateDefUse(Instruction* inst);
 
- private:
-  using IdToUsersMap = std::set<UserEntry, UserEntryLess>;
-  using InstToUsedIdsMap =
-      std::unordered_map<const Instruction*, std::vector<uint32_t>>;
-
-  // Returns the first location that {|def|, nullptr} could be inserted into the
-  // users map without violating ordering.
-  IdToUsersMap::const_iterator UsersBegin(const Instruction* def) const;
+  // Returns the number of times the definition or the uses of an instruction
+  // were recorded or cleared since the manager was built.
+  size_t num_updates() const { return num_updates_; }
 
-  // Returns true if |iter| has not reached the end of |def|'s users.
-  //
-  // In the first version |iter| is compared against the end of the map for
-  // validity before other checks. In the second version, |iter| is compared
-  // against |cached_end| for validity before other checks. This allows caching
-  // the map's end which is a performance improvement on some platforms.
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const Instruction* def) const;
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const IdToUsersMap::const_iterator& cached_end,
-                   const Instruction* def) const;
+ private:
+  // A user of a definition.  |user| is null if the user was removed but the
+  // entry has not been compacted away yet.
+  struct UserSlot {
+    uint32_t unique_id;
+    Instruction* user;
+  };
+
+  // The users of a definition, ordered by unique id.
+  struct UserList {
+    std::vector<UserSlot> slots;
+    // The number of slots whose user was removed.
+    uint32_t num_removed = 0;
+  };
+
+  // The definition of an id and its users.
+  struct IdEntry {
+    Instruction* def = nullptr;
+    UserList users;
+  };
+
+  // The ids used by an analyzed instruction.
+  struct UsedIds {
+    bool analyzed = false;
+    utils::SmallVector<uint32_t, 4> ids;
+  };
+
+  // Returns the entry for |id|, growing the table if needed.
+  IdEntry& GetIdEntry(uint32_t id);
+
+  // Returns the users of the definition of |id|, or nullptr if |id| has none.
+  const UserList* GetUsers(uint32_t id) const;
+
+  // Returns the record of the ids used by |inst|, or nullptr if |inst| was
+  // never analyzed.
+  const UsedIds* GetUsedIds(const Instruction* inst) const;
+
+  // Records |user| as a user in |list|.  Does nothing if it already is one.
+  static void AddUser(UserList* list, Instruction* user);
+
+  // Removes |user| from |list| if it is in it.
+  static void RemoveUser(UserList* list, const Instruction* user);
+
+  // Calls |f| on each user in the users of |id|, in order of unique id, until
+  // |f| returns false.  Returns false if |f| did.  |f| may add and remove
+  // users of |id|.
+  bool WhileEachUserOfId(uint32_t id,
+                         const std::function<bool(Instruction*)>& f) const;
 
   // Analyzes the defs and uses in the given |module| and populates data
   // structures in this class. Does nothing if |module| is nullptr.
   void AnalyzeDefUse(Module* module);
 
-  IdToDefMap id_to_def_;      // Mapping from ids to their definitions
-  IdToUsersMap id_to_users_;  // Mapping from ids to their users
-  // Mapping from instructions to the ids used in the instruction.
-  InstToUsedIdsMap inst_to_used_ids_;
+  // The definitions and users, indexed by id.
+  std::vector<IdEntry> ids_;
+  // The ids used by each analyzed instruction, indexed by unique id.
+  std::vector<UsedIds> used_ids_;
+  // See num_updates().
+  size_t num_updates_ = 0;
 };
 
 }  // namespace analysis
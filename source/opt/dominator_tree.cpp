@@ -14,7 +14,10 @@
 
 #include <iostream>
 #include <memory>
+#include <queue>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "source/cfa.h"
 #include "source/opt/dominator_tree.h"
@@ -235,6 +238,11 @@ bool DominatorTree::Dominates(const DominatorTreeNode* a,
   // Node A dominates node B if they are the same.
   if (a == b) return true;
 
+  // The numbering is left stale by the updates, and only recomputed when it is
+  // needed.
+  if (!df_numbering_valid_) {
+    const_cast<DominatorTree*>(this)->ResetDFNumbering();
+  }
   return a->dfs_num_pre_ < b->dfs_num_pre_ &&
          a->dfs_num_post_ > b->dfs_num_post_;
 }
@@ -249,10 +257,8 @@ BasicBlock* DominatorTree::ImmediateDominator(const BasicBlock* A) const {
 
 BasicBlock* DominatorTree::ImmediateDominator(uint32_t a) const {
   // Check that A is a valid node in the tree.
-  auto a_itr = nodes_.find(a);
-  if (a_itr == nodes_.end()) return nullptr;
-
-  const DominatorTreeNode* node = &a_itr->second;
+  const DominatorTreeNode* node = GetTreeNode(a);
+  if (node == nullptr) return nullptr;
 
   if (node->parent_ == nullptr) {
     return nullptr;
@@ -261,21 +267,34 @@ BasicBlock* DominatorTree::ImmediateDominator(uint32_t a) const {
   return node->parent_->bb_;
 }
 
-DominatorTreeNode* DominatorTree::GetOrInsertNode(BasicBlock* bb) {
-  DominatorTreeNode* dtn = nullptr;
+DominatorTreeNode* DominatorTree::FindNode(uint32_t id) const {
+  auto iter = node_index_.find(id);
+  if (iter == node_index_.end()) return nullptr;
+  return iter->second;
+}
 
-  std::map<uint32_t, DominatorTreeNode>::iterator node_iter =
-      nodes_.find(bb->id());
-  if (node_iter == nodes_.end()) {
-    dtn = &nodes_.emplace(std::make_pair(bb->id(), DominatorTreeNode{bb}))
-               .first->second;
-  } else {
-    dtn = &node_iter->second;
-  }
+DominatorTreeNode* DominatorTree::GetOrInsertNode(BasicBlock* bb) {
+  auto iter = node_index_.find(bb->id());
+  if (iter != node_index_.end()) return iter->second;
 
+  nodes_.emplace_back(bb);
+  DominatorTreeNode* dtn = &nodes_.back();
+  node_index_.emplace(bb->id(), dtn);
   return dtn;
 }
 
+void DominatorTree::EraseNode(DominatorTreeNode* node) {
+  assert(node->children_.empty());
+  if (node->parent_ != nullptr) {
+    auto& siblings = node->parent_->children_;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+    node->parent_ = nullptr;
+  }
+  auto iter = node_index_.find(node->id());
+  assert(iter != node_index_.end() && iter->second == node);
+  node_index_.erase(iter);
+}
+
 void DominatorTree::GetDominatorEdges(
     const Function* f, const BasicBlock* placeholder_start_node,
     std::vector<std::pair<BasicBlock*, BasicBlock*>>* edges) {
@@ -312,6 +331,7 @@ void DominatorTree::GetDominatorEdges(
 
 void DominatorTree::InitializeTree(const CFG& cfg, const Function* f) {
   ClearTree();
+  function_ = f;
 
   // Skip over empty functions.
   if (f->cbegin() == f->cend()) {
@@ -326,7 +346,14 @@ void DominatorTree::InitializeTree(const CFG& cfg, const Function* f) {
   GetDominatorEdges(f, placeholder_start_node, &edges);
 
   // Transform the vector<pair> into the tree structure which we can use to
-  // efficiently query dominance.
+  // efficiently query dominance.  Every block in the tree is the first block
+  // of an edge, so all nodes are created before they are linked.
+  node_index_.reserve(edges.size());
+  for (const auto& edge : edges) {
+    nodes_.emplace_back(edge.first);
+    node_index_.emplace(edge.first->id(), &nodes_.back());
+  }
+
   for (auto edge : edges) {
     DominatorTreeNode* first = GetOrInsertNode(edge.first);
 
@@ -347,7 +374,9 @@ void DominatorTree::InitializeTree(const CFG& cfg, const Function* f) {
 void DominatorTree::ResetDFNumbering() {
   int index = 0;
   auto preFunc = [&index](const DominatorTreeNode* node) {
-    const_cast<DominatorTreeNode*>(node)->dfs_num_pre_ = ++index;
+    DominatorTreeNode* mutable_node = const_cast<DominatorTreeNode*>(node);
+    mutable_node->dfs_num_pre_ = ++index;
+    mutable_node->depth_ = node->parent_ ? node->parent_->depth_ + 1 : 0;
   };
 
   auto postFunc = [&index](const DominatorTreeNode* node) {
@@ -357,6 +386,377 @@ void DominatorTree::ResetDFNumbering() {
   auto getSucc = [](const DominatorTreeNode* node) { return &node->children_; };
 
   for (auto root : roots_) DepthFirstSearch(root, getSucc, preFunc, postFunc);
+  df_numbering_valid_ = true;
+}
+
+void DominatorTree::UpdateDepths(DominatorTreeNode* node) {
+  for (auto iter = node->df_begin(); iter != node->df_end(); ++iter) {
+    iter->depth_ = iter->parent_ ? iter->parent_->depth_ + 1 : 0;
+  }
+}
+
+DominatorTreeNode* DominatorTree::NearestCommonDominator(
+    DominatorTreeNode* a, DominatorTreeNode* b) {
+  while (a != b && a != nullptr && b != nullptr) {
+    if (a->depth_ < b->depth_) {
+      b = b->parent_;
+    } else {
+      a = a->parent_;
+    }
+  }
+  return a == b ? a : nullptr;
+}
+
+std::vector<BasicBlock*> DominatorTree::Successors(
+    const CFG& cfg, const BasicBlock* bb) const {
+  assert(!postdominator_);
+  std::vector<BasicBlock*> successors;
+  if (bb == cfg.pseudo_entry_block()) {
+    successors.push_back(function_->entry().get());
+  } else {
+    bb->ForEachSuccessorLabel([&cfg, &successors](const uint32_t id) {
+      successors.push_back(cfg.block(id));
+    });
+  }
+  return successors;
+}
+
+void DominatorTree::BuildRegion(
+    const CFG& cfg, BasicBlock* root,
+    const std::function<bool(const BasicBlock*)>& in_region,
+    std::vector<std::pair<BasicBlock*, BasicBlock*>>* exit_edges) {
+  // Number the blocks of the region in depth first preorder, recording the
+  // parent of each block in the depth first spanning tree and the
+  // predecessors of each block within the region.
+  std::vector<BasicBlock*> blocks = {root};
+  std::vector<uint32_t> parent = {0};
+  std::vector<std::vector<uint32_t>> preds(1);
+  std::unordered_map<const BasicBlock*, uint32_t> number = {{root, 0}};
+  struct StackEntry {
+    uint32_t number;
+    std::vector<BasicBlock*> successors;
+    size_t next;
+  };
+  std::vector<StackEntry> stack;
+  stack.push_back({0, Successors(cfg, root), 0});
+  while (!stack.empty()) {
+    StackEntry& top = stack.back();
+    if (top.next == top.successors.size()) {
+      stack.pop_back();
+      continue;
+    }
+    const uint32_t pred = top.number;
+    BasicBlock* succ = top.successors[top.next++];
+    auto iter = number.find(succ);
+    if (iter != number.end()) {
+      preds[iter->second].push_back(pred);
+      continue;
+    }
+    if (!in_region(succ)) {
+      if (exit_edges) exit_edges->emplace_back(blocks[pred], succ);
+      continue;
+    }
+    const uint32_t succ_number = static_cast<uint32_t>(blocks.size());
+    number[succ] = succ_number;
+    blocks.push_back(succ);
+    parent.push_back(pred);
+    preds.emplace_back(1, pred);
+    // |top| is invalidated by the push.
+    stack.push_back({succ_number, Successors(cfg, succ), 0});
+  }
+
+  // Semi-NCA: compute the semidominators with the path compressing evaluation
+  // of Lengauer-Tarjan, then find each immediate dominator as the nearest
+  // ancestor of the spanning tree parent whose number is at most the
+  // semidominator.
+  const uint32_t count = static_cast<uint32_t>(blocks.size());
+  std::vector<uint32_t> idom = parent;
+  std::vector<uint32_t> ancestor = parent;
+  std::vector<uint32_t> semi(count);
+  std::vector<uint32_t> label(count);
+  for (uint32_t i = 0; i < count; ++i) semi[i] = label[i] = i;
+
+  std::vector<uint32_t> eval_stack;
+  auto eval = [&](uint32_t v, uint32_t last_linked) {
+    if (ancestor[v] < last_linked) return label[v];
+    eval_stack.clear();
+    do {
+      eval_stack.push_back(v);
+      v = ancestor[v];
+    } while (ancestor[v] >= last_linked);
+    uint32_t p = v;
+    uint32_t p_label = label[p];
+    do {
+      v = eval_stack.back();
+      eval_stack.pop_back();
+      ancestor[v] = ancestor[p];
+      if (semi[p_label] < semi[label[v]]) {
+        label[v] = p_label;
+      } else {
+        p_label = label[v];
+      }
+      p = v;
+    } while (!eval_stack.empty());
+    return label[v];
+  };
+
+  for (uint32_t i = count - 1; i > 0; --i) {
+    semi[i] = parent[i];
+    for (uint32_t pred : preds[i]) {
+      semi[i] = std::min(semi[i], semi[eval(pred, i + 1)]);
+    }
+  }
+  for (uint32_t i = 1; i < count; ++i) {
+    uint32_t candidate = idom[i];
+    while (candidate > semi[i]) candidate = idom[candidate];
+    idom[i] = candidate;
+  }
+
+  std::vector<DominatorTreeNode*> nodes(count);
+  for (uint32_t i = 0; i < count; ++i) nodes[i] = GetOrInsertNode(blocks[i]);
+  for (uint32_t i = 1; i < count; ++i) {
+    assert(nodes[i]->parent_ == nullptr);
+    nodes[i]->parent_ = nodes[idom[i]];
+    nodes[idom[i]]->children_.push_back(nodes[i]);
+  }
+}
+
+void DominatorTree::InsertReachableEdge(const CFG& cfg,
+                                        DominatorTreeNode* from,
+                                        DominatorTreeNode* to) {
+  // After inserting the edge, a node v changes its immediate dominator to the
+  // nearest common dominator of |from| and |to| if and only if v is deeper
+  // than one below it, and there is a path from |to| to v on which no node is
+  // shallower than v.  The nodes are found with a depth based search, which
+  // visits the deepest candidates first.
+  DominatorTreeNode* ncd = NearestCommonDominator(from, to);
+  if (ncd == nullptr || ncd == to || ncd->depth_ + 1 >= to->depth_) return;
+
+  auto shallower = [](const DominatorTreeNode* a, const DominatorTreeNode* b) {
+    return a->depth_ < b->depth_;
+  };
+  std::priority_queue<DominatorTreeNode*, std::vector<DominatorTreeNode*>,
+                      decltype(shallower)>
+      bucket(shallower);
+  std::unordered_set<DominatorTreeNode*> visited = {to};
+  std::vector<DominatorTreeNode*> affected;
+  std::vector<DominatorTreeNode*> unaffected_on_level;
+  bucket.push(to);
+  while (!bucket.empty()) {
+    DominatorTreeNode* node = bucket.top();
+    bucket.pop();
+    affected.push_back(node);
+
+    const uint32_t level = node->depth_;
+    while (true) {
+      for (BasicBlock* succ : Successors(cfg, node->bb_)) {
+        DominatorTreeNode* succ_node = GetTreeNode(succ->id());
+        assert(succ_node && "A reachable block has an unreachable successor.");
+        if (succ_node->depth_ <= ncd->depth_ + 1 ||
+            !visited.insert(succ_node).second) {
+          continue;
+        }
+        if (succ_node->depth_ > level) {
+          // Not affected, but may lead to affected nodes.
+          unaffected_on_level.push_back(succ_node);
+        } else {
+          bucket.push(succ_node);
+        }
+      }
+      if (unaffected_on_level.empty()) break;
+      node = unaffected_on_level.back();
+      unaffected_on_level.pop_back();
+    }
+  }
+
+  for (DominatorTreeNode* node : affected) {
+    auto& siblings = node->parent_->children_;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+    node->parent_ = ncd;
+    ncd->children_.push_back(node);
+  }
+  // The subtrees of the affected nodes are disjoint once they are all
+  // children of |ncd|.
+  for (DominatorTreeNode* node : affected) UpdateDepths(node);
+}
+
+void DominatorTree::InsertUnreachableEdge(const CFG& cfg,
+                                          DominatorTreeNode* from,
+                                          BasicBlock* to) {
+  // The blocks that became reachable can only be entered through the new
+  // edge, so their dominators are found from |to| alone.  The edges from them
+  // to blocks that were already reachable are then handled as insertions.
+  std::vector<std::pair<BasicBlock*, BasicBlock*>> exit_edges;
+  BuildRegion(
+      cfg, to,
+      [this](const BasicBlock* bb) { return GetTreeNode(bb->id()) == nullptr; },
+      &exit_edges);
+  DominatorTreeNode* to_node = GetTreeNode(to->id());
+  to_node->parent_ = from;
+  from->children_.push_back(to_node);
+  UpdateDepths(to_node);
+
+  for (const auto& edge : exit_edges) {
+    InsertReachableEdge(cfg, GetTreeNode(edge.first->id()),
+                        GetTreeNode(edge.second->id()));
+  }
+}
+
+void DominatorTree::InsertEdge(const CFG& cfg, BasicBlock* from,
+                               BasicBlock* to) {
+  if (postdominator_) {
+    InitializeTree(cfg, function_);
+    return;
+  }
+
+  // An edge leaving an unreachable block changes nothing.
+  DominatorTreeNode* from_node = GetTreeNode(from->id());
+  if (from_node == nullptr) return;
+
+  DominatorTreeNode* to_node = GetTreeNode(to->id());
+  if (to_node == nullptr) {
+    InsertUnreachableEdge(cfg, from_node, to);
+  } else {
+    InsertReachableEdge(cfg, from_node, to_node);
+  }
+  df_numbering_valid_ = false;
+}
+
+void DominatorTree::DeleteEdge(const CFG& cfg, BasicBlock* from,
+                               BasicBlock* to) {
+  if (postdominator_) {
+    InitializeTree(cfg, function_);
+    return;
+  }
+
+  DominatorTreeNode* from_node = GetTreeNode(from->id());
+  DominatorTreeNode* to_node = GetTreeNode(to->id());
+  if (from_node == nullptr || to_node == nullptr) return;
+
+  // While |to| stays reachable, only the nodes dominated by the nearest
+  // common dominator of |from| and |to| may change.  There is nothing to do if
+  // |to| dominates |from|.
+  DominatorTreeNode* ncd = NearestCommonDominator(from_node, to_node);
+  if (ncd == nullptr || ncd == to_node) return;
+
+  // If |from| was the immediate dominator of |to|, the nodes below |to| may
+  // have become unreachable.  The blocks they branch to outside of the
+  // subtree of |to| then lose a predecessor as well, so the part of the tree
+  // to build again must also contain those blocks and their other
+  // predecessors.
+  DominatorTreeNode* root = ncd;
+  if (to_node->parent_ == from_node) {
+    std::vector<DominatorTreeNode*> stack = {to_node};
+    std::unordered_set<DominatorTreeNode*> visited = {to_node};
+    while (!stack.empty()) {
+      DominatorTreeNode* node = stack.back();
+      stack.pop_back();
+      for (BasicBlock* succ : Successors(cfg, node->bb_)) {
+        DominatorTreeNode* succ_node = GetTreeNode(succ->id());
+        if (succ_node == nullptr || !visited.insert(succ_node).second) {
+          continue;
+        }
+        // Edges leaving the subtree of |to| go to shallower nodes.
+        if (succ_node->depth_ > to_node->depth_) {
+          stack.push_back(succ_node);
+          continue;
+        }
+        DominatorTreeNode* support = NearestCommonDominator(succ_node, to_node);
+        if (support != succ_node && support->depth_ < root->depth_) {
+          root = support;
+        }
+      }
+    }
+  }
+
+  // Detach the subtree below |root| and build it again.  The nodes that are
+  // not reached again became unreachable.
+  std::vector<DominatorTreeNode*> subtree;
+  std::unordered_set<const BasicBlock*> subtree_blocks;
+  for (auto iter = root->df_begin(); iter != root->df_end(); ++iter) {
+    if (&*iter == root) continue;
+    subtree.push_back(&*iter);
+    subtree_blocks.insert(iter->bb_);
+  }
+  root->children_.clear();
+  for (DominatorTreeNode* node : subtree) {
+    node->parent_ = nullptr;
+    node->children_.clear();
+  }
+
+  BuildRegion(
+      cfg, root->bb_,
+      [&subtree_blocks](const BasicBlock* bb) {
+        return subtree_blocks.count(bb) != 0;
+      },
+      nullptr);
+  for (DominatorTreeNode* node : subtree) {
+    if (node->parent_ == nullptr) EraseNode(node);
+  }
+  UpdateDepths(root);
+  df_numbering_valid_ = false;
+}
+
+void DominatorTree::SplitBlock(BasicBlock* bb, BasicBlock* new_bb) {
+  DominatorTreeNode* node = GetTreeNode(bb->id());
+  if (node == nullptr) return;
+  DominatorTreeNode* new_node = GetOrInsertNode(new_bb);
+
+  if (!postdominator_) {
+    // |new_bb| has the successors of |bb|, so it dominates everything |bb|
+    // dominated.
+    new_node->children_ = std::move(node->children_);
+    node->children_.clear();
+    for (DominatorTreeNode* child : new_node->children_) {
+      child->parent_ = new_node;
+    }
+    new_node->parent_ = node;
+    node->children_.push_back(new_node);
+  } else {
+    // Every path from |bb| to the exit now goes through |new_bb|.
+    DominatorTreeNode* parent = node->parent_;
+    std::replace(parent->children_.begin(), parent->children_.end(), node,
+                 new_node);
+    new_node->parent_ = parent;
+    new_node->children_.push_back(node);
+    node->parent_ = new_node;
+  }
+  UpdateDepths(new_node);
+  df_numbering_valid_ = false;
+}
+
+void DominatorTree::MergeBlocks(BasicBlock* pred, BasicBlock* bb) {
+  DominatorTreeNode* node = GetTreeNode(bb->id());
+  DominatorTreeNode* pred_node = GetTreeNode(pred->id());
+  if (node == nullptr || pred_node == nullptr) return;
+
+  const bool pred_dominates = node->parent_ == pred_node;
+  if (pred_dominates) {
+    // Dominator tree: the merged block dominates what |bb| dominated.
+    auto& siblings = pred_node->children_;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+  } else {
+    // Post-dominator tree: the merged block takes the place of |bb|.
+    assert(pred_node->parent_ == node);
+    auto& children = node->children_;
+    children.erase(std::find(children.begin(), children.end(), pred_node));
+    DominatorTreeNode* parent = node->parent_;
+    std::replace(parent->children_.begin(), parent->children_.end(), node,
+                 pred_node);
+    pred_node->parent_ = parent;
+    node->parent_ = nullptr;
+  }
+  for (DominatorTreeNode* child : node->children_) {
+    child->parent_ = pred_node;
+    pred_node->children_.push_back(child);
+    if (pred_dominates) UpdateDepths(child);
+  }
+  // |pred| moved up to the place of |bb| in a post-dominator tree.
+  if (!pred_dominates) UpdateDepths(pred_node);
+  node->children_.clear();
+  node->parent_ = nullptr;
+  EraseNode(node);
+  df_numbering_valid_ = false;
 }
 
 void DominatorTree::DumpTreeAsDot(std::ostream& out_stream) const {
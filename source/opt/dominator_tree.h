@@ -17,7 +17,9 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <map>
+#include <deque>
+#include <functional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -35,7 +37,8 @@ struct DominatorTreeNode {
         parent_(nullptr),
         children_({}),
         dfs_num_pre_(-1),
-        dfs_num_post_(-1) {}
+        dfs_num_post_(-1),
+        depth_(0) {}
 
   using iterator = std::vector<DominatorTreeNode*>::iterator;
   using const_iterator = std::vector<DominatorTreeNode*>::const_iterator;
@@ -86,14 +89,15 @@ struct DominatorTreeNode {
   // first nodes postorder index.
   int dfs_num_pre_;
   int dfs_num_post_;
+
+  // The depth of the node in the tree, the roots being at depth 0.
+  uint32_t depth_;
 };
 
 // A class representing a tree of BasicBlocks in a given function, where each
 // node is dominated by its parent.
 class DominatorTree {
  public:
-  // Map OpLabel ids to dominator tree nodes
-  using DominatorTreeNodeMap = std::map<uint32_t, DominatorTreeNode>;
   using iterator = TreeDFIterator<DominatorTreeNode>;
   using const_iterator = TreeDFIterator<const DominatorTreeNode>;
   using post_iterator = PostOrderTreeDFIterator<DominatorTreeNode>;
@@ -104,8 +108,10 @@ class DominatorTree {
   using roots_iterator = DominatorTreeNodeList::iterator;
   using roots_const_iterator = DominatorTreeNodeList::const_iterator;
 
-  DominatorTree() : postdominator_(false) {}
-  explicit DominatorTree(bool post) : postdominator_(post) {}
+  DominatorTree()
+      : postdominator_(false), function_(nullptr), df_numbering_valid_(true) {}
+  explicit DominatorTree(bool post)
+      : postdominator_(post), function_(nullptr), df_numbering_valid_(true) {}
 
   // Depth first iterators.
   // Traverse the dominator tree in a depth first pre-order.
@@ -205,6 +211,7 @@ class DominatorTree {
   // Clean up the tree.
   void ClearTree() {
     nodes_.clear();
+    node_index_.clear();
     roots_.clear();
   }
 
@@ -252,21 +259,11 @@ class DominatorTree {
 
   // Returns the DominatorTreeNode associated with the basic block id |id|.
   // If the id |id| is unknown to the dominator tree, it returns null.
-  inline DominatorTreeNode* GetTreeNode(uint32_t id) {
-    DominatorTreeNodeMap::iterator node_iter = nodes_.find(id);
-    if (node_iter == nodes_.end()) {
-      return nullptr;
-    }
-    return &node_iter->second;
-  }
+  inline DominatorTreeNode* GetTreeNode(uint32_t id) { return FindNode(id); }
   // Returns the DominatorTreeNode associated with the basic block id |id|.
   // If the id |id| is unknown to the dominator tree, it returns null.
   inline const DominatorTreeNode* GetTreeNode(uint32_t id) const {
-    DominatorTreeNodeMap::const_iterator node_iter = nodes_.find(id);
-    if (node_iter == nodes_.end()) {
-      return nullptr;
-    }
-    return &node_iter->second;
+    return FindNode(id);
   }
 
   // Adds the basic block |bb| to the tree structure if it doesn't already
@@ -276,6 +273,34 @@ class DominatorTree {
   // Recomputes the DF numbering of the tree.
   void ResetDFNumbering();
 
+  // The following functions update the tree after a change to the control
+  // flow of the function it was built for, instead of building it again.  The
+  // change must already be made to the terminators of the blocks involved,
+  // and |cfg| must know about every block of the function.  The resulting
+  // tree has the same parent for every node as a tree built again, but the
+  // children of a node may be in a different order.
+  //
+  // Edge updates only revisit the blocks whose immediate dominator may have
+  // changed, following the semi-NCA based dynamic algorithm of Georgiadis et
+  // al.  Post-dominator trees are built again on edge updates.  The updates
+  // keep the depths of the nodes that moved up to date, but leave the DF
+  // numbering to be recomputed by the next dominance query.
+
+  // Updates the tree after the edge from |from| to |to| was added.
+  void InsertEdge(const CFG& cfg, BasicBlock* from, BasicBlock* to);
+
+  // Updates the tree after the edge from |from| to |to| was removed.
+  void DeleteEdge(const CFG& cfg, BasicBlock* from, BasicBlock* to);
+
+  // Updates the tree after the instructions at the end of |bb| were moved to
+  // the new block |new_bb|, and |bb| was made to branch to |new_bb|.
+  void SplitBlock(BasicBlock* bb, BasicBlock* new_bb);
+
+  // Updates the tree after the instructions of |bb| were moved to the end of
+  // |pred| and |bb| was removed.  |pred| must have been the only predecessor
+  // of |bb|, and |bb| the only successor of |pred|.
+  void MergeBlocks(BasicBlock* pred, BasicBlock* bb);
+
  private:
   // Wrapper function which gets the list of pairs of each BasicBlocks to its
   // immediately  dominating BasicBlock and stores the result in the edges
@@ -289,14 +314,65 @@ class DominatorTree {
       const Function* f, const BasicBlock* dummy_start_node,
       std::vector<std::pair<BasicBlock*, BasicBlock*>>* edges);
 
+  // Returns the node for the basic block id |id|, or null if there is none.
+  DominatorTreeNode* FindNode(uint32_t id) const;
+
+  // Removes |node| from the tree.  |node| must not have children.
+  void EraseNode(DominatorTreeNode* node);
+
+  // Returns the deepest node dominating both |a| and |b|.
+  static DominatorTreeNode* NearestCommonDominator(DominatorTreeNode* a,
+                                                   DominatorTreeNode* b);
+
+  // Returns the successors of |bb| in the dominator tree's view of |cfg|.
+  std::vector<BasicBlock*> Successors(const CFG& cfg,
+                                      const BasicBlock* bb) const;
+
+  // Updates the tree after adding the edge from |from| to |to| where both
+  // were reachable.
+  void InsertReachableEdge(const CFG& cfg, DominatorTreeNode* from,
+                           DominatorTreeNode* to);
+
+  // Updates the tree after adding the edge from |from| to the unreachable
+  // block |to|, making the blocks only reachable through |to| reachable.
+  void InsertUnreachableEdge(const CFG& cfg, DominatorTreeNode* from,
+                             BasicBlock* to);
+
+  // Sets the depth of |node| and of every node below it from the depth of the
+  // parent of |node|.
+  static void UpdateDepths(DominatorTreeNode* node);
+
+  // Computes the immediate dominators of the blocks reachable from |root|
+  // through blocks for which |in_region| returns true, assuming every path
+  // from the roots to those blocks goes through |root|.  Each of those blocks
+  // gets a node, if it does not have one, which is attached to its immediate
+  // dominator.  The nodes must not have a parent beforehand.  The edges from
+  // the region to blocks outside of it are added to |exit_edges| if it is not
+  // null.
+  void BuildRegion(
+      const CFG& cfg, BasicBlock* root,
+      const std::function<bool(const BasicBlock*)>& in_region,
+      std::vector<std::pair<BasicBlock*, BasicBlock*>>* exit_edges);
+
   // The roots of the tree.
   std::vector<DominatorTreeNode*> roots_;
 
-  // Pairs each basic block id to the tree node containing that basic block.
-  DominatorTreeNodeMap nodes_;
+  // The nodes of the tree.  A deque does not move its elements as it grows,
+  // so nodes can point to each other.  Nodes erased from the tree are left in
+  // place until the tree is cleared.
+  std::deque<DominatorTreeNode> nodes_;
+
+  // Maps each basic block id to the tree node containing that basic block.
+  std::unordered_map<uint32_t, DominatorTreeNode*> node_index_;
 
   // True if this is a post dominator tree.
   bool postdominator_;
+
+  // The function the tree was built for.
+  const Function* function_;
+
+  // False if the tree changed since the DF numbering was last computed.
+  mutable bool df_numbering_valid_;
 };
 
 }  // namespace opt
@@ -158,15 +158,30 @@ Instruction& Instruction::operator=(Instruction&& that) {
   return *this;
 }
 
+void* Instruction::operator new(size_t size) {
+  return utils::Arena::Allocate(nullptr, size);
+}
+
+void* Instruction::operator new(size_t size, IRContext* c) {
+  return utils::Arena::Allocate(c ? c->arena() : nullptr, size);
+}
+
+void Instruction::operator delete(void* ptr) { utils::Arena::Deallocate(ptr); }
+
+void Instruction::operator delete(void* ptr, IRContext*) {
+  utils::Arena::Deallocate(ptr);
+}
+
 Instruction* Instruction::Clone(IRContext* c) const {
-  Instruction* clone = new Instruction(c);
+  // The constructor gives |clone| its own unique id.
+  Instruction* clone = new (c) Instruction(c);
   clone->opcode_ = opcode_;
   clone->has_type_id_ = has_type_id_;
   clone->has_result_id_ = has_result_id_;
-  clone->unique_id_ = c->TakeNextUniqueId();
   clone->operands_ = operands_;
   clone->dbg_line_insts_ = dbg_line_insts_;
   for (auto& i : clone->dbg_line_insts_) {
+    i.context_ = c;
     i.unique_id_ = c->TakeNextUniqueId();
     if (i.IsDebugLineInst()) {
       uint32_t new_id = c->TakeNextId();
@@ -226,6 +226,15 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
 
   ~Instruction() override = default;
 
+  // Instructions created with |new (c) Instruction(c, ...)| are allocated
+  // from the arena of the context |c|, which saves most of the cost of
+  // allocating and freeing them one at a time.  Those created with a plain
+  // |new| use the global allocator.  Either kind may be deleted.
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, IRContext* c);
+  static void operator delete(void* ptr);
+  static void operator delete(void* ptr, IRContext* c);
+
   // Returns a newly allocated instruction that has the same operands, result,
   // and type as |this|.  The new instruction is not linked into any list.
   // It is the responsibility of the caller to make sure that the storage is
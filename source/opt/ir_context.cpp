@@ -121,6 +121,9 @@ void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
   }
 
   if (analyses_to_invalidate & kAnalysisDefUse) {
+    if (def_use_mgr_) {
+      statistics_.def_use_updates += def_use_mgr_->num_updates();
+    }
     def_use_mgr_.reset(nullptr);
   }
   if (analyses_to_invalidate & kAnalysisInstrToBlockMapping) {
@@ -171,14 +174,34 @@ void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
     id_to_graph_.clear();
   }
 
+  const uint32_t invalidated = valid_analyses_ & analyses_to_invalidate;
+  for (uint32_t i = 0; i < kNumAnalyses; ++i) {
+    if (invalidated & (1u << i)) ++statistics_.analysis_invalidations[i];
+  }
   valid_analyses_ = Analysis(valid_analyses_ & ~analyses_to_invalidate);
 }
 
+std::unique_ptr<IRContext> IRContext::Clone() const {
+  auto clone = MakeUnique<IRContext>(GetTargetEnv(), consumer_);
+  clone->module()->CopyFrom(*module());
+  clone->max_id_bound_ = max_id_bound_;
+  clone->preserve_bindings_ = preserve_bindings_;
+  clone->preserve_spec_constants_ = preserve_spec_constants_;
+  return clone;
+}
+
+IRContext::Statistics IRContext::statistics() const {
+  Statistics result = statistics_;
+  if (def_use_mgr_) result.def_use_updates += def_use_mgr_->num_updates();
+  return result;
+}
+
 Instruction* IRContext::KillInst(Instruction* inst) {
   if (!inst) {
     return nullptr;
   }
 
+  ++statistics_.instructions_killed;
   KillNamesAndDecorates(inst);
 
   KillOperandFromDebugInstructions(inst);
@@ -823,7 +846,7 @@ void IRContext::InitializeCombinators() {
     AddCombinatorsForExtension(&extension);
   }
 
-  valid_analyses_ |= kAnalysisCombinators;
+  MarkAnalysisBuilt(kAnalysisCombinators);
 }
 
 void IRContext::RemoveFromIdToName(const Instruction* inst) {
@@ -847,6 +870,7 @@ LoopDescriptor* IRContext::GetLoopDescriptor(const Function* f) {
   std::unordered_map<const Function*, LoopDescriptor>::iterator it =
       loop_descriptors_.find(f);
   if (it == loop_descriptors_.end()) {
+    CountAnalysisBuild(kAnalysisLoopAnalysis);
     return &loop_descriptors_
                 .emplace(std::make_pair(f, LoopDescriptor(this, f)))
                 .first->second;
@@ -1115,6 +1139,7 @@ DominatorAnalysis* IRContext::GetDominatorAnalysis(const Function* f) {
   }
 
   if (dominator_trees_.find(f) == dominator_trees_.end()) {
+    CountAnalysisBuild(kAnalysisDominatorAnalysis);
     dominator_trees_[f].InitializeTree(*cfg(), f);
   }
 
@@ -1128,6 +1153,7 @@ PostDominatorAnalysis* IRContext::GetPostDominatorAnalysis(const Function* f) {
   }
 
   if (post_dominator_trees_.find(f) == post_dominator_trees_.end()) {
+    CountAnalysisBuild(kAnalysisDominatorAnalysis);
     post_dominator_trees_[f].InitializeTree(*cfg(), f);
   }
 
@@ -44,6 +44,7 @@
 #include "source/opt/type_manager.h"
 #include "source/opt/value_number_table.h"
 #include "source/table2.h"
+#include "source/util/arena.h"
 #include "source/util/make_unique.h"
 #include "source/util/string_utils.h"
 
@@ -88,6 +89,28 @@ class IRContext {
     kAnalysisEnd = 1 << 19
   };
 
+  // The number of analyses in |Analysis|.
+  static constexpr uint32_t kNumAnalyses = 19;
+  static_assert(kAnalysisEnd == 1 << kNumAnalyses,
+                "kNumAnalyses does not match the analyses.");
+
+  // Counts of the work done on the module of a context, used to profile
+  // passes.  The counts only grow, so the work done by a pass is the
+  // difference between the counts before and after it.
+  struct Statistics {
+    // The number of times each analysis was built and invalidated, indexed by
+    // the position of its bit in |Analysis|.  Dominator trees and loop
+    // descriptors are built, and counted, one function at a time.
+    size_t analysis_builds[kNumAnalyses] = {};
+    size_t analysis_invalidations[kNumAnalyses] = {};
+    // The number of instructions created and killed.
+    size_t instructions_created = 0;
+    size_t instructions_killed = 0;
+    // The number of times the definition or the uses of an instruction were
+    // recorded or cleared in the def-use manager after it was built.
+    size_t def_use_updates = 0;
+  };
+
   using ProcessFunction = std::function<bool(Function*)>;
 
   friend inline Analysis operator|(Analysis lhs, Analysis rhs);
@@ -100,6 +123,7 @@ class IRContext {
       : syntax_context_(spvContextCreate(env)),
         grammar_(syntax_context_),
         unique_id_(0),
+        arena_(new utils::Arena()),
         module_(new Module()),
         consumer_(std::move(c)),
         def_use_mgr_(nullptr),
@@ -120,6 +144,7 @@ class IRContext {
       : syntax_context_(spvContextCreate(env)),
         grammar_(syntax_context_),
         unique_id_(0),
+        arena_(new utils::Arena()),
         module_(std::move(m)),
         consumer_(std::move(c)),
         def_use_mgr_(nullptr),
@@ -136,7 +161,10 @@ class IRContext {
     InitializeCombinators();
   }
 
-  ~IRContext() { spvContextDestroy(syntax_context_); }
+  ~IRContext() {
+    utils::Arena::Release(arena_);
+    spvContextDestroy(syntax_context_);
+  }
 
   Module* module() const { return module_.get(); }
 
@@ -405,6 +433,13 @@ class IRContext {
   inline void CloneNames(const uint32_t old_id, const uint32_t new_id,
                          const uint32_t max_member_index = UINT32_MAX);
 
+  // Returns a new context whose module is a copy of the module of this
+  // context, with the same ids and the same binary.  No analysis is copied;
+  // they are built on demand in the new context.  This is cheaper than
+  // building a context from the binary of the module, and leaves this context
+  // unchanged.
+  std::unique_ptr<IRContext> Clone() const;
+
   // Sets the message consumer to the given |consumer|. |consumer| which will be
   // invoked every time there is a message to be communicated to the outside.
   void SetMessageConsumer(MessageConsumer c) { consumer_ = std::move(c); }
@@ -511,14 +546,23 @@ class IRContext {
   // Remove the debug scope from any instruction related to |inst|.
   void KillRelatedDebugScopes(Instruction* inst);
 
-  // Returns the next unique id for use by an instruction.
+  // Returns the next unique id for use by an instruction.  Every instruction
+  // created with this context takes one.
   inline uint32_t TakeNextUniqueId() {
     assert(unique_id_ != std::numeric_limits<uint32_t>::max());
+    ++statistics_.instructions_created;
 
     // Skip zero.
     return ++unique_id_;
   }
 
+  // Returns the counts of the work done on the module so far.
+  Statistics statistics() const;
+
+  // Returns the arena used to allocate instructions and basic blocks created
+  // with this context.
+  utils::Arena* arena() const { return arena_; }
+
   // Returns true if |inst| is a combinator in the current context.
   // |combinator_ops_| is built if it has not been already.
   inline bool IsCombinatorInstruction(const Instruction* inst) {
@@ -564,6 +608,23 @@ class IRContext {
     post_dominator_trees_.erase(f);
   }
 
+  // Returns the dominator analysis of |f| if it was already built and is
+  // still valid, or nullptr otherwise.  Unlike GetDominatorAnalysis, this
+  // never builds the analysis.
+  inline DominatorAnalysis* FindDominatorAnalysis(const Function* f) {
+    if (!AreAnalysesValid(kAnalysisDominatorAnalysis)) return nullptr;
+    auto iter = dominator_trees_.find(f);
+    return iter == dominator_trees_.end() ? nullptr : &iter->second;
+  }
+
+  // Returns the postdominator analysis of |f| if it was already built and is
+  // still valid, or nullptr otherwise.
+  inline PostDominatorAnalysis* FindPostDominatorAnalysis(const Function* f) {
+    if (!AreAnalysesValid(kAnalysisDominatorAnalysis)) return nullptr;
+    auto iter = post_dominator_trees_.find(f);
+    return iter == post_dominator_trees_.end() ? nullptr : &iter->second;
+  }
+
   // Return the next available SSA id and increment it.  Returns 0 if the
   // maximum SSA id has been reached.
   inline uint32_t TakeNextId() {
@@ -718,14 +779,17 @@ class IRContext {
  private:
   // Builds the def-use manager from scratch, even if it was already valid.
   void BuildDefUseManager() {
+    if (def_use_mgr_) {
+      statistics_.def_use_updates += def_use_mgr_->num_updates();
+    }
     def_use_mgr_ = MakeUnique<analysis::DefUseManager>(module());
-    valid_analyses_ = valid_analyses_ | kAnalysisDefUse;
+    MarkAnalysisBuilt(kAnalysisDefUse);
   }
 
   // Builds the liveness manager from scratch, even if it was already valid.
   void BuildLivenessManager() {
     liveness_mgr_ = MakeUnique<analysis::LivenessManager>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisLiveness;
+    MarkAnalysisBuilt(kAnalysisLiveness);
   }
 
   // Builds the instruction-block map for the whole module.
@@ -738,7 +802,7 @@ class IRContext {
         });
       }
     }
-    valid_analyses_ = valid_analyses_ | kAnalysisInstrToBlockMapping;
+    MarkAnalysisBuilt(kAnalysisInstrToBlockMapping);
   }
 
   // Builds the instruction-function map for the whole module.
@@ -747,7 +811,7 @@ class IRContext {
     for (auto& fn : *module_) {
       id_to_func_[fn.result_id()] = &fn;
     }
-    valid_analyses_ = valid_analyses_ | kAnalysisIdToFuncMapping;
+    MarkAnalysisBuilt(kAnalysisIdToFuncMapping);
   }
 
   // Builds the instruction-graph map for the whole module.
@@ -756,63 +820,76 @@ class IRContext {
     for (auto& g : module_->graphs()) {
       id_to_graph_[g->DefInst().result_id()] = g.get();
     }
-    valid_analyses_ = valid_analyses_ | kAnalysisIdToGraphMapping;
+    MarkAnalysisBuilt(kAnalysisIdToGraphMapping);
   }
 
   void BuildDecorationManager() {
     decoration_mgr_ = MakeUnique<analysis::DecorationManager>(module());
-    valid_analyses_ = valid_analyses_ | kAnalysisDecorations;
+    MarkAnalysisBuilt(kAnalysisDecorations);
   }
 
   void BuildCFG() {
     cfg_ = MakeUnique<CFG>(module());
-    valid_analyses_ = valid_analyses_ | kAnalysisCFG;
+    MarkAnalysisBuilt(kAnalysisCFG);
   }
 
   void BuildScalarEvolutionAnalysis() {
     scalar_evolution_analysis_ = MakeUnique<ScalarEvolutionAnalysis>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisScalarEvolution;
+    MarkAnalysisBuilt(kAnalysisScalarEvolution);
   }
 
   // Builds the liveness analysis from scratch, even if it was already valid.
   void BuildRegPressureAnalysis() {
     reg_pressure_ = MakeUnique<LivenessAnalysis>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisRegisterPressure;
+    MarkAnalysisBuilt(kAnalysisRegisterPressure);
   }
 
   // Builds the value number table analysis from scratch, even if it was already
   // valid.
   void BuildValueNumberTable() {
     vn_table_ = MakeUnique<ValueNumberTable>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisValueNumberTable;
+    MarkAnalysisBuilt(kAnalysisValueNumberTable);
   }
 
   // Builds the structured CFG analysis from scratch, even if it was already
   // valid.
   void BuildStructuredCFGAnalysis() {
     struct_cfg_analysis_ = MakeUnique<StructuredCFGAnalysis>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisStructuredCFG;
+    MarkAnalysisBuilt(kAnalysisStructuredCFG);
   }
 
   // Builds the constant manager from scratch, even if it was already
   // valid.
   void BuildConstantManager() {
     constant_mgr_ = MakeUnique<analysis::ConstantManager>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisConstants;
+    MarkAnalysisBuilt(kAnalysisConstants);
   }
 
   // Builds the type manager from scratch, even if it was already
   // valid.
   void BuildTypeManager() {
     type_mgr_ = MakeUnique<analysis::TypeManager>(consumer(), this);
-    valid_analyses_ = valid_analyses_ | kAnalysisTypes;
+    MarkAnalysisBuilt(kAnalysisTypes);
   }
 
   // Builds the debug information manager from scratch, even if it was
   // already valid.
   void BuildDebugInfoManager() {
     debug_info_mgr_ = MakeUnique<analysis::DebugInfoManager>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisDebugInfo;
+    MarkAnalysisBuilt(kAnalysisDebugInfo);
+  }
+
+  // Marks |analysis| as valid, now that it was built, and counts the build.
+  void MarkAnalysisBuilt(Analysis analysis) {
+    valid_analyses_ = valid_analyses_ | analysis;
+    CountAnalysisBuild(analysis);
+  }
+
+  // Counts a build of each analysis in |analyses| in |statistics_|.
+  void CountAnalysisBuild(Analysis analyses) {
+    for (uint32_t i = 0; i < kNumAnalyses; ++i) {
+      if (analyses & (1u << i)) ++statistics_.analysis_builds[i];
+    }
   }
 
   // Removes all computed dominator and post-dominator trees. This will force
@@ -883,6 +960,10 @@ class IRContext {
   // Therefore, 0 is not a valid unique id for an instruction.
   uint32_t unique_id_;
 
+  // The arena instructions and basic blocks of this context are allocated
+  // from.  It outlives the context until all of them are destroyed.
+  utils::Arena* arena_;
+
   // The module being processed within this IR context.
   std::unique_ptr<Module> module_;
 
@@ -922,6 +1003,10 @@ class IRContext {
   // A bitset indicating which analyzes are currently valid.
   Analysis valid_analyses_;
 
+  // The work done on |module_| so far.  The def-use updates of the current
+  // def-use manager are only added when it goes away.
+  Statistics statistics_;
+
   // Opcodes of shader capability core executable instructions
   // without side-effect.
   std::unordered_map<uint32_t, std::unordered_set<uint32_t>> combinator_ops_;
@@ -1300,7 +1385,7 @@ void IRContext::BuildIdToNameMap() {
       id_to_name_->insert({debug_inst.GetSingleWordInOperand(0), &debug_inst});
     }
   }
-  valid_analyses_ = valid_analyses_ | kAnalysisNameMap;
+  MarkAnalysisBuilt(kAnalysisNameMap);
 }
 
 IteratorRange<std::multimap<uint32_t, Instruction*>::iterator>
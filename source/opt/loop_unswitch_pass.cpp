@@ -273,21 +273,13 @@ class LoopUnswitch {
         });
     loop_->SetPreHeaderBlock(loop_pre_header);
 
-    // Update the dominator tree.
-    DominatorTreeNode* loop_pre_header_dtn =
-        dom_tree->GetOrInsertNode(loop_pre_header);
-    DominatorTreeNode* if_block_dtn = dom_tree->GetTreeNode(if_block);
-    loop_pre_header_dtn->parent_ = if_block_dtn;
+    // Update the dominator tree.  The new preheader took over the only
+    // successor of |if_block|.
     assert(
-        if_block_dtn->children_.size() == 1 &&
+        dom_tree->GetTreeNode(if_block)->children_.size() == 1 &&
         "A loop preheader should only have the header block as a child in the "
         "dominator tree");
-    loop_pre_header_dtn->children_.push_back(if_block_dtn->children_[0]);
-    if_block_dtn->children_.clear();
-    if_block_dtn->children_.push_back(loop_pre_header_dtn);
-
-    // Make domination queries valid.
-    dom_tree->ResetDFNumbering();
+    dom_tree->SplitBlock(if_block, loop_pre_header);
 
     // Compute an ordered list of basic block to clone: loop blocks + pre-header
     // + merge block.
@@ -25,6 +25,109 @@
 namespace spvtools {
 namespace opt {
 
+namespace {
+
+// Appends the result ids of the NonSemantic DebugLine and DebugNoLine
+// instructions attached to |inst| to |ids|.
+void GetDebugLineIds(const Instruction& inst, std::vector<uint32_t>* ids) {
+  for (const auto& line : inst.dbg_line_insts()) {
+    if (line.IsDebugLineInst()) ids->push_back(line.result_id());
+  }
+}
+
+// Gives the NonSemantic DebugLine and DebugNoLine instructions attached to
+// |inst| the result ids in |ids|, starting at |*next|.
+void SetDebugLineIds(const std::vector<uint32_t>& ids, size_t* next,
+                     Instruction* inst) {
+  for (auto& line : inst->dbg_line_insts()) {
+    if (line.IsDebugLineInst()) line.SetResultId(ids[(*next)++]);
+  }
+}
+
+// Same as above, for all the instructions of |unit|, a function or a graph.
+template <typename T>
+void GetDebugLineIds(const T& unit, std::vector<uint32_t>* ids) {
+  unit.ForEachInst(
+      [ids](const Instruction* inst) { GetDebugLineIds(*inst, ids); },
+      /* run_on_debug_line_insts = */ false,
+      /* run_on_non_semantic_insts = */ true);
+}
+template <typename T>
+void SetDebugLineIds(const std::vector<uint32_t>& ids, size_t* next, T* unit) {
+  unit->ForEachInst(
+      [&ids, next](Instruction* inst) { SetDebugLineIds(ids, next, inst); },
+      /* run_on_debug_line_insts = */ false,
+      /* run_on_non_semantic_insts = */ true);
+}
+
+}  // namespace
+
+void Module::CopyFrom(const Module& other) {
+  IRContext* c = context();
+  // Instruction::Clone gives the debug line instructions attached to a clone
+  // new result ids.  They get their original ids back below, so the ids taken
+  // in between are taken from the bottom of the range, where they cannot run
+  // out.
+  std::vector<uint32_t> debug_line_ids;
+  size_t next_debug_line_id = 0;
+  header_ = other.header_;
+  header_.bound = 1;
+
+  auto copy_list = [c, &debug_line_ids, &next_debug_line_id](
+                       const InstructionList& from, InstructionList* to) {
+    for (const auto& inst : from) {
+      to->push_back(std::unique_ptr<Instruction>(inst.Clone(c)));
+      GetDebugLineIds(inst, &debug_line_ids);
+      SetDebugLineIds(debug_line_ids, &next_debug_line_id, &to->back());
+    }
+  };
+
+  copy_list(other.capabilities_, &capabilities_);
+  copy_list(other.extensions_, &extensions_);
+  copy_list(other.ext_inst_imports_, &ext_inst_imports_);
+  if (other.memory_model_) {
+    memory_model_.reset(other.memory_model_->Clone(c));
+    GetDebugLineIds(*other.memory_model_, &debug_line_ids);
+    SetDebugLineIds(debug_line_ids, &next_debug_line_id, memory_model_.get());
+  }
+  if (other.sampled_image_address_mode_) {
+    sampled_image_address_mode_.reset(
+        other.sampled_image_address_mode_->Clone(c));
+    GetDebugLineIds(*other.sampled_image_address_mode_, &debug_line_ids);
+    SetDebugLineIds(debug_line_ids, &next_debug_line_id,
+                    sampled_image_address_mode_.get());
+  }
+  copy_list(other.entry_points_, &entry_points_);
+  copy_list(other.graph_entry_points_, &graph_entry_points_);
+  copy_list(other.execution_modes_, &execution_modes_);
+  copy_list(other.debugs1_, &debugs1_);
+  copy_list(other.debugs2_, &debugs2_);
+  copy_list(other.debugs3_, &debugs3_);
+  copy_list(other.ext_inst_debuginfo_, &ext_inst_debuginfo_);
+  copy_list(other.annotations_, &annotations_);
+  copy_list(other.types_values_, &types_values_);
+  functions_.reserve(other.functions_.size());
+  for (const auto& function : other.functions_) {
+    functions_.emplace_back(function->Clone(c));
+    GetDebugLineIds(*function, &debug_line_ids);
+    SetDebugLineIds(debug_line_ids, &next_debug_line_id,
+                    functions_.back().get());
+  }
+  graphs_.reserve(other.graphs_.size());
+  for (const auto& graph : other.graphs_) {
+    graphs_.emplace_back(graph->Clone(c));
+    GetDebugLineIds(*graph, &debug_line_ids);
+    SetDebugLineIds(debug_line_ids, &next_debug_line_id, graphs_.back().get());
+  }
+  trailing_dbg_line_info_.reserve(other.trailing_dbg_line_info_.size());
+  for (const auto& inst : other.trailing_dbg_line_info_) {
+    std::unique_ptr<Instruction> line(inst.Clone(c));
+    trailing_dbg_line_info_.push_back(std::move(*line));
+  }
+  contains_debug_info_ = other.contains_debug_info_;
+  header_.bound = other.header_.bound;
+}
+
 uint32_t Module::TakeNextIdBound() {
   if (context()) {
     if (id_bound() >= context()->max_id_bound()) {
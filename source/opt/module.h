@@ -132,9 +132,17 @@ class Module {
   // Appends a function to this module.
   inline void AddFunction(std::unique_ptr<Function> f);
 
+  // Removes all the functions from this module and returns them, in order.
+  inline std::vector<std::unique_ptr<Function>> ReleaseFunctions();
+
   // Appends a graph to this module.
   inline void AddGraph(std::unique_ptr<Graph> g);
 
+  // Copies the header and all the instructions of |other| into this module,
+  // which must be empty.  The copies belong to the context of this module and
+  // keep their result ids, so both modules have the same binary.
+  void CopyFrom(const Module& other);
+
   // Sets |contains_debug_info_| as true.
   inline void SetContainsDebugInfo();
   inline bool ContainsDebugInfo() { return contains_debug_info_; }
@@ -414,6 +422,12 @@ inline void Module::AddFunction(std::unique_ptr<Function> f) {
   functions_.emplace_back(std::move(f));
 }
 
+inline std::vector<std::unique_ptr<Function>> Module::ReleaseFunctions() {
+  std::vector<std::unique_ptr<Function>> functions;
+  functions.swap(functions_);
+  return functions;
+}
+
 inline void Module::AddGraph(std::unique_ptr<Graph> g) {
   graphs_.emplace_back(std::move(g));
 }
@@ -0,0 +1,252 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/module_template.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "source/opcode.h"
+#include "source/opt/build_module.h"
+#include "source/opt/ir_loader.h"
+#include "source/spirv_constant.h"
+#include "source/table.h"
+#include "source/util/make_unique.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// State shared with the binary parser callbacks while function bodies are
+// loaded behind a copy of the template's module-level instructions.
+struct LoadState {
+  IrLoader* loader;
+  // The number of leading instructions the loader must not see, because the
+  // module already holds copies of them.
+  size_t num_to_skip;
+};
+
+spv_result_t SetHeader(void* user_data, spv_endianness_t, uint32_t magic,
+                       uint32_t version, uint32_t generator, uint32_t id_bound,
+                       uint32_t reserved) {
+  reinterpret_cast<LoadState*>(user_data)->loader->SetModuleHeader(
+      magic, version, generator, id_bound, reserved);
+  return SPV_SUCCESS;
+}
+
+spv_result_t AddInstruction(void* user_data,
+                            const spv_parsed_instruction_t* inst) {
+  LoadState* state = reinterpret_cast<LoadState*>(user_data);
+  if (state->num_to_skip > 0) {
+    --state->num_to_skip;
+    return SPV_SUCCESS;
+  }
+  return state->loader->AddInstruction(inst) ? SPV_SUCCESS
+                                             : SPV_ERROR_INVALID_BINARY;
+}
+
+spv::Op OpcodeOf(uint32_t first_word) {
+  return static_cast<spv::Op>(first_word & 0xFFFF);
+}
+
+uint32_t WordCountOf(uint32_t first_word) { return first_word >> 16; }
+
+}  // namespace
+
+std::unique_ptr<ModuleTemplate> ModuleTemplate::Create(
+    spv_target_env env, MessageConsumer consumer, const uint32_t* binary,
+    size_t size) {
+  std::unique_ptr<ModuleTemplate> module_template(new ModuleTemplate(env));
+  module_template->context_ =
+      spvtools::BuildModule(env, consumer, binary, size);
+  if (module_template->context_ == nullptr) return nullptr;
+  module_template->reusable_ = module_template->Initialize(binary, size);
+  return module_template;
+}
+
+bool ModuleTemplate::Initialize(const uint32_t* binary, size_t size) {
+  // Binaries are compared word by word, so only host-endian ones are handled.
+  if (size <= SPV_INDEX_INSTRUCTION || binary[0] != spv::MagicNumber) {
+    return false;
+  }
+  version_ = binary[SPV_INDEX_VERSION_NUMBER];
+
+  std::unordered_set<uint32_t> int_types;
+  size_t num_instructions = 0;
+  size_t offset = SPV_INDEX_INSTRUCTION;
+  while (offset < size) {
+    const spv::Op opcode = OpcodeOf(binary[offset]);
+    const uint32_t word_count = WordCountOf(binary[offset]);
+    if (word_count == 0 || offset + word_count > size) return false;
+    if (opcode == spv::Op::OpFunction) break;
+
+    bool needed_by_parser = false;
+    if (opcode == spv::Op::OpExtInstImport || spvOpcodeGeneratesType(opcode)) {
+      needed_by_parser = true;
+      if (opcode == spv::Op::OpTypeInt) int_types.insert(binary[offset + 1]);
+    } else if ((spvOpcodeIsConstant(opcode) || opcode == spv::Op::OpUndef) &&
+               word_count > 2) {
+      needed_by_parser = int_types.count(binary[offset + 1]) != 0;
+    }
+    if (needed_by_parser) {
+      parse_prefix_.insert(parse_prefix_.end(), binary + offset,
+                           binary + offset + word_count);
+      ++parse_prefix_count_;
+    }
+
+    ++num_instructions;
+    offset += word_count;
+  }
+  // Without functions, there is nothing left to parse for a variant.
+  if (offset == size) return false;
+  preamble_.assign(binary + SPV_INDEX_INSTRUCTION, binary + offset);
+
+  Module* module = context_->module();
+  using InstRange = IteratorRange<Module::inst_iterator>;
+  auto add_section = [this](Section section, InstRange range) {
+    for (const Instruction& inst : range) {
+      instructions_.emplace_back(section, &inst);
+    }
+  };
+  add_section(Section::kCapability, module->capabilities());
+  add_section(Section::kExtension, module->extensions());
+  add_section(Section::kExtInstImport, module->ext_inst_imports());
+  if (const Instruction* memory_model = module->GetMemoryModel()) {
+    instructions_.emplace_back(Section::kMemoryModel, memory_model);
+  }
+  if (const Instruction* mode = module->GetSampledImageAddressMode()) {
+    instructions_.emplace_back(Section::kSampledImageAddressMode, mode);
+  }
+  add_section(Section::kEntryPoint, module->entry_points());
+  add_section(Section::kGraphEntryPoint, module->graph_entry_points());
+  add_section(Section::kExecutionMode, module->execution_modes());
+  add_section(Section::kDebug1, module->debugs1());
+  add_section(Section::kDebug2, module->debugs2());
+  add_section(Section::kDebug3, module->debugs3());
+  add_section(Section::kExtInstDebugInfo, module->ext_inst_debuginfo());
+  add_section(Section::kAnnotation, module->annotations());
+  add_section(Section::kTypeOrValue, module->types_values());
+
+  // Line information is attached to the following instruction by the loader,
+  // and cloning it would assign new ids, so such modules are not reused.
+  // Every module-level instruction must also have been kept by the loader as
+  // is, so that copying them reproduces what parsing would.
+  if (instructions_.size() != num_instructions) return false;
+  for (const auto& entry : instructions_) {
+    if (!entry.second->dbg_line_insts().empty()) return false;
+  }
+
+  // Unique ids follow the order in which instructions were loaded, and are
+  // assigned again in that order when copying.
+  std::sort(instructions_.begin(), instructions_.end(),
+            [](const std::pair<Section, const Instruction*>& a,
+               const std::pair<Section, const Instruction*>& b) {
+              return a.second->unique_id() < b.second->unique_id();
+            });
+  return true;
+}
+
+bool ModuleTemplate::Matches(const uint32_t* binary, size_t size) const {
+  const size_t body_begin = SPV_INDEX_INSTRUCTION + preamble_.size();
+  if (!reusable_ || size <= body_begin) return false;
+  if (binary[0] != spv::MagicNumber ||
+      binary[SPV_INDEX_VERSION_NUMBER] != version_) {
+    return false;
+  }
+  if (OpcodeOf(binary[body_begin]) != spv::Op::OpFunction) return false;
+  return std::equal(preamble_.begin(), preamble_.end(),
+                    binary + SPV_INDEX_INSTRUCTION);
+}
+
+std::unique_ptr<IRContext> ModuleTemplate::BuildModule(
+    MessageConsumer consumer, const uint32_t* binary, size_t size) const {
+  if (!Matches(binary, size)) {
+    return spvtools::BuildModule(env_, consumer, binary, size);
+  }
+
+  auto context = MakeUnique<IRContext>(env_, consumer);
+  Module* module = context->module();
+  for (const auto& entry : instructions_) {
+    std::unique_ptr<Instruction> inst(entry.second->Clone(context.get()));
+    switch (entry.first) {
+      case Section::kCapability:
+        module->AddCapability(std::move(inst));
+        break;
+      case Section::kExtension:
+        module->AddExtension(std::move(inst));
+        break;
+      case Section::kExtInstImport:
+        module->AddExtInstImport(std::move(inst));
+        break;
+      case Section::kMemoryModel:
+        module->SetMemoryModel(std::move(inst));
+        break;
+      case Section::kSampledImageAddressMode:
+        module->SetSampledImageAddressMode(std::move(inst));
+        break;
+      case Section::kEntryPoint:
+        module->AddEntryPoint(std::move(inst));
+        break;
+      case Section::kGraphEntryPoint:
+        module->AddGraphEntryPoint(std::move(inst));
+        break;
+      case Section::kExecutionMode:
+        module->AddExecutionMode(std::move(inst));
+        break;
+      case Section::kDebug1:
+        module->AddDebug1Inst(std::move(inst));
+        break;
+      case Section::kDebug2:
+        module->AddDebug2Inst(std::move(inst));
+        break;
+      case Section::kDebug3:
+        module->AddDebug3Inst(std::move(inst));
+        break;
+      case Section::kExtInstDebugInfo:
+        module->AddExtInstDebugInfo(std::move(inst));
+        break;
+      case Section::kAnnotation:
+        module->AddAnnotationInst(std::move(inst));
+        break;
+      case Section::kTypeOrValue:
+        module->AddGlobalValue(std::move(inst));
+        break;
+    }
+  }
+
+  // The function bodies are parsed behind the module-level instructions the
+  // parser needs to decode them, which the loader then skips.
+  const size_t body_begin = SPV_INDEX_INSTRUCTION + preamble_.size();
+  std::vector<uint32_t> words;
+  words.reserve(SPV_INDEX_INSTRUCTION + parse_prefix_.size() + size -
+                body_begin);
+  words.insert(words.end(), binary, binary + SPV_INDEX_INSTRUCTION);
+  words.insert(words.end(), parse_prefix_.begin(), parse_prefix_.end());
+  words.insert(words.end(), binary + body_begin, binary + size);
+
+  IrLoader loader(consumer, module);
+  LoadState state{&loader, parse_prefix_count_};
+  spv_context parse_context = spvContextCreate(env_);
+  SetContextMessageConsumer(parse_context, consumer);
+  spv_result_t status =
+      spvBinaryParse(parse_context, &state, words.data(), words.size(),
+                     SetHeader, AddInstruction, nullptr);
+  loader.EndModule();
+  spvContextDestroy(parse_context);
+
+  return status == SPV_SUCCESS ? std::move(context) : nullptr;
+}
+
+}  // namespace opt
+}  // namespace spvtools
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_MODULE_TEMPLATE_H_
+#define SOURCE_OPT_MODULE_TEMPLATE_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/opt/instruction.h"
+#include "source/opt/ir_context.h"
+#include "spirv-tools/libspirv.hpp"
+
+namespace spvtools {
+namespace opt {
+
+// A module loaded once, whose module-level instructions (everything preceding
+// the first function) are copied into the modules built from binaries sharing
+// them, instead of being parsed again.  Variants of a shader usually share
+// their capabilities, decorations, types and constants, and only differ in
+// their function bodies.
+//
+// A template is not modified once created, so it may be used by several
+// threads at the same time.
+class ModuleTemplate {
+ public:
+  // Returns a template loaded from |binary|, which holds |size| words, or
+  // nullptr if the binary cannot be loaded.  Errors are sent to |consumer|.
+  static std::unique_ptr<ModuleTemplate> Create(spv_target_env env,
+                                                MessageConsumer consumer,
+                                                const uint32_t* binary,
+                                                size_t size);
+
+  // Returns true if the module-level instructions of |binary| are identical
+  // to those of the template, in which case BuildModule() reuses them.
+  bool Matches(const uint32_t* binary, size_t size) const;
+
+  // Builds a module from |binary| and returns the owning IRContext, like
+  // spvtools::BuildModule.  The module-level instructions are copied from the
+  // template if |binary| matches it, and are parsed otherwise.  Returns
+  // nullptr if errors occur and sends the errors to |consumer|.
+  std::unique_ptr<IRContext> BuildModule(MessageConsumer consumer,
+                                         const uint32_t* binary,
+                                         size_t size) const;
+
+  // Returns the target environment the template was loaded for.
+  spv_target_env target_env() const { return env_; }
+
+ private:
+  // The module section holding a module-level instruction.
+  enum class Section {
+    kCapability,
+    kExtension,
+    kExtInstImport,
+    kMemoryModel,
+    kSampledImageAddressMode,
+    kEntryPoint,
+    kGraphEntryPoint,
+    kExecutionMode,
+    kDebug1,
+    kDebug2,
+    kDebug3,
+    kExtInstDebugInfo,
+    kAnnotation,
+    kTypeOrValue,
+  };
+
+  explicit ModuleTemplate(spv_target_env env) : env_(env) {}
+
+  // Records the module-level instructions of |binary|, which |context_| was
+  // loaded from.  Returns false if they cannot be reused, in which case
+  // BuildModule() always parses the whole binary.
+  bool Initialize(const uint32_t* binary, size_t size);
+
+  spv_target_env env_;
+  std::unique_ptr<IRContext> context_;
+  // Whether the module-level instructions can be reused at all.
+  bool reusable_ = false;
+  // The SPIR-V version in the header of the template.
+  uint32_t version_ = 0;
+  // The words of the module-level instructions, not including the header.
+  std::vector<uint32_t> preamble_;
+  // The module-level instructions the binary parser needs in order to decode
+  // function bodies: extended instruction set imports, types, and values of
+  // integer type, which may select an OpSwitch.
+  std::vector<uint32_t> parse_prefix_;
+  // The number of instructions in |parse_prefix_|.
+  size_t parse_prefix_count_ = 0;
+  // The module-level instructions of |context_| in binary order.
+  std::vector<std::pair<Section, const Instruction*>> instructions_;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_MODULE_TEMPLATE_H_
@@ -26,6 +26,7 @@
 #include "source/opt/build_module.h"
 #include "source/opt/graphics_robust_access_pass.h"
 #include "source/opt/log.h"
+#include "source/opt/module_template.h"
 #include "source/opt/pass_manager.h"
 #include "source/opt/passes.h"
 #include "source/spirv_optimizer_options.h"
@@ -72,6 +73,8 @@ struct Optimizer::Impl {
   spv_target_env target_env;      // Target environment.
   opt::PassManager pass_manager;  // Internal implementation pass manager.
   std::unordered_set<uint32_t> live_locs;  // Arg to debug dead output passes
+  // Module-level instructions shared by the binaries given to Run().
+  std::unique_ptr<opt::ModuleTemplate> module_template;
 };
 
 Optimizer::Optimizer(spv_target_env env) : impl_(new Impl(env)) {
@@ -692,8 +695,15 @@ bool Optimizer::Run(const uint32_t* original_binary,
     return false;
   }
 
-  std::unique_ptr<opt::IRContext> context = BuildModule(
-      impl_->target_env, consumer(), original_binary, original_binary_size);
+  std::unique_ptr<opt::IRContext> context;
+  if (impl_->module_template &&
+      impl_->module_template->target_env() == impl_->target_env) {
+    context = impl_->module_template->BuildModule(
+        consumer(), original_binary, original_binary_size);
+  } else {
+    context = BuildModule(impl_->target_env, consumer(), original_binary,
+                          original_binary_size);
+  }
   if (context == nullptr) return false;
 
   context->set_max_id_bound(opt_options->max_id_bound_);
@@ -754,6 +764,11 @@ Optimizer& Optimizer::SetTimeReport(std::ostream* out) {
   return *this;
 }
 
+Optimizer& Optimizer::SetPassProfile(std::ostream* out, bool chrome_trace) {
+  impl_->pass_manager.SetPassProfile(out, chrome_trace);
+  return *this;
+}
+
 Optimizer& Optimizer::SetValidateAfterAll(bool validate) {
   impl_->pass_manager.SetValidateAfterAll(validate);
   return *this;
@@ -923,6 +938,13 @@ Optimizer::PassToken CreateMergeReturnPass() {
       MakeUnique<opt::MergeReturnPass>());
 }
 
+bool Optimizer::SetModuleTemplate(const uint32_t* base_binary,
+                                  size_t base_binary_size) {
+  impl_->module_template = opt::ModuleTemplate::Create(
+      impl_->target_env, consumer(), base_binary, base_binary_size);
+  return impl_->module_template != nullptr;
+}
+
 std::vector<const char*> Optimizer::GetPassNames() const {
   std::vector<const char*> v;
   for (uint32_t i = 0; i < impl_->pass_manager.NumPasses(); i++) {
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "source/opt/ir_context.h"
+#include "source/opt/pass_profiler.h"
 #include "source/util/timer.h"
 #include "spirv-tools/libspirv.hpp"
 
@@ -51,12 +52,29 @@ Pass::Status PassManager::Run(IRContext* context) {
     }
   };
 
+  std::unique_ptr<PassProfiler> profiler;
+  if (profile_stream_) profiler = MakeUnique<PassProfiler>(context);
+  // Writes the profile of the passes that ran, if one is recorded.
+  auto write_profile = [&profiler, this]() {
+    if (!profiler) return;
+    if (profile_as_chrome_trace_) {
+      profiler->WriteChromeTrace(profile_stream_);
+    } else {
+      profiler->WriteJson(profile_stream_);
+    }
+  };
+
   SPIRV_TIMER_DESCRIPTION(time_report_stream_, /* measure_mem_usage = */ true);
   for (auto& pass : passes_) {
     print_disassembly("; IR before pass ", pass.get());
     SPIRV_TIMER_SCOPED(time_report_stream_, (pass ? pass->name() : ""), true);
+    if (profiler) profiler->BeginPass(pass->name());
     const auto one_status = pass->Run(context);
-    if (one_status == Pass::Status::Failure) return one_status;
+    if (profiler) profiler->EndPass(one_status);
+    if (one_status == Pass::Status::Failure) {
+      write_profile();
+      return one_status;
+    }
     if (one_status == Pass::Status::SuccessWithChange) status = one_status;
 
     if (validate_after_all_) {
@@ -77,6 +95,7 @@ Pass::Status PassManager::Run(IRContext* context) {
     pass.reset(nullptr);
   }
   print_disassembly("; IR after last pass", nullptr);
+  write_profile();
 
   // Set the Id bound in the header in case a pass forgot to do so.
   //
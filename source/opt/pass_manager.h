@@ -44,6 +44,8 @@ class PassManager {
       : consumer_(nullptr),
         print_all_stream_(nullptr),
         time_report_stream_(nullptr),
+        profile_stream_(nullptr),
+        profile_as_chrome_trace_(false),
         target_env_(SPV_ENV_UNIVERSAL_1_2),
         val_options_(nullptr),
         validate_after_all_(false) {}
@@ -92,6 +94,15 @@ class PassManager {
     return *this;
   }
 
+  // Sets the option to profile each pass.  After the passes ran, the profile
+  // is written to |out| as JSON, or as Chrome trace events if
+  // |chrome_trace| is true.  No profile is recorded if |out| is null.
+  PassManager& SetPassProfile(std::ostream* out, bool chrome_trace) {
+    profile_stream_ = out;
+    profile_as_chrome_trace_ = chrome_trace;
+    return *this;
+  }
+
   // Sets the target environment for validation.
   PassManager& SetTargetEnv(spv_target_env env) {
     target_env_ = env;
@@ -121,6 +132,11 @@ class PassManager {
   // The output stream to write the resource utilization of each pass. If this
   // is null, no output is generated.
   std::ostream* time_report_stream_;
+  // The output stream to write the profile of the passes to.  If this is
+  // null, no profile is recorded.
+  std::ostream* profile_stream_;
+  // Whether the profile is written as Chrome trace events instead of JSON.
+  bool profile_as_chrome_trace_;
   // The target environment.
   spv_target_env target_env_;
   // The validator options (used when validating each pass).
@@ -0,0 +1,169 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/pass_profiler.h"
+
+#include <cstdio>
+
+#include "source/util/arena.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// The names of the analyses, indexed by the position of their bit in
+// IRContext::Analysis.
+constexpr const char* kAnalysisNames[] = {
+    "def-use",        "instr-to-block",    "decorations",
+    "combinators",    "cfg",               "dominators",
+    "loops",          "names",             "scalar-evolution",
+    "reg-pressure",   "value-numbers",     "structured-cfg",
+    "builtin-vars",   "id-to-function",    "constants",
+    "types",          "debug-info",        "liveness",
+    "id-to-graph",
+};
+static_assert(sizeof(kAnalysisNames) / sizeof(kAnalysisNames[0]) ==
+                  IRContext::kNumAnalyses,
+              "Every analysis needs a name.");
+
+const char* StatusName(Pass::Status status) {
+  switch (status) {
+    case Pass::Status::Failure:
+      return "failure";
+    case Pass::Status::SuccessWithChange:
+      return "changed";
+    case Pass::Status::SuccessWithoutChange:
+      return "unchanged";
+  }
+  return "unknown";
+}
+
+// Writes |str| to |out| as a JSON string.
+void WriteJsonString(const std::string& str, std::ostream* out) {
+  *out << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') *out << '\\';
+    *out << c;
+  }
+  *out << '"';
+}
+
+// Writes the time |us| in microseconds to |out|, with a fixed number of
+// decimals.
+void WriteMicroseconds(double us, std::ostream* out) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.3f", us);
+  *out << buffer;
+}
+
+// Writes the non-zero |counts| of the analyses to |out| as a JSON object.
+void WriteAnalysisCounts(const size_t* counts, std::ostream* out) {
+  *out << '{';
+  const char* separator = "";
+  for (uint32_t i = 0; i < IRContext::kNumAnalyses; ++i) {
+    if (counts[i] == 0) continue;
+    *out << separator << '"' << kAnalysisNames[i] << "\": " << counts[i];
+    separator = ", ";
+  }
+  *out << '}';
+}
+
+}  // namespace
+
+PassProfiler::PassProfiler(IRContext* context)
+    : context_(context), origin_(Clock::now()) {}
+
+void PassProfiler::BeginPass(const char* name) {
+  records_.push_back({name, Pass::Status::SuccessWithoutChange, 0, 0, {}, 0});
+  statistics_at_start_ = context_->statistics();
+  bytes_at_start_ = utils::Arena::BytesAllocatedOnThisThread();
+  pass_start_ = Clock::now();
+}
+
+void PassProfiler::EndPass(Pass::Status status) {
+  const Clock::time_point end = Clock::now();
+  const IRContext::Statistics statistics = context_->statistics();
+
+  Record& record = records_.back();
+  record.status = status;
+  record.start_us =
+      std::chrono::duration<double, std::micro>(pass_start_ - origin_).count();
+  record.duration_us =
+      std::chrono::duration<double, std::micro>(end - pass_start_).count();
+  for (uint32_t i = 0; i < IRContext::kNumAnalyses; ++i) {
+    record.work.analysis_builds[i] = statistics.analysis_builds[i] -
+                                     statistics_at_start_.analysis_builds[i];
+    record.work.analysis_invalidations[i] =
+        statistics.analysis_invalidations[i] -
+        statistics_at_start_.analysis_invalidations[i];
+  }
+  record.work.instructions_created = statistics.instructions_created -
+                                     statistics_at_start_.instructions_created;
+  record.work.instructions_killed = statistics.instructions_killed -
+                                    statistics_at_start_.instructions_killed;
+  record.work.def_use_updates =
+      statistics.def_use_updates - statistics_at_start_.def_use_updates;
+  record.bytes_allocated =
+      utils::Arena::BytesAllocatedOnThisThread() - bytes_at_start_;
+}
+
+void PassProfiler::WriteCounts(const Record& record, std::ostream* out) {
+  *out << "\"status\": \"" << StatusName(record.status) << "\""
+       << ", \"instructions_created\": " << record.work.instructions_created
+       << ", \"instructions_killed\": " << record.work.instructions_killed
+       << ", \"def_use_updates\": " << record.work.def_use_updates
+       << ", \"bytes_allocated\": " << record.bytes_allocated
+       << ", \"analysis_builds\": ";
+  WriteAnalysisCounts(record.work.analysis_builds, out);
+  *out << ", \"analysis_invalidations\": ";
+  WriteAnalysisCounts(record.work.analysis_invalidations, out);
+}
+
+void PassProfiler::WriteJson(std::ostream* out) const {
+  *out << "{\n  \"passes\": [";
+  const char* separator = "\n";
+  for (const Record& record : records_) {
+    *out << separator << "    {\"name\": ";
+    WriteJsonString(record.name, out);
+    *out << ", \"time_us\": ";
+    WriteMicroseconds(record.duration_us, out);
+    *out << ", ";
+    WriteCounts(record, out);
+    *out << '}';
+    separator = ",\n";
+  }
+  *out << "\n  ]\n}\n";
+}
+
+void PassProfiler::WriteChromeTrace(std::ostream* out) const {
+  *out << "{\n  \"traceEvents\": [";
+  const char* separator = "\n";
+  for (const Record& record : records_) {
+    *out << separator << "    {\"name\": ";
+    WriteJsonString(record.name, out);
+    *out << ", \"cat\": \"pass\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+         << ", \"ts\": ";
+    WriteMicroseconds(record.start_us, out);
+    *out << ", \"dur\": ";
+    WriteMicroseconds(record.duration_us, out);
+    *out << ", \"args\": {";
+    WriteCounts(record, out);
+    *out << "}}";
+    separator = ",\n";
+  }
+  *out << "\n  ],\n  \"displayTimeUnit\": \"ms\"\n}\n";
+}
+
+}  // namespace opt
+}  // namespace spvtools
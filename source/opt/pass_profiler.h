@@ -0,0 +1,83 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_PASS_PROFILER_H_
+#define SOURCE_OPT_PASS_PROFILER_H_
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "source/opt/ir_context.h"
+#include "source/opt/pass.h"
+
+namespace spvtools {
+namespace opt {
+
+// Records, for each pass run on a context, the time it took and the work it
+// did: the analyses it built and invalidated, the instructions it created and
+// killed, the bytes it allocated for instructions and basic blocks, and the
+// def-use updates it made.  The records are written out as JSON, or as Chrome
+// trace events that can be loaded in chrome://tracing or Perfetto.
+class PassProfiler {
+ public:
+  explicit PassProfiler(IRContext* context);
+
+  // Starts recording a run of the pass named |name|.
+  void BeginPass(const char* name);
+
+  // Finishes recording the current pass, which returned |status|.
+  void EndPass(Pass::Status status);
+
+  // Writes the records as a JSON object with a "passes" array to |out|.
+  void WriteJson(std::ostream* out) const;
+
+  // Writes the records as Chrome trace events to |out|.  The counts are the
+  // arguments of the events.
+  void WriteChromeTrace(std::ostream* out) const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Record {
+    std::string name;
+    Pass::Status status;
+    // Offset of the start of the pass from the creation of the profiler, and
+    // duration of the pass, in microseconds.
+    double start_us;
+    double duration_us;
+    // The difference between the counts after and before the pass.
+    IRContext::Statistics work;
+    size_t bytes_allocated;
+  };
+
+  // Writes the fields of |record| other than its name and times to |out|, as
+  // the members of a JSON object.
+  static void WriteCounts(const Record& record, std::ostream* out);
+
+  IRContext* context_;
+  Clock::time_point origin_;
+  std::vector<Record> records_;
+
+  // The state when the current pass started.
+  Clock::time_point pass_start_;
+  IRContext::Statistics statistics_at_start_;
+  size_t bytes_at_start_ = 0;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_PASS_PROFILER_H_
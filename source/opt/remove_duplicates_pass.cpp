@@ -15,6 +15,7 @@
 #include "source/opt/remove_duplicates_pass.h"
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -23,9 +24,54 @@
 #include "source/opcode.h"
 #include "source/opt/decoration_manager.h"
 #include "source/opt/ir_context.h"
+#include "source/opt/type_manager.h"
+#include "source/util/hash_combine.h"
+#include "source/util/make_unique.h"
 
 namespace spvtools {
 namespace opt {
+namespace {
+
+// Hashes the operands compared by DecorationManager::AreDecorationsTheSame(),
+// so that identical decorations have the same hash.
+struct HashDecoration {
+  size_t operator()(const Instruction* inst) const {
+    size_t hash = utils::hash_combine(0, uint32_t(inst->opcode()));
+    for (uint32_t i = 0; i < inst->NumInOperands(); ++i) {
+      for (uint32_t word : inst->GetInOperand(i).words) {
+        hash = utils::hash_combine(hash, word);
+      }
+    }
+    return hash;
+  }
+};
+
+// Compares decorations with DecorationManager::AreDecorationsTheSame().  This
+// is only an equivalence relation for the opcodes accepted by
+// IsComparableDecoration().
+struct CompareDecorations {
+  bool operator()(const Instruction* lhs, const Instruction* rhs) const {
+    return decoration_manager->AreDecorationsTheSame(lhs, rhs, false);
+  }
+  const analysis::DecorationManager* decoration_manager;
+};
+
+// Returns true if |inst| is a decoration that
+// DecorationManager::AreDecorationsTheSame() can compare.  Decoration groups
+// and group decorations never compare equal, not even to themselves.
+bool IsComparableDecoration(const Instruction* inst) {
+  switch (inst->opcode()) {
+    case spv::Op::OpDecorate:
+    case spv::Op::OpMemberDecorate:
+    case spv::Op::OpDecorateId:
+    case spv::Op::OpDecorateStringGOOGLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
 
 Pass::Status RemoveDuplicatesPass::Process() {
   bool modified = RemoveDuplicateCapabilities();
@@ -141,8 +187,15 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 
   analysis::TypeManager type_manager(context()->consumer(), context());
 
-  std::vector<Instruction*> visited_types;
-  std::vector<analysis::ForwardPointer> visited_forward_pointers;
+  // The types and forward pointers kept so far, hashed structurally, so that
+  // each type is compared with the ones that have the same hash only.
+  std::unordered_map<const analysis::Type*, spv::Id, analysis::HashTypePointer,
+                     analysis::CompareTypePointers>
+      visited_types;
+  std::vector<std::unique_ptr<analysis::ForwardPointer>> forward_pointers;
+  std::unordered_set<const analysis::Type*, analysis::HashTypePointer,
+                     analysis::CompareTypePointers>
+      visited_forward_pointers;
   std::vector<Instruction*> to_delete;
   for (auto* i = &*context()->types_values_begin(); i; i = i->NextNode()) {
     const bool is_i_forward_pointer =
@@ -155,47 +208,28 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 
     if (!is_i_forward_pointer) {
       // Is the current type equal to one of the types we have already visited?
-      spv::Id id_to_keep = 0u;
-      analysis::Type* i_type = type_manager.GetType(i->result_id());
+      const analysis::Type* i_type = type_manager.GetType(i->result_id());
       assert(i_type);
-      // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-      // ResultIdTrie from unify_const_pass.cpp for this.
-      for (auto j : visited_types) {
-        analysis::Type* j_type = type_manager.GetType(j->result_id());
-        assert(j_type);
-        if (*i_type == *j_type) {
-          id_to_keep = j->result_id();
-          break;
-        }
-      }
+      const auto visited = visited_types.emplace(i_type, i->result_id());
 
-      if (id_to_keep == 0u) {
-        // This is a never seen before type, keep it around.
-        visited_types.emplace_back(i);
-      } else {
+      if (!visited.second) {
         // The same type has already been seen before, remove this one.
+        const spv::Id id_to_keep = visited.first->second;
         context()->KillNamesAndDecorates(i->result_id());
         context()->ReplaceAllUsesWith(i->result_id(), id_to_keep);
         modified = true;
         to_delete.emplace_back(i);
       }
     } else {
-      analysis::ForwardPointer i_type(
+      auto i_type = MakeUnique<analysis::ForwardPointer>(
           i->GetSingleWordInOperand(0u),
           (spv::StorageClass)i->GetSingleWordInOperand(1u));
-      i_type.SetTargetPointer(
-          type_manager.GetType(i_type.target_id())->AsPointer());
+      i_type->SetTargetPointer(
+          type_manager.GetType(i_type->target_id())->AsPointer());
 
-      // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-      // ResultIdTrie from unify_const_pass.cpp for this.
-      const bool found_a_match =
-          std::find(std::begin(visited_forward_pointers),
-                    std::end(visited_forward_pointers),
-                    i_type) != std::end(visited_forward_pointers);
-
-      if (!found_a_match) {
+      if (visited_forward_pointers.insert(i_type.get()).second) {
         // This is a never seen before type, keep it around.
-        visited_forward_pointers.emplace_back(i_type);
+        forward_pointers.push_back(std::move(i_type));
       } else {
         // The same type has already been seen before, remove this one.
         modified = true;
@@ -223,25 +257,21 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 bool RemoveDuplicatesPass::RemoveDuplicateDecorations() const {
   bool modified = false;
 
-  std::vector<const Instruction*> visited_decorations;
-
   analysis::DecorationManager decoration_manager(context()->module());
+  std::unordered_set<const Instruction*, HashDecoration, CompareDecorations>
+      visited_decorations(0, HashDecoration(),
+                          CompareDecorations{&decoration_manager});
   for (auto* i = &*context()->annotation_begin(); i;) {
-    // Is the current decoration equal to one of the decorations we have
-    // already visited?
-    bool already_visited = false;
-    // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-    // ResultIdTrie from unify_const_pass.cpp for this.
-    for (const Instruction* j : visited_decorations) {
-      if (decoration_manager.AreDecorationsTheSame(&*i, j, false)) {
-        already_visited = true;
-        break;
-      }
+    if (!IsComparableDecoration(i)) {
+      // Keep decoration groups and group decorations.
+      i = i->NextNode();
+      continue;
     }
 
-    if (!already_visited) {
+    // Is the current decoration equal to one of the decorations we have
+    // already visited?
+    if (visited_decorations.insert(i).second) {
       // This is a never seen before decoration, keep it around.
-      visited_decorations.emplace_back(&*i);
       i = i->NextNode();
     } else {
       // The same decoration has already been seen before, remove this one.
@@ -65,6 +65,16 @@ bool CompareTwoVectors(const U32VecVec a, const U32VecVec b) {
   return true;
 }
 
+// Combines the hashes of |decorations| into |hash|.  The order of the
+// decorations does not matter, as in CompareTwoVectors().
+size_t HashDecorations(size_t hash, const U32VecVec& decorations) {
+  size_t decorations_hash = 0;
+  for (const auto& d : decorations) {
+    decorations_hash += hash_combine(0, d);
+  }
+  return hash_combine(hash, decorations_hash);
+}
+
 }  // namespace
 
 std::string Type::GetDecorationStr() const {
@@ -214,9 +224,7 @@ size_t Type::ComputeHashValue(size_t hash, SeenTypes* seen) const {
   seen->push_back(this);
 
   hash = hash_combine(hash, uint32_t(kind_));
-  for (const auto& d : decorations_) {
-    hash = hash_combine(hash, d);
-  }
+  hash = HashDecorations(hash, decorations_);
 
   switch (kind_) {
 #define DeclareKindCase(type)                             \
@@ -681,7 +689,7 @@ size_t Struct::ComputeExtraStateHash(size_t hash, SeenTypes* seen) const {
     hash = t->ComputeHashValue(hash, seen);
   }
   for (const auto& pair : element_decorations_) {
-    hash = hash_combine(hash, pair.first, pair.second);
+    hash = HashDecorations(hash_combine(hash, pair.first), pair.second);
   }
   return hash;
 }
@@ -824,11 +832,11 @@ std::string ForwardPointer::str() const {
   return oss.str();
 }
 
-size_t ForwardPointer::ComputeExtraStateHash(size_t hash,
-                                             SeenTypes* seen) const {
-  hash = hash_combine(hash, target_id_, uint32_t(storage_class_));
-  if (pointer_) hash = pointer_->ComputeHashValue(hash, seen);
-  return hash;
+size_t ForwardPointer::ComputeExtraStateHash(size_t hash, SeenTypes*) const {
+  // Only the storage class is hashed: IsSameImpl() compares the pointer types
+  // when both are known, and the target ids otherwise, so neither can be
+  // hashed consistently.
+  return hash_combine(hash, uint32_t(storage_class_));
 }
 
 CooperativeMatrixNV::CooperativeMatrixNV(const Type* type, const uint32_t scope,
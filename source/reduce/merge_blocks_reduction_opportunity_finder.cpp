@@ -23,20 +23,23 @@ std::string MergeBlocksReductionOpportunityFinder::GetName() const {
   return "MergeBlocksReductionOpportunityFinder";
 }
 
+bool MergeBlocksReductionOpportunityFinder::FindsOpportunitiesPerFunction()
+    const {
+  return true;
+}
+
 std::vector<std::unique_ptr<ReductionOpportunity>>
-MergeBlocksReductionOpportunityFinder::GetAvailableOpportunities(
-    opt::IRContext* context, uint32_t target_function) const {
+MergeBlocksReductionOpportunityFinder::GetAvailableOpportunitiesInFunction(
+    opt::IRContext* context, opt::Function* function) const {
   std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
-  // Consider every block in every function.
-  for (auto* function : GetTargetFunctions(context, target_function)) {
-    for (auto& block : *function) {
-      // See whether it is possible to merge this block with its successor.
-      if (opt::blockmergeutil::CanMergeWithSuccessor(context, &block)) {
-        // It is, so record an opportunity to do this.
-        result.push_back(spvtools::MakeUnique<MergeBlocksReductionOpportunity>(
-            context, function, &block));
-      }
+  // Consider every block in the function.
+  for (auto& block : *function) {
+    // See whether it is possible to merge this block with its successor.
+    if (opt::blockmergeutil::CanMergeWithSuccessor(context, &block)) {
+      // It is, so record an opportunity to do this.
+      result.push_back(spvtools::MakeUnique<MergeBlocksReductionOpportunity>(
+          context, function, &block));
     }
   }
   return result;
@@ -30,8 +30,11 @@ class MergeBlocksReductionOpportunityFinder
 
   std::string GetName() const final;
 
-  std::vector<std::unique_ptr<ReductionOpportunity>> GetAvailableOpportunities(
-      opt::IRContext* context, uint32_t target_function) const final;
+  bool FindsOpportunitiesPerFunction() const final;
+
+  std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                      opt::Function* function) const final;
 
  private:
 };
@@ -20,13 +20,20 @@
 namespace spvtools {
 namespace reduce {
 
+bool OperandToDominatingIdReductionOpportunityFinder::
+    FindsOpportunitiesPerFunction() const {
+  return true;
+}
+
 std::vector<std::unique_ptr<ReductionOpportunity>>
-OperandToDominatingIdReductionOpportunityFinder::GetAvailableOpportunities(
-    opt::IRContext* context, uint32_t target_function) const {
+OperandToDominatingIdReductionOpportunityFinder::
+    GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                        opt::Function* function) const {
   std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
-  // Go through every instruction in every block, considering it as a potential
-  // dominator of other instructions.  We choose this order for two reasons:
+  // Go through every instruction in every block of the function, considering it
+  // as a potential dominator of other instructions.  We choose this order for
+  // two reasons:
   //
   // (1) it is profitable for multiple opportunities to replace the same id x by
   // different dominating ids y and z to be discontiguous, as they are
@@ -38,16 +45,14 @@ OperandToDominatingIdReductionOpportunityFinder::GetAvailableOpportunities(
   // to prioritise replacing e with its smallest sub-expressions; generalising
   // this idea to dominating ids this roughly corresponds to more distant
   // dominators.
-  for (auto* function : GetTargetFunctions(context, target_function)) {
-    for (auto dominating_block = function->begin();
-         dominating_block != function->end(); ++dominating_block) {
-      for (auto& dominating_inst : *dominating_block) {
-        if (dominating_inst.HasResultId() && dominating_inst.type_id()) {
-          // Consider replacing any operand with matching type in a dominated
-          // instruction with the id generated by this instruction.
-          GetOpportunitiesForDominatingInst(
-              &result, &dominating_inst, dominating_block, function, context);
-        }
+  for (auto dominating_block = function->begin();
+       dominating_block != function->end(); ++dominating_block) {
+    for (auto& dominating_inst : *dominating_block) {
+      if (dominating_inst.HasResultId() && dominating_inst.type_id()) {
+        // Consider replacing any operand with matching type in a dominated
+        // instruction with the id generated by this instruction.
+        GetOpportunitiesForDominatingInst(&result, &dominating_inst,
+                                          dominating_block, function, context);
       }
     }
   }
@@ -20,62 +20,64 @@
 namespace spvtools {
 namespace reduce {
 
+bool OperandToUndefReductionOpportunityFinder::FindsOpportunitiesPerFunction()
+    const {
+  return true;
+}
+
 std::vector<std::unique_ptr<ReductionOpportunity>>
-OperandToUndefReductionOpportunityFinder::GetAvailableOpportunities(
-    opt::IRContext* context, uint32_t target_function) const {
+OperandToUndefReductionOpportunityFinder::GetAvailableOpportunitiesInFunction(
+    opt::IRContext* context, opt::Function* function) const {
   std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
-  for (auto* function : GetTargetFunctions(context, target_function)) {
-    for (auto& block : *function) {
-      for (auto& inst : block) {
-        // Skip instructions that result in a pointer type.
-        auto type_id = inst.type_id();
-        if (type_id) {
-          auto type_id_def = context->get_def_use_mgr()->GetDef(type_id);
-          if (type_id_def->opcode() == spv::Op::OpTypePointer) {
-            continue;
-          }
+  for (auto& block : *function) {
+    for (auto& inst : block) {
+      // Skip instructions that result in a pointer type.
+      auto type_id = inst.type_id();
+      if (type_id) {
+        auto type_id_def = context->get_def_use_mgr()->GetDef(type_id);
+        if (type_id_def->opcode() == spv::Op::OpTypePointer) {
+          continue;
         }
+      }
 
-        // We iterate through the operands using an explicit index (rather
-        // than using a lambda) so that we use said index in the construction
-        // of a ChangeOperandToUndefReductionOpportunity
-        for (uint32_t index = 0; index < inst.NumOperands(); index++) {
-          const auto& operand = inst.GetOperand(index);
-
-          if (spvIsInIdType(operand.type)) {
-            const auto operand_id = operand.words[0];
-            auto operand_id_def =
-                context->get_def_use_mgr()->GetDef(operand_id);
+      // We iterate through the operands using an explicit index (rather
+      // than using a lambda) so that we use said index in the construction
+      // of a ChangeOperandToUndefReductionOpportunity
+      for (uint32_t index = 0; index < inst.NumOperands(); index++) {
+        const auto& operand = inst.GetOperand(index);
 
-            // Skip constant and undef operands.
-            // We always want the reducer to make the module "smaller", which
-            // ensures termination.
-            // Therefore, we assume: id > undef id > constant id.
-            if (spvOpcodeIsConstantOrUndef(operand_id_def->opcode())) {
-              continue;
-            }
+        if (spvIsInIdType(operand.type)) {
+          const auto operand_id = operand.words[0];
+          auto operand_id_def = context->get_def_use_mgr()->GetDef(operand_id);
 
-            // Don't replace function operands with undef.
-            if (operand_id_def->opcode() == spv::Op::OpFunction) {
-              continue;
-            }
+          // Skip constant and undef operands.
+          // We always want the reducer to make the module "smaller", which
+          // ensures termination.
+          // Therefore, we assume: id > undef id > constant id.
+          if (spvOpcodeIsConstantOrUndef(operand_id_def->opcode())) {
+            continue;
+          }
 
-            // Only consider operands that have a type.
-            auto operand_type_id = operand_id_def->type_id();
-            if (operand_type_id) {
-              auto operand_type_id_def =
-                  context->get_def_use_mgr()->GetDef(operand_type_id);
+          // Don't replace function operands with undef.
+          if (operand_id_def->opcode() == spv::Op::OpFunction) {
+            continue;
+          }
 
-              // Skip pointer operands.
-              if (operand_type_id_def->opcode() == spv::Op::OpTypePointer) {
-                continue;
-              }
+          // Only consider operands that have a type.
+          auto operand_type_id = operand_id_def->type_id();
+          if (operand_type_id) {
+            auto operand_type_id_def =
+                context->get_def_use_mgr()->GetDef(operand_type_id);
 
-              result.push_back(
-                  MakeUnique<ChangeOperandToUndefReductionOpportunity>(
-                      context, &inst, index));
+            // Skip pointer operands.
+            if (operand_type_id_def->opcode() == spv::Op::OpTypePointer) {
+              continue;
             }
+
+            result.push_back(
+                MakeUnique<ChangeOperandToUndefReductionOpportunity>(
+                    context, &inst, index));
           }
         }
       }
@@ -31,8 +31,11 @@ class OperandToUndefReductionOpportunityFinder
 
   std::string GetName() const final;
 
-  std::vector<std::unique_ptr<ReductionOpportunity>> GetAvailableOpportunities(
-      opt::IRContext* context, uint32_t target_function) const final;
+  bool FindsOpportunitiesPerFunction() const final;
+
+  std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                      opt::Function* function) const final;
 
  private:
 };
@@ -14,9 +14,13 @@
 
 #include "source/reduce/reducer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <sstream>
+#include <thread>
 
+#include "source/opt/build_module.h"
 #include "source/reduce/conditional_branch_to_simple_conditional_branch_opportunity_finder.h"
 #include "source/reduce/merge_blocks_reduction_opportunity_finder.h"
 #include "source/reduce/operand_to_const_reduction_opportunity_finder.h"
@@ -143,13 +147,13 @@ void Reducer::AddDefaultReductionPasses() {
 void Reducer::AddReductionPass(
     std::unique_ptr<ReductionOpportunityFinder> finder) {
   passes_.push_back(
-      spvtools::MakeUnique<ReductionPass>(target_env_, std::move(finder)));
+      spvtools::MakeUnique<ReductionPass>(std::move(finder)));
 }
 
 void Reducer::AddCleanupReductionPass(
     std::unique_ptr<ReductionOpportunityFinder> finder) {
   cleanup_passes_.push_back(
-      spvtools::MakeUnique<ReductionPass>(target_env_, std::move(finder)));
+      spvtools::MakeUnique<ReductionPass>(std::move(finder)));
 }
 
 bool Reducer::ReachedStepLimit(uint32_t current_step,
@@ -162,6 +166,13 @@ Reducer::ReductionResultStatus Reducer::RunPasses(
     spv_const_reducer_options options, spv_validator_options validator_options,
     const SpirvTools& tools, std::vector<uint32_t>* current_binary,
     uint32_t* const reductions_applied) {
+  // The module of |current_binary|.  Each reduction attempt works on a copy of
+  // it, so it only needs to be parsed again when a reduction step succeeds.
+  std::unique_ptr<opt::IRContext> current_context =
+      BuildModule(target_env_, consumer_, current_binary->data(),
+                  current_binary->size());
+  assert(current_context);
+
   // Determines whether, on completing one round of reduction passes, it is
   // worthwhile trying a further round.
   bool another_round_worthwhile = true;
@@ -186,9 +197,16 @@ Reducer::ReductionResultStatus Reducer::RunPasses(
       consumer_(SPV_MSG_INFO, nullptr, {},
                 ("Trying pass " + pass->GetName() + ".").c_str());
       do {
-        auto maybe_result =
-            pass->TryApplyReduction(*current_binary, options->target_function);
-        if (maybe_result.empty()) {
+        // With several threads, the next few chunks of the pass are tried
+        // speculatively, each as if all the chunks before it had turned out
+        // not to be interesting.  The steps are then considered in order, so
+        // the reduction follows the same path as a serial one.
+        const uint32_t max_candidates = std::max(
+            1u, std::min(options->num_threads,
+                         options->step_limit - *reductions_applied));
+        auto candidates = pass->TryApplyReductions(
+            *current_context, options->target_function, max_candidates);
+        if (candidates.empty()) {
           // For this round, the pass has no more opportunities (chunks) to
           // apply, so move on to the next pass.
           consumer_(
@@ -197,37 +215,49 @@ Reducer::ReductionResultStatus Reducer::RunPasses(
                   .c_str());
           break;
         }
-        bool interesting = false;
-        std::stringstream stringstream;
-        (*reductions_applied)++;
-        stringstream << "Pass " << pass->GetName() << " made reduction step "
-                     << *reductions_applied << ".";
-        consumer_(SPV_MSG_INFO, nullptr, {}, (stringstream.str().c_str()));
-        if (!tools.Validate(&maybe_result[0], maybe_result.size(),
-                            validator_options)) {
-          // The reduction step went wrong and an invalid binary was produced.
-          // By design, this shouldn't happen; this is a safeguard to stop an
-          // invalid binary from being regarded as interesting.
-          consumer_(SPV_MSG_INFO, nullptr, {},
-                    "Reduction step produced an invalid binary.");
-          if (options->fail_on_validation_error) {
-            // In this mode, we fail, so we update the current binary so it is
-            // output for debugging.
+        const std::vector<CandidateStatus> statuses =
+            EvaluateCandidates(candidates, options, validator_options, tools,
+                               *reductions_applied);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+          auto& maybe_result = candidates[i];
+          bool interesting = false;
+          std::stringstream stringstream;
+          (*reductions_applied)++;
+          stringstream << "Pass " << pass->GetName() << " made reduction step "
+                       << *reductions_applied << ".";
+          consumer_(SPV_MSG_INFO, nullptr, {}, (stringstream.str().c_str()));
+          assert(statuses[i] != CandidateStatus::kNotEvaluated);
+          if (statuses[i] == CandidateStatus::kInvalid) {
+            // The reduction step went wrong and an invalid binary was
+            // produced.  By design, this shouldn't happen; this is a safeguard
+            // to stop an invalid binary from being regarded as interesting.
+            consumer_(SPV_MSG_INFO, nullptr, {},
+                      "Reduction step produced an invalid binary.");
+            if (options->fail_on_validation_error) {
+              // In this mode, we fail, so we update the current binary so it
+              // is output for debugging.
+              *current_binary = std::move(maybe_result);
+              return Reducer::ReductionResultStatus::kStateInvalid;
+            }
+          } else if (statuses[i] == CandidateStatus::kInteresting) {
+            // Success!  The binary produced by this reduction step is
+            // interesting, so make it the binary of interest henceforth, and
+            // note that it's worth doing another round of reduction passes.
+            consumer_(SPV_MSG_INFO, nullptr, {}, "Reduction step succeeded.");
             *current_binary = std::move(maybe_result);
-            return Reducer::ReductionResultStatus::kStateInvalid;
+            current_context =
+                BuildModule(target_env_, consumer_, current_binary->data(),
+                            current_binary->size());
+            assert(current_context);
+            interesting = true;
+            another_round_worthwhile = true;
           }
-        } else if (interestingness_function_(maybe_result,
-                                             *reductions_applied)) {
-          // Success!  The binary produced by this reduction step is
-          // interesting, so make it the binary of interest henceforth, and
-          // note that it's worth doing another round of reduction passes.
-          consumer_(SPV_MSG_INFO, nullptr, {}, "Reduction step succeeded.");
-          *current_binary = std::move(maybe_result);
-          interesting = true;
-          another_round_worthwhile = true;
+          // We must call this before the next call to TryApplyReductions.
+          pass->NotifyInteresting(interesting);
+          // The remaining candidates were derived from the binary that has
+          // just been replaced, so they are discarded.
+          if (interesting) break;
         }
-        // We must call this before the next call to TryApplyReduction.
-        pass->NotifyInteresting(interesting);
         // Bail out if the reduction step limit has been reached.
       } while (!ReachedStepLimit(*reductions_applied, options));
     }
@@ -245,5 +275,51 @@ Reducer::ReductionResultStatus Reducer::RunPasses(
   return Reducer::ReductionResultStatus::kComplete;
 }
 
+std::vector<Reducer::CandidateStatus> Reducer::EvaluateCandidates(
+    const std::vector<std::vector<uint32_t>>& candidates,
+    spv_const_reducer_options options, spv_validator_options validator_options,
+    const SpirvTools& tools, uint32_t reductions_applied) const {
+  std::vector<CandidateStatus> result(candidates.size(),
+                                      CandidateStatus::kNotEvaluated);
+
+  // The index of the first candidate known to end the sequence of steps,
+  // because it is interesting or because it stops the reduction.  Candidates
+  // after it are not evaluated.
+  std::atomic<size_t> first_final(candidates.size());
+
+  auto evaluate = [&](size_t i) {
+    const std::vector<uint32_t>& candidate = candidates[i];
+    if (!tools.Validate(&candidate[0], candidate.size(), validator_options)) {
+      result[i] = CandidateStatus::kInvalid;
+      if (!options->fail_on_validation_error) return;
+    } else if (interestingness_function_(
+                   candidate,
+                   reductions_applied + static_cast<uint32_t>(i) + 1)) {
+      result[i] = CandidateStatus::kInteresting;
+    } else {
+      result[i] = CandidateStatus::kNotInteresting;
+      return;
+    }
+    size_t current = first_final.load();
+    while (i < current && !first_final.compare_exchange_weak(current, i)) {
+    }
+  };
+
+  std::atomic<size_t> next_candidate(0);
+  auto worker = [&candidates, &first_final, &next_candidate, &evaluate]() {
+    for (size_t i = next_candidate++; i < candidates.size();
+         i = next_candidate++) {
+      if (i > first_final.load()) return;
+      evaluate(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < candidates.size(); ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+  return result;
+}
+
 }  // namespace reduce
 }  // namespace spvtools
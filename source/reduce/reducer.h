@@ -75,7 +75,8 @@ class Reducer {
   void SetMessageConsumer(MessageConsumer consumer);
 
   // Sets the function that will be used to decide whether a reduced binary
-  // turned out to be interesting.
+  // turned out to be interesting.  If the reducer options allow several
+  // threads, the function is called concurrently and must be thread-safe.
   void SetInterestingnessFunction(
       InterestingnessFunction interestingness_function);
 
@@ -103,6 +104,26 @@ class Reducer {
   static bool ReachedStepLimit(uint32_t current_step,
                                spv_const_reducer_options options);
 
+  // The outcome of evaluating one candidate reduction step.
+  enum class CandidateStatus {
+    kNotEvaluated,
+    kInvalid,
+    kNotInteresting,
+    kInteresting,
+  };
+
+  // Validates the binaries in |candidates| and runs the interestingness
+  // function on the valid ones, concurrently if there are several of them.
+  // The i-th candidate is numbered as reduction step
+  // |reductions_applied| + i + 1.  Candidates after the first one that is
+  // interesting, or invalid when failing on validation errors, may be left
+  // unevaluated, since they will not be considered.
+  std::vector<CandidateStatus> EvaluateCandidates(
+      const std::vector<std::vector<uint32_t>>& candidates,
+      spv_const_reducer_options options,
+      spv_validator_options validator_options, const SpirvTools& tools,
+      uint32_t reductions_applied) const;
+
   ReductionResultStatus RunPasses(
       std::vector<std::unique_ptr<ReductionPass>>* passes,
       spv_const_reducer_options options,
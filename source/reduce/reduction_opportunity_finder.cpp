@@ -17,6 +17,36 @@
 namespace spvtools {
 namespace reduce {
 
+std::vector<std::unique_ptr<ReductionOpportunity>>
+ReductionOpportunityFinder::GetAvailableOpportunities(
+    opt::IRContext* context, uint32_t target_function) const {
+  assert(FindsOpportunitiesPerFunction() &&
+         "Finders that do not work per function must override this.");
+  std::vector<std::unique_ptr<ReductionOpportunity>> result =
+      GetAvailableOpportunitiesOutsideFunctions(context, target_function);
+  for (auto* function : GetTargetFunctions(context, target_function)) {
+    for (auto& opportunity :
+         GetAvailableOpportunitiesInFunction(context, function)) {
+      result.push_back(std::move(opportunity));
+    }
+  }
+  return result;
+}
+
+std::vector<std::unique_ptr<ReductionOpportunity>>
+ReductionOpportunityFinder::GetAvailableOpportunitiesOutsideFunctions(
+    opt::IRContext* /*unused*/, uint32_t /*unused*/) const {
+  return {};
+}
+
+std::vector<std::unique_ptr<ReductionOpportunity>>
+ReductionOpportunityFinder::GetAvailableOpportunitiesInFunction(
+    opt::IRContext* /*unused*/, opt::Function* /*unused*/) const {
+  assert(false && "Only finders that work per function find opportunities in "
+                  "a single function.");
+  return {};
+}
+
 std::vector<opt::Function*> ReductionOpportunityFinder::GetTargetFunctions(
     opt::IRContext* ir_context, uint32_t target_function) {
   std::vector<opt::Function*> result;
@@ -36,9 +36,33 @@ class ReductionOpportunityFinder {
   // If |target_function| is non-zero then the available opportunities will be
   // restricted to only those opportunities that modify the function with result
   // id |target_function|.
+  //
+  // The default implementation is for finders that find opportunities per
+  // function: it returns the opportunities outside of functions, followed by
+  // those in each target function, in module order.
   virtual std::vector<std::unique_ptr<ReductionOpportunity>>
   GetAvailableOpportunities(opt::IRContext* context,
-                            uint32_t target_function) const = 0;
+                            uint32_t target_function) const;
+
+  // Returns true if the finder finds its opportunities per function, with
+  // GetAvailableOpportunitiesOutsideFunctions and
+  // GetAvailableOpportunitiesInFunction, and if the opportunities in a function
+  // only depend on the instructions of that function and on the instructions
+  // outside of functions.  A reduction pass can then keep what it knows about
+  // the functions that a reduction step does not change.
+  virtual bool FindsOpportunitiesPerFunction() const { return false; }
+
+  // Finds the opportunities that are outside of functions.  Only used if
+  // FindsOpportunitiesPerFunction() is true.
+  virtual std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesOutsideFunctions(opt::IRContext* context,
+                                            uint32_t target_function) const;
+
+  // Finds the opportunities in |function|.  Only used if
+  // FindsOpportunitiesPerFunction() is true.
+  virtual std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                      opt::Function* function) const;
 
   // Provides a name for the finder.
   virtual std::string GetName() const = 0;
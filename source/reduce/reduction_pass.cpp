@@ -15,36 +15,86 @@
 #include "source/reduce/reduction_pass.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
-#include "source/opt/build_module.h"
+#include "source/util/hash_combine.h"
 
 namespace spvtools {
 namespace reduce {
+namespace {
+
+// Returns |hash| combined with the opcode and operands of |inst|.
+size_t HashInstruction(size_t hash, const opt::Instruction& inst) {
+  hash = utils::hash_combine(hash, static_cast<uint32_t>(inst.opcode()),
+                             inst.NumOperands());
+  for (const opt::Operand& operand : inst) {
+    hash = utils::hash_combine(hash, static_cast<uint32_t>(operand.type));
+    for (uint32_t word : operand.words) {
+      hash = utils::hash_combine(hash, word);
+    }
+  }
+  return hash;
+}
+
+// Returns a hash of the instructions of |module| that are outside of
+// functions.
+size_t HashOutsideFunctions(const opt::Module& module) {
+  size_t hash = 0;
+  for (const auto& section :
+       {module.capabilities(), module.extensions(), module.ext_inst_imports(),
+        module.entry_points(), module.graph_entry_points(),
+        module.execution_modes(), module.debugs1(), module.debugs2(),
+        module.debugs3(), module.ext_inst_debuginfo(), module.annotations(),
+        module.types_values()}) {
+    for (const opt::Instruction& inst : section) {
+      hash = HashInstruction(hash, inst);
+    }
+  }
+  for (const opt::Instruction* inst :
+       {module.GetMemoryModel(), module.GetSampledImageAddressMode()}) {
+    if (inst) hash = HashInstruction(hash, *inst);
+  }
+  return hash;
+}
+
+// Returns a hash of the instructions of |function|.
+size_t HashFunction(const opt::Function& function) {
+  size_t hash = 0;
+  function.ForEachInst([&hash](const opt::Instruction* inst) {
+    hash = HashInstruction(hash, *inst);
+  });
+  return hash;
+}
+
+}  // namespace
 
 std::vector<uint32_t> ReductionPass::TryApplyReduction(
-    const std::vector<uint32_t>& binary, uint32_t target_function) {
-  // We represent modules as binaries because (a) attempts at reduction need to
-  // end up in binary form to be passed on to SPIR-V-consuming tools, and (b)
-  // when we apply a reduction step we need to do it on a fresh version of the
-  // module as if the reduction step proves to be uninteresting we need to
-  // backtrack; re-parsing from binary provides a very clean way of cloning the
-  // module.
-  std::unique_ptr<opt::IRContext> context =
-      BuildModule(target_env_, consumer_, binary.data(), binary.size());
-  assert(context);
-
-  std::vector<std::unique_ptr<ReductionOpportunity>> opportunities =
-      finder_->GetAvailableOpportunities(context.get(), target_function);
+    const opt::IRContext& original, uint32_t target_function) {
+  // When we apply a reduction step we need to do it on a fresh version of the
+  // module, as if the reduction step proves to be uninteresting we need to
+  // backtrack.  Copying the module in memory is much cheaper than re-parsing
+  // it from binary, and keeps |original| intact for the next attempt.
+  std::unique_ptr<opt::IRContext> context = original.Clone();
+  context->SetMessageConsumer(consumer_);
+
+  FoundOpportunities found;
+  const std::vector<Segment> segments =
+      GetSegments(context.get(), target_function, &found);
+  uint32_t num_opportunities = 0;
+  for (const Segment& segment : segments) {
+    num_opportunities += segment.num_opportunities;
+  }
 
   // There is no point in having a granularity larger than the number of
   // opportunities, so reduce the granularity in this case.
-  if (granularity_ > opportunities.size()) {
-    granularity_ = std::max((uint32_t)1, (uint32_t)opportunities.size());
+  if (granularity_ > num_opportunities) {
+    granularity_ = std::max((uint32_t)1, num_opportunities);
   }
 
   assert(granularity_ > 0);
 
-  if (index_ >= opportunities.size()) {
+  if (index_ >= num_opportunities) {
     // We have reached the end of the available opportunities and, therefore,
     // the end of the round for this pass, so reset the index and decrease the
     // granularity for the next round. Return an empty vector to signal the end
@@ -54,10 +104,181 @@ std::vector<uint32_t> ReductionPass::TryApplyReduction(
     return std::vector<uint32_t>();
   }
 
-  for (uint32_t i = index_;
-       i < std::min(index_ + granularity_, (uint32_t)opportunities.size());
-       ++i) {
-    opportunities[i]->TryToApply();
+  return ApplyOpportunities(
+      context.get(),
+      GetOpportunitiesInRange(context.get(), target_function, segments, &found,
+                              index_, index_ + granularity_));
+}
+
+std::vector<std::vector<uint32_t>> ReductionPass::TryApplyReductions(
+    const opt::IRContext& original, uint32_t target_function,
+    uint32_t max_candidates) {
+  assert(max_candidates > 0);
+  if (max_candidates == 1) {
+    std::vector<std::vector<uint32_t>> result;
+    std::vector<uint32_t> candidate =
+        TryApplyReduction(original, target_function);
+    if (!candidate.empty()) result.push_back(std::move(candidate));
+    return result;
+  }
+
+  std::unique_ptr<opt::IRContext> context = original.Clone();
+  context->SetMessageConsumer(consumer_);
+
+  FoundOpportunities found;
+  const std::vector<Segment> segments =
+      GetSegments(context.get(), target_function, &found);
+  uint32_t num_opportunities = 0;
+  for (const Segment& segment : segments) {
+    num_opportunities += segment.num_opportunities;
+  }
+
+  // The same bookkeeping as in TryApplyReduction.
+  if (granularity_ > num_opportunities) {
+    granularity_ = std::max((uint32_t)1, num_opportunities);
+  }
+  assert(granularity_ > 0);
+  if (index_ >= num_opportunities) {
+    index_ = 0;
+    granularity_ = std::max((uint32_t)1, granularity_ / 2);
+    return {};
+  }
+
+  const uint32_t num_chunks_left =
+      (num_opportunities - index_ + granularity_ - 1) / granularity_;
+  std::vector<std::vector<uint32_t>> result(
+      std::min(max_candidates, num_chunks_left));
+
+  // The first candidate reuses the context that was built to count the
+  // opportunities.  The others need fresh copies of the module, which are
+  // made and reduced concurrently.  Opportunity finding is deterministic, so
+  // every copy sees the same opportunities in the same order, and each copy
+  // only searches the segments that its chunk overlaps.
+  std::atomic<size_t> next_candidate(1);
+  auto worker = [this, &original, target_function, &segments, &result,
+                 &next_candidate]() {
+    for (size_t i = next_candidate++; i < result.size();
+         i = next_candidate++) {
+      std::unique_ptr<opt::IRContext> copy = original.Clone();
+      copy->SetMessageConsumer(consumer_);
+      const uint32_t begin = index_ + static_cast<uint32_t>(i) * granularity_;
+      FoundOpportunities none;
+      result[i] = ApplyOpportunities(
+          copy.get(), GetOpportunitiesInRange(copy.get(), target_function,
+                                              segments, &none, begin,
+                                              begin + granularity_));
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < result.size(); ++i) threads.emplace_back(worker);
+  result[0] = ApplyOpportunities(
+      context.get(),
+      GetOpportunitiesInRange(context.get(), target_function, segments, &found,
+                              index_, index_ + granularity_));
+  for (auto& thread : threads) thread.join();
+  return result;
+}
+
+std::vector<ReductionPass::Segment> ReductionPass::GetSegments(
+    opt::IRContext* context, uint32_t target_function,
+    FoundOpportunities* found) {
+  if (!finder_->FindsOpportunitiesPerFunction()) {
+    auto& opportunities = (*found)[0];
+    opportunities =
+        finder_->GetAvailableOpportunities(context, target_function);
+    return {{0, static_cast<uint32_t>(opportunities.size())}};
+  }
+
+  // The opportunities in a function may depend on the instructions outside of
+  // functions, so if any of those changed, nothing that is cached can be
+  // trusted.
+  const size_t outside_functions_hash =
+      HashOutsideFunctions(*context->module());
+  if (outside_functions_hash != outside_functions_hash_) {
+    outside_functions_hash_ = outside_functions_hash;
+    function_summaries_.clear();
+  }
+
+  // The opportunities outside of functions may depend on how ids are used in
+  // functions, so they are always found again; there are usually few of them.
+  auto& outside_functions = (*found)[0];
+  outside_functions = finder_->GetAvailableOpportunitiesOutsideFunctions(
+      context, target_function);
+  std::vector<Segment> result = {
+      {0, static_cast<uint32_t>(outside_functions.size())}};
+
+  // Rebuilding the summaries drops those of functions that no longer exist.
+  std::unordered_map<uint32_t, FunctionSummary> summaries;
+  for (auto& function : *context->module()) {
+    const uint32_t function_id = function.result_id();
+    if (target_function && function_id != target_function) {
+      continue;
+    }
+    const size_t hash = HashFunction(function);
+    uint32_t num_opportunities;
+    auto summary = function_summaries_.find(function_id);
+    if (summary != function_summaries_.end() && summary->second.hash == hash) {
+      num_opportunities = summary->second.num_opportunities;
+    } else {
+      auto& opportunities = (*found)[function_id];
+      opportunities =
+          finder_->GetAvailableOpportunitiesInFunction(context, &function);
+      num_opportunities = static_cast<uint32_t>(opportunities.size());
+    }
+    summaries[function_id] = {hash, num_opportunities};
+    result.push_back({function_id, num_opportunities});
+  }
+  function_summaries_ = std::move(summaries);
+  return result;
+}
+
+std::vector<std::unique_ptr<ReductionOpportunity>>
+ReductionPass::GetOpportunitiesInRange(opt::IRContext* context,
+                                       uint32_t target_function,
+                                       const std::vector<Segment>& segments,
+                                       FoundOpportunities* found,
+                                       uint32_t begin, uint32_t end) const {
+  std::vector<std::unique_ptr<ReductionOpportunity>> result;
+  uint32_t segment_begin = 0;
+  for (const Segment& segment : segments) {
+    const uint32_t segment_end = segment_begin + segment.num_opportunities;
+    if (segment_begin < end && begin < segment_end) {
+      // Every overlapping segment is searched before any opportunity is
+      // applied, as applying an opportunity can change what is found.
+      std::vector<std::unique_ptr<ReductionOpportunity>> opportunities;
+      auto it = found->find(segment.function_id);
+      if (it != found->end()) {
+        opportunities = std::move(it->second);
+      } else if (!finder_->FindsOpportunitiesPerFunction()) {
+        opportunities =
+            finder_->GetAvailableOpportunities(context, target_function);
+      } else if (segment.function_id == 0) {
+        opportunities = finder_->GetAvailableOpportunitiesOutsideFunctions(
+            context, target_function);
+      } else {
+        opportunities = finder_->GetAvailableOpportunitiesInFunction(
+            context, context->GetFunction(segment.function_id));
+      }
+      assert(opportunities.size() == segment.num_opportunities &&
+             "The number of opportunities in a segment has changed.");
+      for (uint32_t i = std::max(begin, segment_begin);
+           i < std::min(end, segment_end) &&
+           i - segment_begin < opportunities.size();
+           ++i) {
+        result.push_back(std::move(opportunities[i - segment_begin]));
+      }
+    }
+    segment_begin = segment_end;
+  }
+  return result;
+}
+
+std::vector<uint32_t> ReductionPass::ApplyOpportunities(
+    opt::IRContext* context,
+    const std::vector<std::unique_ptr<ReductionOpportunity>>& opportunities) {
+  for (const auto& opportunity : opportunities) {
+    opportunity->TryToApply();
   }
 
   std::vector<uint32_t> result;
@@ -16,6 +16,8 @@
 #define SOURCE_REDUCE_REDUCTION_PASS_H_
 
 #include <limits>
+#include <unordered_map>
+#include <vector>
 
 #include "source/opt/ir_context.h"
 #include "source/reduce/reduction_opportunity_finder.h"
@@ -33,19 +35,18 @@ namespace reduce {
 // again, until the minimum granularity is reached.
 class ReductionPass {
  public:
-  // Constructs a reduction pass with a given target environment, |target_env|,
-  // and a given finder of reduction opportunities, |finder|.
-  explicit ReductionPass(const spv_target_env target_env,
-                         std::unique_ptr<ReductionOpportunityFinder> finder)
-      : target_env_(target_env),
-        finder_(std::move(finder)),
+  // Constructs a reduction pass with a given finder of reduction
+  // opportunities, |finder|.
+  explicit ReductionPass(std::unique_ptr<ReductionOpportunityFinder> finder)
+      : finder_(std::move(finder)),
         index_(0),
         granularity_(std::numeric_limits<uint32_t>::max()) {}
 
-  // Applies the reduction pass to the given binary by applying a "chunk" of
-  // reduction opportunities. Returns the new binary if a chunk was applied; in
-  // this case, before the next call the caller must invoke
-  // NotifyInteresting(...) to indicate whether the new binary is interesting.
+  // Applies the reduction pass to a copy of the module in |context| by applying
+  // a "chunk" of reduction opportunities; |context| itself is left unchanged.
+  // Returns the new binary if a chunk was applied; in this case, before the
+  // next call the caller must invoke NotifyInteresting(...) to indicate
+  // whether the new binary is interesting.
   // Returns an empty vector if there are no more chunks left to apply; in this
   // case, the index will be reset and the granularity lowered for the next
   // round.
@@ -53,9 +54,20 @@ class ReductionPass {
   // If |target_function| is non-zero, only reduction opportunities that
   // simplify the internals of the function with result id |target_function|
   // will be applied.
-  std::vector<uint32_t> TryApplyReduction(const std::vector<uint32_t>& binary,
+  std::vector<uint32_t> TryApplyReduction(const opt::IRContext& context,
                                           uint32_t target_function);
 
+  // Speculative version of TryApplyReduction.  Returns up to |max_candidates|
+  // new binaries, where the i-th binary is the one that TryApplyReduction
+  // would return after NotifyInteresting(false) had been called i times.  Each
+  // candidate is computed from its own copy of |context|, on up to
+  // |max_candidates| threads.  Before the next call, the caller must invoke
+  // NotifyInteresting(...) once for each candidate it considered, in order.
+  // Returns an empty vector at the end of a round, as TryApplyReduction does.
+  std::vector<std::vector<uint32_t>> TryApplyReductions(
+      const opt::IRContext& context, uint32_t target_function,
+      uint32_t max_candidates);
+
   // Notifies the reduction pass whether the binary returned from
   // TryApplyReduction is interesting, so that the next call to
   // TryApplyReduction will avoid applying the same chunk of opportunities.
@@ -73,11 +85,58 @@ class ReductionPass {
   std::string GetName() const;
 
  private:
-  const spv_target_env target_env_;
+  // A contiguous run of the opportunities of the pass: those outside of
+  // functions, or those in one function.
+  struct Segment {
+    // The result id of the function, or 0 for the opportunities outside of
+    // functions.  If the finder does not find opportunities per function,
+    // there is a single segment, with id 0, holding every opportunity.
+    uint32_t function_id;
+    uint32_t num_opportunities;
+  };
+
+  // The opportunities that have been found in a context, keyed by segment.
+  using FoundOpportunities = std::unordered_map<
+      uint32_t, std::vector<std::unique_ptr<ReductionOpportunity>>>;
+
+  // What the pass remembers about a function between reduction steps.
+  struct FunctionSummary {
+    size_t hash;
+    uint32_t num_opportunities;
+  };
+
+  // Splits the opportunities in |context| into segments, in the order in which
+  // the finder returns them.  A function that is unchanged since the last call,
+  // along with everything outside of functions, is counted from the cache
+  // rather than searched again.  The opportunities that had to be found are
+  // added to |found|.
+  std::vector<Segment> GetSegments(opt::IRContext* context,
+                                   uint32_t target_function,
+                                   FoundOpportunities* found);
+
+  // Returns the opportunities in |context| with indices in [|begin|, |end|),
+  // which must be consistent with |segments|.  Only the segments that overlap
+  // the range are searched, unless their opportunities are already in |found|.
+  std::vector<std::unique_ptr<ReductionOpportunity>> GetOpportunitiesInRange(
+      opt::IRContext* context, uint32_t target_function,
+      const std::vector<Segment>& segments, FoundOpportunities* found,
+      uint32_t begin, uint32_t end) const;
+
+  // Applies |opportunities| to |context|, and returns the resulting binary.
+  static std::vector<uint32_t> ApplyOpportunities(
+      opt::IRContext* context,
+      const std::vector<std::unique_ptr<ReductionOpportunity>>& opportunities);
+
   const std::unique_ptr<ReductionOpportunityFinder> finder_;
   MessageConsumer consumer_;
   uint32_t index_;
   uint32_t granularity_;
+
+  // For a finder that finds opportunities per function: a hash of the
+  // instructions outside of functions, and the hash and number of
+  // opportunities of each function, at the time they were last searched.
+  size_t outside_functions_hash_ = 0;
+  std::unordered_map<uint32_t, FunctionSummary> function_summaries_;
 };
 
 }  // namespace reduce
@@ -23,18 +23,21 @@ std::string RemoveBlockReductionOpportunityFinder::GetName() const {
   return "RemoveBlockReductionOpportunityFinder";
 }
 
+bool RemoveBlockReductionOpportunityFinder::FindsOpportunitiesPerFunction()
+    const {
+  return true;
+}
+
 std::vector<std::unique_ptr<ReductionOpportunity>>
-RemoveBlockReductionOpportunityFinder::GetAvailableOpportunities(
-    opt::IRContext* context, uint32_t target_function) const {
+RemoveBlockReductionOpportunityFinder::GetAvailableOpportunitiesInFunction(
+    opt::IRContext* context, opt::Function* function) const {
   std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
-  // Consider every block in every relevant function.
-  for (auto* function : GetTargetFunctions(context, target_function)) {
-    for (auto bi = function->begin(); bi != function->end(); ++bi) {
-      if (IsBlockValidOpportunity(context, function, &bi)) {
-        result.push_back(MakeUnique<RemoveBlockReductionOpportunity>(
-            context, function, &*bi));
-      }
+  // Consider every block in the function.
+  for (auto bi = function->begin(); bi != function->end(); ++bi) {
+    if (IsBlockValidOpportunity(context, function, &bi)) {
+      result.push_back(MakeUnique<RemoveBlockReductionOpportunity>(
+          context, function, &*bi));
     }
   }
   return result;
@@ -26,9 +26,15 @@ RemoveUnusedInstructionReductionOpportunityFinder::
         bool remove_constants_and_undefs)
     : remove_constants_and_undefs_(remove_constants_and_undefs) {}
 
+bool RemoveUnusedInstructionReductionOpportunityFinder::
+    FindsOpportunitiesPerFunction() const {
+  return true;
+}
+
 std::vector<std::unique_ptr<ReductionOpportunity>>
-RemoveUnusedInstructionReductionOpportunityFinder::GetAvailableOpportunities(
-    opt::IRContext* context, uint32_t target_function) const {
+RemoveUnusedInstructionReductionOpportunityFinder::
+    GetAvailableOpportunitiesOutsideFunctions(opt::IRContext* context,
+                                              uint32_t target_function) const {
   std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
   if (!target_function) {
@@ -91,32 +97,38 @@ RemoveUnusedInstructionReductionOpportunityFinder::GetAvailableOpportunities(
           MakeUnique<RemoveInstructionReductionOpportunity>(&inst));
     }
   }
+  return result;
+}
+
+std::vector<std::unique_ptr<ReductionOpportunity>>
+RemoveUnusedInstructionReductionOpportunityFinder::
+    GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                        opt::Function* function) const {
+  std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
-  for (auto* function : GetTargetFunctions(context, target_function)) {
-    for (auto& block : *function) {
-      for (auto& inst : block) {
-        if (context->get_def_use_mgr()->NumUses(&inst) > 0) {
-          continue;
-        }
-        if (!remove_constants_and_undefs_ &&
-            spvOpcodeIsConstantOrUndef(inst.opcode())) {
-          continue;
-        }
-        if (spvOpcodeIsBlockTerminator(inst.opcode()) ||
-            inst.opcode() == spv::Op::OpSelectionMerge ||
-            inst.opcode() == spv::Op::OpLoopMerge) {
-          // In this reduction pass we do not want to affect static
-          // control flow.
-          continue;
-        }
-        // Given that we're in a block, we should only get here if
-        // the instruction is not directly related to control flow;
-        // i.e., it's some straightforward instruction with an
-        // unused result, like an arithmetic operation or function
-        // call.
-        result.push_back(
-            MakeUnique<RemoveInstructionReductionOpportunity>(&inst));
+  for (auto& block : *function) {
+    for (auto& inst : block) {
+      if (context->get_def_use_mgr()->NumUses(&inst) > 0) {
+        continue;
+      }
+      if (!remove_constants_and_undefs_ &&
+          spvOpcodeIsConstantOrUndef(inst.opcode())) {
+        continue;
+      }
+      if (spvOpcodeIsBlockTerminator(inst.opcode()) ||
+          inst.opcode() == spv::Op::OpSelectionMerge ||
+          inst.opcode() == spv::Op::OpLoopMerge) {
+        // In this reduction pass we do not want to affect static
+        // control flow.
+        continue;
       }
+      // Given that we're in a block, we should only get here if
+      // the instruction is not directly related to control flow;
+      // i.e., it's some straightforward instruction with an
+      // unused result, like an arithmetic operation or function
+      // call.
+      result.push_back(
+          MakeUnique<RemoveInstructionReductionOpportunity>(&inst));
     }
   }
   return result;
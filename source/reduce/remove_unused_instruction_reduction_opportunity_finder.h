@@ -37,9 +37,16 @@ class RemoveUnusedInstructionReductionOpportunityFinder
 
   std::string GetName() const final;
 
-  std::vector<std::unique_ptr<ReductionOpportunity>> GetAvailableOpportunities(
+  bool FindsOpportunitiesPerFunction() const final;
+
+  std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesOutsideFunctions(
       opt::IRContext* context, uint32_t target_function) const final;
 
+  std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                      opt::Function* function) const final;
+
  private:
   // Returns true if and only if the only uses of |inst| are by decorations that
   // relate intimately to the instruction (as opposed to decorations that could
@@ -20,36 +20,39 @@
 namespace spvtools {
 namespace reduce {
 
+bool SimpleConditionalBranchToBranchOpportunityFinder::
+    FindsOpportunitiesPerFunction() const {
+  return true;
+}
+
 std::vector<std::unique_ptr<ReductionOpportunity>>
-SimpleConditionalBranchToBranchOpportunityFinder::GetAvailableOpportunities(
-    opt::IRContext* context, uint32_t target_function) const {
+SimpleConditionalBranchToBranchOpportunityFinder::
+    GetAvailableOpportunitiesInFunction(opt::IRContext* /*unused*/,
+                                        opt::Function* function) const {
   std::vector<std::unique_ptr<ReductionOpportunity>> result;
 
-  // Consider every function.
-  for (auto* function : GetTargetFunctions(context, target_function)) {
-    // Consider every block in the function.
-    for (auto& block : *function) {
-      // The terminator must be spv::Op::OpBranchConditional.
-      opt::Instruction* terminator = block.terminator();
-      if (terminator->opcode() != spv::Op::OpBranchConditional) {
-        continue;
-      }
-      // It must not be a selection header, as these cannot be followed by
-      // OpBranch.
-      if (block.GetMergeInst() &&
-          block.GetMergeInst()->opcode() == spv::Op::OpSelectionMerge) {
-        continue;
-      }
-      // The conditional branch must be simplified.
-      if (terminator->GetSingleWordInOperand(kTrueBranchOperandIndex) !=
-          terminator->GetSingleWordInOperand(kFalseBranchOperandIndex)) {
-        continue;
-      }
-
-      result.push_back(
-          MakeUnique<SimpleConditionalBranchToBranchReductionOpportunity>(
-              block.terminator()));
+  // Consider every block in the function.
+  for (auto& block : *function) {
+    // The terminator must be spv::Op::OpBranchConditional.
+    opt::Instruction* terminator = block.terminator();
+    if (terminator->opcode() != spv::Op::OpBranchConditional) {
+      continue;
+    }
+    // It must not be a selection header, as these cannot be followed by
+    // OpBranch.
+    if (block.GetMergeInst() &&
+        block.GetMergeInst()->opcode() == spv::Op::OpSelectionMerge) {
+      continue;
     }
+    // The conditional branch must be simplified.
+    if (terminator->GetSingleWordInOperand(kTrueBranchOperandIndex) !=
+        terminator->GetSingleWordInOperand(kFalseBranchOperandIndex)) {
+      continue;
+    }
+
+    result.push_back(
+        MakeUnique<SimpleConditionalBranchToBranchReductionOpportunity>(
+            block.terminator()));
   }
   return result;
 }
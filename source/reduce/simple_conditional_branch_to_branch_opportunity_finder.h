@@ -25,8 +25,11 @@ namespace reduce {
 class SimpleConditionalBranchToBranchOpportunityFinder
     : public ReductionOpportunityFinder {
  public:
-  std::vector<std::unique_ptr<ReductionOpportunity>> GetAvailableOpportunities(
-      opt::IRContext* context, uint32_t target_function) const override;
+  bool FindsOpportunitiesPerFunction() const override;
+
+  std::vector<std::unique_ptr<ReductionOpportunity>>
+  GetAvailableOpportunitiesInFunction(opt::IRContext* context,
+                                      opt::Function* function) const override;
 
   std::string GetName() const override;
 };
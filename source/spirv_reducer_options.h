@@ -33,6 +33,9 @@ struct spv_reducer_options_t {
 
   // See spvReducerOptionsSetTargetFunction.
   uint32_t target_function;
+
+  // See spvReducerOptionsSetNumThreads.
+  uint32_t num_threads;
 };
 
 #endif  // SOURCE_SPIRV_REDUCER_OPTIONS_H_
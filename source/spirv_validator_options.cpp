@@ -140,3 +140,13 @@ void spvValidatorOptionsSetFriendlyNames(spv_validator_options options,
                                          bool val) {
   options->use_friendly_names = val;
 }
+
+void spvValidatorOptionsSetNumThreads(spv_validator_options options,
+                                      uint32_t num_threads) {
+  options->num_threads = num_threads;
+}
+
+void spvValidatorOptionsSetLevel(spv_validator_options options,
+                                 spv_validator_level_t level) {
+  options->level = level;
+}
@@ -51,7 +51,9 @@ struct spv_validator_options_t {
         allow_offset_texture_operand(false),
         allow_vulkan_32_bit_bitwise(false),
         before_hlsl_legalization(false),
-        use_friendly_names(true) {}
+        use_friendly_names(true),
+        num_threads(1),
+        level(SPV_VALIDATOR_LEVEL_FULL) {}
 
   validator_universal_limits_t universal_limits_;
   bool relax_struct_store;
@@ -66,6 +68,8 @@ struct spv_validator_options_t {
   bool allow_vulkan_32_bit_bitwise;
   bool before_hlsl_legalization;
   bool use_friendly_names;
+  uint32_t num_threads;
+  spv_validator_level_t level;
 };
 
 #endif  // SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
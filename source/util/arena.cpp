@@ -0,0 +1,101 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/arena.h"
+
+#include <cassert>
+#include <new>
+
+namespace spvtools {
+namespace utils {
+namespace {
+// The number of bytes requested from Arena::Allocate() by this thread.
+thread_local size_t bytes_allocated_on_thread = 0;
+}  // namespace
+
+Arena::~Arena() {
+  assert(live_ == 0 && "Destroying an arena whose memory is still in use.");
+  for (void* block : blocks_) {
+    ::operator delete(block);
+  }
+}
+
+void* Arena::Allocate(Arena* arena, size_t size) {
+  bytes_allocated_on_thread += size;
+  const size_t size_class = (size + 2 * sizeof(Header) - 1) / sizeof(Header);
+  Header* header;
+  if (arena == nullptr || size_class * sizeof(Header) > kMaxArenaAllocation) {
+    header = static_cast<Header*>(::operator new(sizeof(Header) + size));
+    header->arena = nullptr;
+  } else {
+    header = arena->AllocateFromBlocks(size_class);
+    header->arena = arena;
+    header->size_class = size_class;
+    ++arena->live_;
+  }
+  return header + 1;
+}
+
+void Arena::Deallocate(void* ptr) {
+  if (ptr == nullptr) return;
+  Header* header = static_cast<Header*>(ptr) - 1;
+  if (header->arena == nullptr) {
+    ::operator delete(header);
+  } else {
+    header->arena->Free(header);
+  }
+}
+
+size_t Arena::BytesAllocatedOnThisThread() {
+  return bytes_allocated_on_thread;
+}
+
+void Arena::Release(Arena* arena) {
+  if (arena == nullptr) return;
+  arena->released_ = true;
+  if (arena->live_ == 0) delete arena;
+}
+
+Arena::Header* Arena::AllocateFromBlocks(size_t size_class) {
+  if (Header* header = free_lists_[size_class]) {
+    free_lists_[size_class] = header->next_free;
+    return header;
+  }
+
+  const size_t bytes = size_class * sizeof(Header);
+  if (static_cast<size_t>(end_ - next_) < bytes) {
+    blocks_.push_back(::operator new(kBlockSize));
+    next_ = static_cast<char*>(blocks_.back());
+    end_ = next_ + kBlockSize;
+  }
+  Header* header = reinterpret_cast<Header*>(next_);
+  next_ += bytes;
+  return header;
+}
+
+void Arena::Free(Header* header) {
+  assert(live_ > 0);
+  --live_;
+  if (released_) {
+    // Nothing will be allocated anymore, so the memory is not worth keeping
+    // track of until the whole arena goes away.
+    if (live_ == 0) delete this;
+    return;
+  }
+  header->next_free = free_lists_[header->size_class];
+  free_lists_[header->size_class] = header;
+}
+
+}  // namespace utils
+}  // namespace spvtools
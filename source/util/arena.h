@@ -0,0 +1,108 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_ARENA_H_
+#define SOURCE_UTIL_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// Allocates small objects out of large blocks of memory, which are freed all
+// at once when the arena is no longer needed.  Memory released before then is
+// kept on a free list for its size and reused by later allocations.
+//
+// Every piece of memory handed out by Allocate(), whether it comes from an
+// arena or not, starts with a header naming the arena that owns it.  This lets
+// Deallocate() release memory without being told where it came from, so that
+// a class can implement its operator new and operator delete with an arena
+// when one is available, and with the global allocator (which may be
+// mimalloc) otherwise.
+//
+// The owner of an arena gives it up with Release().  The arena is destroyed
+// once it has been released and none of its memory is in use anymore, so
+// objects may safely outlive the owner of the arena they were allocated from.
+//
+// An arena must not be used by several threads at the same time.
+class Arena {
+ public:
+  Arena() = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns |size| bytes of memory aligned for any object.  The memory is
+  // taken from |arena| if it is not null and |size| is small enough, and from
+  // the global operator new otherwise.
+  static void* Allocate(Arena* arena, size_t size);
+
+  // Releases |ptr|, which must have been returned by Allocate().
+  static void Deallocate(void* ptr);
+
+  // Gives up ownership of |arena|.  It is destroyed as soon as none of the
+  // memory allocated from it is in use.  Does nothing if |arena| is null.
+  static void Release(Arena* arena);
+
+  // Returns the number of allocations from this arena still in use.
+  size_t live_allocations() const { return live_; }
+
+  // Returns the number of bytes requested from Allocate() by the calling
+  // thread so far, whether they were served by an arena or not.
+  static size_t BytesAllocatedOnThisThread();
+
+ private:
+  // Precedes every allocation.  For memory on a free list, the header holds
+  // the next free entry instead.
+  struct alignas(alignof(std::max_align_t)) Header {
+    union {
+      Arena* arena;
+      Header* next_free;
+    };
+    // The size of the allocation, header included, in units of
+    // sizeof(Header).  Unused for memory that does not come from an arena.
+    size_t size_class;
+  };
+
+  // The largest allocation, header included, served from the arena.
+  static constexpr size_t kMaxArenaAllocation = 512;
+  // The size of the blocks requested from the global allocator.
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  ~Arena();
+
+  // Returns memory for |size_class| units of sizeof(Header) from the free
+  // list for that size, or from the current block.
+  Header* AllocateFromBlocks(size_t size_class);
+
+  // Returns |header| to the free list for its size.
+  void Free(Header* header);
+
+  // The blocks obtained from the global allocator.
+  std::vector<void*> blocks_;
+  // The unused range at the end of the most recent block.
+  char* next_ = nullptr;
+  char* end_ = nullptr;
+  // The heads of the free lists, indexed by size class.
+  Header* free_lists_[kMaxArenaAllocation / sizeof(Header) + 1] = {};
+  // The number of allocations currently in use.
+  size_t live_ = 0;
+  // Whether the owner gave up the arena.
+  bool released_ = false;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_ARENA_H_
@@ -14,10 +14,15 @@
 
 #include "source/val/validate.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "source/binary.h"
@@ -165,6 +170,246 @@ spv_result_t ValidateGraphEntryPoints(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
+// A check of individual instructions.
+struct InstructionCheck {
+  spv_result_t (*pass)(ValidationState_t& _, const Instruction* inst);
+  // True if the check is skipped at the fast validator level.
+  bool full_only;
+};
+
+// The checks of individual instructions, indexed by opcode.
+struct InstructionCheckTable {
+  // The checks of each opcode acted on by some opcode-specific pass.
+  std::unordered_map<spv::Op, std::vector<InstructionCheck>> by_opcode;
+  // The checks of every other opcode.
+  std::vector<InstructionCheck> any_opcode;
+  // The checks of the passes registered with an opcode list.
+  std::vector<InstructionCheck> listed;
+};
+
+// Builds the dispatch table of the instruction checks.  Most passes only act
+// on a fixed set of opcodes and return early for any other, so each opcode is
+// mapped to the passes that may act on it.  Passes that may act on any opcode
+// are registered without an opcode list and run for every instruction.  The
+// opcode list of a pass must cover every opcode the pass acts on, since the
+// pass is never run on the others.
+InstructionCheckTable BuildInstructionCheckTable() {
+  struct Registration {
+    spv_result_t (*pass)(ValidationState_t& _, const Instruction* inst);
+    std::vector<spv::Op> opcodes;
+    bool full_only;
+  };
+  // Keep these passes in the order they appear in the SPIR-V specification
+  // sections to maintain test consistency.
+  const std::vector<Registration> registrations = {
+      {MiscPass, MiscPassOpcodes(), false},
+      {DebugPass, DebugPassOpcodes(), false},
+      {AnnotationPass, AnnotationPassOpcodes(), false},
+      {ExtensionPass, {}, false},
+      {ModeSettingPass, ModeSettingPassOpcodes(), false},
+      {TypePass, {}, false},
+      {ConstantPass, {}, false},
+      {MemoryPass, MemoryPassOpcodes(), false},
+      {FunctionPass, FunctionPassOpcodes(), false},
+      {ImagePass, ImagePassOpcodes(), true},
+      {ConversionPass, ConversionPassOpcodes(), false},
+      {CompositesPass, CompositesPassOpcodes(), false},
+      {ArithmeticsPass, ArithmeticsPassOpcodes(), false},
+      {BitwisePass, BitwisePassOpcodes(), false},
+      {LogicalsPass, LogicalsPassOpcodes(), false},
+      {ControlFlowPass, ControlFlowPassOpcodes(), false},
+      {DerivativesPass, DerivativesPassOpcodes(), false},
+      {AtomicsPass, AtomicsPassOpcodes(), false},
+      {PrimitivesPass, PrimitivesPassOpcodes(), false},
+      {BarriersPass, BarriersPassOpcodes(), false},
+      {DotProductPass, DotProductPassOpcodes(), false},
+      {GroupPass, GroupPassOpcodes(), false},
+      // Device-Side Enqueue
+      {PipePass, PipePassOpcodes(), false},
+      {NonUniformPass, {}, false},
+      {LiteralsPass, {}, false},
+      {RayQueryPass, RayQueryPassOpcodes(), true},
+      {RayTracingPass, RayTracingPassOpcodes(), true},
+      {RayReorderNVPass, RayReorderNVPassOpcodes(), true},
+      {RayReorderEXTPass, RayReorderEXTPassOpcodes(), true},
+      {MeshShadingPass, MeshShadingPassOpcodes(), false},
+      {TensorLayoutPass, TensorLayoutPassOpcodes(), false},
+      {TensorPass, TensorPassOpcodes(), false},
+      {GraphPass, GraphPassOpcodes(), false},
+      {InvalidTypePass, InvalidTypePassOpcodes(), false},
+  };
+
+  // Create the entry of every listed opcode first so that the passes acting
+  // on any opcode are appended to it in registration order.
+  InstructionCheckTable table;
+  for (const auto& registration : registrations) {
+    for (const spv::Op opcode : registration.opcodes) {
+      table.by_opcode.emplace(opcode, std::vector<InstructionCheck>());
+    }
+  }
+  for (const auto& registration : registrations) {
+    const InstructionCheck check{registration.pass, registration.full_only};
+    if (registration.opcodes.empty()) {
+      table.any_opcode.push_back(check);
+      for (auto& entry : table.by_opcode) entry.second.push_back(check);
+      continue;
+    }
+    table.listed.push_back(check);
+    for (const spv::Op opcode : registration.opcodes) {
+      table.by_opcode[opcode].push_back(check);
+    }
+  }
+  return table;
+}
+
+const InstructionCheckTable& GetInstructionCheckTable() {
+  static const InstructionCheckTable table = BuildInstructionCheckTable();
+  return table;
+}
+
+// Returns the checks that may act on instructions with |opcode|, in the
+// order they must run.
+const std::vector<InstructionCheck>& GetInstructionChecks(spv::Op opcode) {
+  const InstructionCheckTable& table = GetInstructionCheckTable();
+  const auto it = table.by_opcode.find(opcode);
+  return it == table.by_opcode.end() ? table.any_opcode : it->second;
+}
+
+// Runs the checks of individual opcodes on |inst|.
+spv_result_t ValidateInstruction(ValidationState_t& _,
+                                 const Instruction* inst) {
+  const std::vector<InstructionCheck>& checks =
+      GetInstructionChecks(inst->opcode());
+#ifndef NDEBUG
+  // The opcode lists are written by hand next to the switch of each pass.
+  // Check that the passes not registered for this opcode ignore it.
+  for (const auto& check : GetInstructionCheckTable().listed) {
+    if (std::any_of(checks.begin(), checks.end(),
+                    [&check](const InstructionCheck& selected) {
+                      return selected.pass == check.pass;
+                    })) {
+      continue;
+    }
+    const spv_result_t result = check.pass(_, inst);
+    assert(result == SPV_SUCCESS &&
+           "The opcode list of a validator pass misses an opcode it checks.");
+    (void)result;
+  }
+#endif
+  const bool fast = _.IsFastValidation();
+  for (const auto& check : checks) {
+    if (fast && check.full_only) continue;
+    if (auto error = check.pass(_, inst)) return error;
+  }
+  return SPV_SUCCESS;
+}
+
+// Runs ValidateInstruction on |count| consecutive instructions starting at
+// |first|, stopping at the first error.
+spv_result_t ValidateInstructionRange(ValidationState_t& _,
+                                      const Instruction* first, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (auto error = ValidateInstruction(_, first + i)) return error;
+  }
+  return SPV_SUCCESS;
+}
+
+// Runs ValidateInstruction on every instruction of the module, checking the
+// bodies of different functions on up to |num_threads| threads.
+//
+// The instructions preceding the first function are checked first, on the
+// calling thread, since the checks of function bodies depend on the state
+// they register. The module is otherwise split into one unit per function
+// plus the units of module-level instructions found between or after
+// functions. Diagnostics of each unit are collected and reported in module
+// order once all units are checked, stopping at the first unit with an error,
+// so the output is the same as validating serially.
+spv_result_t ValidateInstructionsConcurrently(ValidationState_t& _,
+                                              uint32_t num_threads) {
+  const auto& instructions = _.ordered_instructions();
+
+  struct Unit {
+    size_t begin;
+    size_t end;
+    bool is_function;
+  };
+  std::vector<Unit> units;
+  size_t unit_begin = 0;
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const spv::Op opcode = instructions[i].opcode();
+    if (opcode == spv::Op::OpFunction) {
+      if (i > unit_begin) units.push_back({unit_begin, i, false});
+      unit_begin = i;
+    } else if (opcode == spv::Op::OpFunctionEnd) {
+      units.push_back({unit_begin, i + 1, true});
+      unit_begin = i + 1;
+    }
+  }
+  if (unit_begin < instructions.size()) {
+    units.push_back({unit_begin, instructions.size(), false});
+  }
+
+  // The module-level prologue is checked serially and reported directly.
+  size_t first_unit = 0;
+  if (!units.empty() && !units[0].is_function) {
+    if (auto error = ValidateInstructionRange(
+            _, &instructions[units[0].begin], units[0].end - units[0].begin))
+      return error;
+    first_unit = 1;
+  }
+
+  std::vector<spv_result_t> results(units.size(), SPV_SUCCESS);
+  std::vector<std::vector<ValidationState_t::DeferredMessage>> messages(
+      units.size());
+  // Index of the earliest unit known to fail. Units after it need not be
+  // checked since their diagnostics would never be reported.
+  std::atomic<size_t> first_failed_unit(units.size());
+
+  auto check_unit = [&_, &instructions, &units, &results, &messages,
+                     &first_failed_unit](size_t index) {
+    if (index > first_failed_unit.load()) return;
+    const Unit& unit = units[index];
+    ValidationState_t::SetThreadDeferredMessages(&messages[index]);
+    results[index] = ValidateInstructionRange(_, &instructions[unit.begin],
+                                              unit.end - unit.begin);
+    ValidationState_t::SetThreadDeferredMessages(nullptr);
+    if (results[index] != SPV_SUCCESS) {
+      size_t failed = first_failed_unit.load();
+      while (index < failed &&
+             !first_failed_unit.compare_exchange_weak(failed, index)) {
+      }
+    }
+  };
+
+  std::atomic<size_t> next_unit(first_unit);
+  auto worker = [&units, &next_unit, &check_unit]() {
+    for (size_t index = next_unit++; index < units.size();
+         index = next_unit++) {
+      if (units[index].is_function) check_unit(index);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < num_threads; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+
+  // Module-level instructions between or after functions may depend on state
+  // registered by any function body, so they are checked last.
+  for (size_t index = first_unit; index < units.size(); ++index) {
+    if (!units[index].is_function) check_unit(index);
+  }
+
+  for (size_t index = first_unit; index < units.size(); ++index) {
+    for (const auto& message : messages[index]) {
+      _.EmitDeferredMessage(message);
+    }
+    if (results[index] != SPV_SUCCESS) return results[index];
+  }
+
+  return SPV_SUCCESS;
+}
+
 spv_result_t ValidateBinaryUsingContextAndValidationState(
     const spv_context_t& context, const uint32_t* words, const size_t num_words,
     spv_diagnostic* pDiagnostic, ValidationState_t* vstate) {
@@ -318,9 +563,16 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
       if (inst->opcode() == spv::Op::OpTypeForwardPointer) {
         vstate->RegisterForwardPointer(inst->GetOperandAs<uint32_t>(0));
       }
+      // In order to validate decoration rules, we need to know all the
+      // decorations that are applied to any given <id>.
+      if (auto error = RegisterDecorations(*vstate, inst)) return error;
     }
   }
 
+  // The annotation section has been parsed, so the decorations can be laid
+  // out in their final table.
+  vstate->FinalizeDecorations();
+
   if (!vstate->has_memory_model_specified())
     return vstate->diag(SPV_ERROR_INVALID_LAYOUT, nullptr)
            << "Missing required OpMemoryModel instruction.";
@@ -365,47 +617,15 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   }
 
   // Validate individual opcodes.
-  for (size_t i = 0; i < vstate->ordered_instructions().size(); ++i) {
-    auto& instruction = vstate->ordered_instructions()[i];
-
-    // Keep these passes in the order they appear in the SPIR-V specification
-    // sections to maintain test consistency.
-    if (auto error = MiscPass(*vstate, &instruction)) return error;
-    if (auto error = DebugPass(*vstate, &instruction)) return error;
-    if (auto error = AnnotationPass(*vstate, &instruction)) return error;
-    if (auto error = ExtensionPass(*vstate, &instruction)) return error;
-    if (auto error = ModeSettingPass(*vstate, &instruction)) return error;
-    if (auto error = TypePass(*vstate, &instruction)) return error;
-    if (auto error = ConstantPass(*vstate, &instruction)) return error;
-    if (auto error = MemoryPass(*vstate, &instruction)) return error;
-    if (auto error = FunctionPass(*vstate, &instruction)) return error;
-    if (auto error = ImagePass(*vstate, &instruction)) return error;
-    if (auto error = ConversionPass(*vstate, &instruction)) return error;
-    if (auto error = CompositesPass(*vstate, &instruction)) return error;
-    if (auto error = ArithmeticsPass(*vstate, &instruction)) return error;
-    if (auto error = BitwisePass(*vstate, &instruction)) return error;
-    if (auto error = LogicalsPass(*vstate, &instruction)) return error;
-    if (auto error = ControlFlowPass(*vstate, &instruction)) return error;
-    if (auto error = DerivativesPass(*vstate, &instruction)) return error;
-    if (auto error = AtomicsPass(*vstate, &instruction)) return error;
-    if (auto error = PrimitivesPass(*vstate, &instruction)) return error;
-    if (auto error = BarriersPass(*vstate, &instruction)) return error;
-    if (auto error = DotProductPass(*vstate, &instruction)) return error;
-    if (auto error = GroupPass(*vstate, &instruction)) return error;
-    // Device-Side Enqueue
-    if (auto error = PipePass(*vstate, &instruction)) return error;
-    if (auto error = NonUniformPass(*vstate, &instruction)) return error;
-
-    if (auto error = LiteralsPass(*vstate, &instruction)) return error;
-    if (auto error = RayQueryPass(*vstate, &instruction)) return error;
-    if (auto error = RayTracingPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderNVPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderEXTPass(*vstate, &instruction)) return error;
-    if (auto error = MeshShadingPass(*vstate, &instruction)) return error;
-    if (auto error = TensorLayoutPass(*vstate, &instruction)) return error;
-    if (auto error = TensorPass(*vstate, &instruction)) return error;
-    if (auto error = GraphPass(*vstate, &instruction)) return error;
-    if (auto error = InvalidTypePass(*vstate, &instruction)) return error;
+  const uint32_t num_threads = vstate->options()->num_threads;
+  if (num_threads > 1) {
+    if (auto error = ValidateInstructionsConcurrently(*vstate, num_threads))
+      return error;
+  } else {
+    const auto& instructions = vstate->ordered_instructions();
+    if (auto error = ValidateInstructionRange(*vstate, instructions.data(),
+                                              instructions.size()))
+      return error;
   }
 
   // Validate the preconditions involving adjacent instructions. e.g.
@@ -423,14 +643,18 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   if (auto error = ValidateInterfaces(*vstate)) return error;
   // TODO(dsinclair): Restructure ValidateBuiltins so we can move into the
   // for() above as it loops over all ordered_instructions internally.
-  if (auto error = ValidateBuiltIns(*vstate)) return error;
+  if (!vstate->IsFastValidation()) {
+    if (auto error = ValidateBuiltIns(*vstate)) return error;
+  }
   // These checks must be performed after individual opcode checks because
   // those checks register the limitation checked here.
   for (const auto& inst : vstate->ordered_instructions()) {
     if (auto error = ValidateExecutionLimitations(*vstate, &inst)) return error;
     if (auto error = ValidateSmallTypeUses(*vstate, &inst)) return error;
-    if (auto error = ValidateQCOMImageProcessingTextureUsages(*vstate, &inst))
-      return error;
+    if (!vstate->IsFastValidation()) {
+      if (auto error = ValidateQCOMImageProcessingTextureUsages(*vstate, &inst))
+        return error;
+    }
   }
   if (auto error = ValidateLogicalPointers(*vstate)) return error;
 
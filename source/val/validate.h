@@ -107,6 +107,9 @@ spv_result_t ValidateDuplicateExecutionModes(ValidationState_t& _);
 /// @return SPV_SUCCESS if no errors are found.
 spv_result_t MemoryPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes MemoryPass acts on.
+std::vector<spv::Op> MemoryPassOpcodes();
+
 /// @brief Updates the immediate dominator for each of the block edges
 ///
 /// Updates the immediate dominator of the blocks for each of the edges
@@ -134,6 +137,9 @@ spv_result_t CfgPass(ValidationState_t& _, const Instruction* inst);
 /// Validates Control Flow Graph instructions.
 spv_result_t ControlFlowPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes ControlFlowPass acts on.
+std::vector<spv::Op> ControlFlowPassOpcodes();
+
 /// Performs Id and SSA validation of a module
 spv_result_t IdPass(ValidationState_t& _, Instruction* inst);
 
@@ -156,36 +162,69 @@ spv_result_t ConstantPass(ValidationState_t& _, const Instruction* inst);
 /// Validates correctness of arithmetic instructions.
 spv_result_t ArithmeticsPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes ArithmeticsPass acts on.
+std::vector<spv::Op> ArithmeticsPassOpcodes();
+
 /// Validates correctness of composite instructions.
 spv_result_t CompositesPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes CompositesPass acts on.
+std::vector<spv::Op> CompositesPassOpcodes();
+
 /// Validates correctness of conversion instructions.
 spv_result_t ConversionPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes ConversionPass acts on.
+std::vector<spv::Op> ConversionPassOpcodes();
+
 /// Validates correctness of derivative instructions.
 spv_result_t DerivativesPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes DerivativesPass acts on.
+std::vector<spv::Op> DerivativesPassOpcodes();
+
 /// Validates correctness of logical instructions.
 spv_result_t LogicalsPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes LogicalsPass acts on.
+std::vector<spv::Op> LogicalsPassOpcodes();
+
 /// Validates correctness of bitwise instructions.
 spv_result_t BitwisePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes BitwisePass acts on.
+std::vector<spv::Op> BitwisePassOpcodes();
+
 /// Validates correctness of image instructions.
 spv_result_t ImagePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes ImagePass acts on.
+std::vector<spv::Op> ImagePassOpcodes();
+
 /// Validates correctness of atomic instructions.
 spv_result_t AtomicsPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes AtomicsPass acts on.
+std::vector<spv::Op> AtomicsPassOpcodes();
+
 /// Validates correctness of barrier instructions.
 spv_result_t BarriersPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes BarriersPass acts on.
+std::vector<spv::Op> BarriersPassOpcodes();
+
 /// Validates correctness of DotProduct instructions.
 spv_result_t DotProductPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes DotProductPass acts on.
+std::vector<spv::Op> DotProductPassOpcodes();
+
 /// Validates correctness of Group (Kernel) instructions.
 spv_result_t GroupPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes GroupPass acts on.
+std::vector<spv::Op> GroupPassOpcodes();
+
 /// Validates correctness of literal numbers.
 spv_result_t LiteralsPass(ValidationState_t& _, const Instruction* inst);
 
@@ -195,15 +234,29 @@ spv_result_t ExtensionPass(ValidationState_t& _, const Instruction* inst);
 /// Validates correctness of annotation instructions.
 spv_result_t AnnotationPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes AnnotationPass acts on.
+std::vector<spv::Op> AnnotationPassOpcodes();
+
+/// Registers the decorations applied by |inst| if it is an annotation
+/// instruction.  The decorations become visible to queries once
+/// ValidationState_t::FinalizeDecorations() is called.
+spv_result_t RegisterDecorations(ValidationState_t& _, const Instruction* inst);
+
 /// Validates correctness of pipe instructions.
 spv_result_t PipePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes PipePass acts on.
+std::vector<spv::Op> PipePassOpcodes();
+
 /// Validates correctness of non-uniform group instructions.
 spv_result_t NonUniformPass(ValidationState_t& _, const Instruction* inst);
 
 /// Validates correctness of debug instructions.
 spv_result_t DebugPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes DebugPass acts on.
+std::vector<spv::Op> DebugPassOpcodes();
+
 /// Validates that capability declarations use operands allowed in the current
 /// context.
 spv_result_t CapabilityPass(ValidationState_t& _, const Instruction* inst);
@@ -211,45 +264,84 @@ spv_result_t CapabilityPass(ValidationState_t& _, const Instruction* inst);
 /// Validates correctness of primitive instructions.
 spv_result_t PrimitivesPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes PrimitivesPass acts on.
+std::vector<spv::Op> PrimitivesPassOpcodes();
+
 /// Validates correctness of mode setting instructions.
 spv_result_t ModeSettingPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes ModeSettingPass acts on.
+std::vector<spv::Op> ModeSettingPassOpcodes();
+
 /// Validates correctness of function instructions.
 spv_result_t FunctionPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes FunctionPass acts on.
+std::vector<spv::Op> FunctionPassOpcodes();
+
 /// Validates correctness of miscellaneous instructions.
 spv_result_t MiscPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes MiscPass acts on.
+std::vector<spv::Op> MiscPassOpcodes();
+
 /// Validates correctness of ray query instructions.
 spv_result_t RayQueryPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes RayQueryPass acts on.
+std::vector<spv::Op> RayQueryPassOpcodes();
+
 /// Validates correctness of ray tracing instructions.
 spv_result_t RayTracingPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes RayTracingPass acts on.
+std::vector<spv::Op> RayTracingPassOpcodes();
+
 /// Validates correctness of shader execution reorder instructions.
 spv_result_t RayReorderNVPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes RayReorderNVPass acts on.
+std::vector<spv::Op> RayReorderNVPassOpcodes();
+
 /// Validates correctness of shader execution reorder EXT instructions.
 spv_result_t RayReorderEXTPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes RayReorderEXTPass acts on.
+std::vector<spv::Op> RayReorderEXTPassOpcodes();
+
 /// Validates correctness of mesh shading instructions.
 spv_result_t MeshShadingPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes MeshShadingPass acts on.
+std::vector<spv::Op> MeshShadingPassOpcodes();
+
 /// Validates correctness of tensor instructions.
 spv_result_t TensorPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes TensorPass acts on.
+std::vector<spv::Op> TensorPassOpcodes();
+
 /// Validates correctness of graph instructions.
 spv_result_t GraphPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes GraphPass acts on.
+std::vector<spv::Op> GraphPassOpcodes();
+
 /// Validates correctness of certain special type instructions.
 spv_result_t InvalidTypePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes InvalidTypePass acts on.
+std::vector<spv::Op> InvalidTypePassOpcodes();
+
 /// Calculates the reachability of basic blocks.
 void ReachabilityPass(ValidationState_t& _);
 
 /// Validates tensor layout and view instructions.
 spv_result_t TensorLayoutPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns the opcodes TensorLayoutPass acts on.
+std::vector<spv::Op> TensorLayoutPassOpcodes();
+
 /// Validates execution limitations.
 ///
 /// Verifies execution models are allowed for all functionality they contain.
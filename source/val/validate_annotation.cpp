@@ -312,15 +312,6 @@ spv_result_t ValidateDecorate(ValidationState_t& _, const Instruction* inst) {
     }
   }
 
-  // This is checked from both sides since we register decorations as we go.
-  if (decoration == spv::Decoration::NoContraction) {
-    if (_.HasDecoration(target_id, spv::Decoration::FPFastMathMode)) {
-      return _.diag(SPV_ERROR_INVALID_ID, inst)
-             << "FPFastMathMode and NoContraction cannot decorate the same "
-                "target";
-    }
-  }
-
   if (DecorationTakesIdParameters(decoration)) {
     return _.diag(SPV_ERROR_INVALID_ID, inst)
            << "Decorations taking ID parameters may not be used with "
@@ -571,8 +562,8 @@ spv_result_t ValidateGroupMemberDecorate(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
-// Registers necessary decoration(s) for the appropriate IDs based on the
-// instruction.
+}  // namespace
+
 spv_result_t RegisterDecorations(ValidationState_t& _,
                                  const Instruction* inst) {
   switch (inst->opcode()) {
@@ -613,12 +604,9 @@ spv_result_t RegisterDecorations(ValidationState_t& _,
       // Word 1 is the group <id>. All subsequent words are target <id>s that
       // are going to be decorated with the decorations.
       const uint32_t decoration_group_id = inst->word(1);
-      std::set<Decoration>& group_decorations =
-          _.id_decorations(decoration_group_id);
       for (size_t i = 2; i < inst->words().size(); ++i) {
         const uint32_t target_id = inst->word(i);
-        _.RegisterDecorationsForId(target_id, group_decorations.begin(),
-                                   group_decorations.end());
+        _.RegisterGroupDecorationsForId(decoration_group_id, target_id);
       }
       break;
     }
@@ -627,18 +615,15 @@ spv_result_t RegisterDecorations(ValidationState_t& _,
       // pairs. All decorations of the group should be applied to all the struct
       // members that are specified in the instructions.
       const uint32_t decoration_group_id = inst->word(1);
-      std::set<Decoration>& group_decorations =
-          _.id_decorations(decoration_group_id);
       // Grammar checks ensures that the number of arguments to this instruction
       // is an odd number: 1 decoration group + (id,literal) pairs.
       for (size_t i = 2; i + 1 < inst->words().size(); i = i + 2) {
         const uint32_t struct_id = inst->word(i);
         const uint32_t index = inst->word(i + 1);
-        // ID validation phase ensures this is in fact a struct instruction and
-        // that the index is not out of bound.
-        _.RegisterDecorationsForStructMember(struct_id, index,
-                                             group_decorations.begin(),
-                                             group_decorations.end());
+        // The annotation pass checks that this is in fact a struct
+        // instruction and that the index is not out of bound.
+        _.RegisterGroupDecorationsForStructMember(decoration_group_id,
+                                                  struct_id, index);
       }
       break;
     }
@@ -648,8 +633,6 @@ spv_result_t RegisterDecorations(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
-}  // namespace
-
 spv_result_t AnnotationPass(ValidationState_t& _, const Instruction* inst) {
   switch (inst->opcode()) {
     case spv::Op::OpDecorate:
@@ -677,12 +660,20 @@ spv_result_t AnnotationPass(ValidationState_t& _, const Instruction* inst) {
       break;
   }
 
-  // In order to validate decoration rules, we need to know all the decorations
-  // that are applied to any given <id>.
-  RegisterDecorations(_, inst);
-
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> AnnotationPassOpcodes() {
+  return {
+      spv::Op::OpDecorate,
+      spv::Op::OpDecorateId,
+      spv::Op::OpMemberDecorate,
+      spv::Op::OpMemberDecorateIdEXT,
+      spv::Op::OpDecorationGroup,
+      spv::Op::OpGroupDecorate,
+      spv::Op::OpGroupMemberDecorate,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
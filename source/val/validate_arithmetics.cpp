@@ -920,5 +920,42 @@ spv_result_t ArithmeticsPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> ArithmeticsPassOpcodes() {
+  return {
+      spv::Op::OpFAdd,
+      spv::Op::OpFSub,
+      spv::Op::OpFMul,
+      spv::Op::OpFDiv,
+      spv::Op::OpFRem,
+      spv::Op::OpFMod,
+      spv::Op::OpFNegate,
+      spv::Op::OpFmaKHR,
+      spv::Op::OpUDiv,
+      spv::Op::OpUMod,
+      spv::Op::OpISub,
+      spv::Op::OpIAdd,
+      spv::Op::OpIMul,
+      spv::Op::OpSDiv,
+      spv::Op::OpSMod,
+      spv::Op::OpSRem,
+      spv::Op::OpSNegate,
+      spv::Op::OpDot,
+      spv::Op::OpVectorTimesScalar,
+      spv::Op::OpMatrixTimesScalar,
+      spv::Op::OpVectorTimesMatrix,
+      spv::Op::OpMatrixTimesVector,
+      spv::Op::OpMatrixTimesMatrix,
+      spv::Op::OpOuterProduct,
+      spv::Op::OpIAddCarry,
+      spv::Op::OpISubBorrow,
+      spv::Op::OpUMulExtended,
+      spv::Op::OpSMulExtended,
+      spv::Op::OpCooperativeMatrixMulAddNV,
+      spv::Op::OpCooperativeMatrixMulAddKHR,
+      spv::Op::OpCooperativeMatrixReduceNV,
+      spv::Op::OpSpecConstantOp,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
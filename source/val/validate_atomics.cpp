@@ -437,5 +437,31 @@ spv_result_t AtomicsPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> AtomicsPassOpcodes() {
+  return {
+      spv::Op::OpAtomicLoad,
+      spv::Op::OpAtomicStore,
+      spv::Op::OpAtomicExchange,
+      spv::Op::OpAtomicFAddEXT,
+      spv::Op::OpAtomicCompareExchange,
+      spv::Op::OpAtomicCompareExchangeWeak,
+      spv::Op::OpAtomicIIncrement,
+      spv::Op::OpAtomicIDecrement,
+      spv::Op::OpAtomicIAdd,
+      spv::Op::OpAtomicISub,
+      spv::Op::OpAtomicSMin,
+      spv::Op::OpAtomicUMin,
+      spv::Op::OpAtomicFMinEXT,
+      spv::Op::OpAtomicSMax,
+      spv::Op::OpAtomicUMax,
+      spv::Op::OpAtomicFMaxEXT,
+      spv::Op::OpAtomicAnd,
+      spv::Op::OpAtomicOr,
+      spv::Op::OpAtomicXor,
+      spv::Op::OpAtomicFlagTestAndSet,
+      spv::Op::OpAtomicFlagClear,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -129,5 +129,14 @@ spv_result_t BarriersPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> BarriersPassOpcodes() {
+  return {
+      spv::Op::OpControlBarrier,
+      spv::Op::OpMemoryBarrier,
+      spv::Op::OpNamedBarrierInitialize,
+      spv::Op::OpMemoryNamedBarrier,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
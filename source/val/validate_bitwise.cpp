@@ -272,5 +272,23 @@ spv_result_t BitwisePass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> BitwisePassOpcodes() {
+  return {
+      spv::Op::OpShiftRightLogical,
+      spv::Op::OpShiftRightArithmetic,
+      spv::Op::OpShiftLeftLogical,
+      spv::Op::OpBitwiseOr,
+      spv::Op::OpBitwiseXor,
+      spv::Op::OpBitwiseAnd,
+      spv::Op::OpNot,
+      spv::Op::OpBitFieldInsert,
+      spv::Op::OpBitFieldSExtract,
+      spv::Op::OpBitFieldUExtract,
+      spv::Op::OpBitReverse,
+      spv::Op::OpBitCount,
+      spv::Op::OpSpecConstantOp,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
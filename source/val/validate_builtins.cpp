@@ -5103,17 +5103,11 @@ spv_result_t BuiltInsValidator::ValidateSingleBuiltInAtDefinitionVulkan(
 }
 
 spv_result_t BuiltInsValidator::ValidateBuiltInsAtDefinition() {
-  for (const auto& kv : _.id_decorations()) {
-    const uint32_t id = kv.first;
-    const auto& decorations = kv.second;
-    if (decorations.empty()) {
-      continue;
-    }
-
+  for (const uint32_t id : _.decorated_ids()) {
     const Instruction* inst = _.FindDef(id);
     assert(inst);
 
-    for (const auto& decoration : kv.second) {
+    for (const auto& decoration : _.id_decorations(id)) {
       if (decoration.dec_type() != spv::Decoration::BuiltIn) {
         continue;
       }
@@ -1308,5 +1308,18 @@ spv_result_t ControlFlowPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> ControlFlowPassOpcodes() {
+  return {
+      spv::Op::OpPhi,
+      spv::Op::OpBranch,
+      spv::Op::OpBranchConditional,
+      spv::Op::OpReturnValue,
+      spv::Op::OpSwitch,
+      spv::Op::OpLoopMerge,
+      spv::Op::OpLifetimeStart,
+      spv::Op::OpLifetimeStop,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
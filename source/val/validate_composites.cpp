@@ -1194,5 +1194,24 @@ spv_result_t CompositesPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> CompositesPassOpcodes() {
+  return {
+      spv::Op::OpVectorExtractDynamic,
+      spv::Op::OpVectorInsertDynamic,
+      spv::Op::OpVectorShuffle,
+      spv::Op::OpCompositeConstruct,
+      spv::Op::OpCompositeConstructReplicateEXT,
+      spv::Op::OpCompositeExtract,
+      spv::Op::OpCompositeInsert,
+      spv::Op::OpCopyObject,
+      spv::Op::OpTranspose,
+      spv::Op::OpCopyLogical,
+      spv::Op::OpCompositeConstructCoopMatQCOM,
+      spv::Op::OpCompositeExtractCoopMatQCOM,
+      spv::Op::OpExtractSubArrayQCOM,
+      spv::Op::OpSpecConstantOp,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -967,5 +967,31 @@ spv_result_t ConversionPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> ConversionPassOpcodes() {
+  return {
+      spv::Op::OpConvertFToU,
+      spv::Op::OpConvertFToS,
+      spv::Op::OpConvertSToF,
+      spv::Op::OpConvertUToF,
+      spv::Op::OpUConvert,
+      spv::Op::OpSConvert,
+      spv::Op::OpFConvert,
+      spv::Op::OpQuantizeToF16,
+      spv::Op::OpConvertPtrToU,
+      spv::Op::OpSatConvertSToU,
+      spv::Op::OpSatConvertUToS,
+      spv::Op::OpConvertUToPtr,
+      spv::Op::OpPtrCastToGeneric,
+      spv::Op::OpGenericCastToPtr,
+      spv::Op::OpGenericCastToPtrExplicit,
+      spv::Op::OpBitcast,
+      spv::Op::OpConvertUToAccelerationStructureKHR,
+      spv::Op::OpCooperativeMatrixConvertNV,
+      spv::Op::OpCooperativeMatrixTransposeNV,
+      spv::Op::OpBitCastArrayQCOM,
+      spv::Op::OpSpecConstantOp,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
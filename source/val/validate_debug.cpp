@@ -68,5 +68,12 @@ spv_result_t DebugPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> DebugPassOpcodes() {
+  return {
+      spv::Op::OpMemberName,
+      spv::Op::OpLine,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -61,6 +61,50 @@ struct LayoutConstraints {
 using MemberConstraints = std::unordered_map<std::pair<uint32_t, uint32_t>,
                                              LayoutConstraints, PairHash>;
 
+using LayoutQuery = ValidationState_t::LayoutQuery;
+using LayoutQueryKind = ValidationState_t::LayoutQueryKind;
+
+// Load |constraints| with all the member constraints for the given struct,
+// and all its contained structs.
+void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
+                                       uint32_t struct_id,
+                                       const LayoutConstraints& inherited,
+                                       ValidationState_t& vstate);
+
+// Returns the layout constraints of member |member_idx| of |struct_id|,
+// loading |constraints| for the struct first if needed.  Ids that are not
+// structs, and member indices that are out of range, have the default
+// constraints.
+LayoutConstraints getMemberConstraints(uint32_t struct_id, uint32_t member_idx,
+                                       MemberConstraints& constraints,
+                                       ValidationState_t& vstate) {
+  const auto key = std::make_pair(struct_id, member_idx);
+  auto it = constraints.find(key);
+  if (it == constraints.end()) {
+    if (spv::Op::OpTypeStruct != vstate.FindDef(struct_id)->opcode()) {
+      return LayoutConstraints();
+    }
+    ComputeMemberConstraintsForStruct(&constraints, struct_id,
+                                      LayoutConstraints(), vstate);
+    it = constraints.find(key);
+    if (it == constraints.end()) return LayoutConstraints();
+  }
+  return it->second;
+}
+
+// Returns the key under which the result of the |kind| query for |type_id|
+// is memoized.  Member constraints are always derived from the default
+// constraints, so the layout of a struct does not depend on |inherited|.
+LayoutQuery getLayoutQuery(LayoutQueryKind kind, uint32_t type_id,
+                           const LayoutConstraints& inherited,
+                           ValidationState_t& vstate) {
+  if (spv::Op::OpTypeStruct == vstate.FindDef(type_id)->opcode()) {
+    return {kind, type_id, uint32_t(kColumnMajor), 0};
+  }
+  return {kind, type_id, uint32_t(inherited.majorness),
+          inherited.matrix_stride};
+}
+
 // Returns the array stride of the given array type.
 uint32_t GetArrayStride(uint32_t array_id, ValidationState_t& vstate) {
   for (auto& decoration : vstate.id_decorations(array_id)) {
@@ -157,10 +201,17 @@ uint32_t align(uint32_t x, uint32_t alignment) {
 // ensure that structs, arrays, and matrices are aligned at least to a
 // multiple of 16 bytes.  (That is, when roundUp is true, this function
 // returns the *extended* alignment as it's called by the Vulkan spec.)
+// Results are memoized in |vstate|.
 uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
                           const LayoutConstraints& inherited,
                           MemberConstraints& constraints,
-                          ValidationState_t& vstate) {
+                          ValidationState_t& vstate);
+
+// Computes the base alignment of struct member, see getBaseAlignment.
+uint32_t computeBaseAlignment(uint32_t member_id, bool roundUp,
+                              const LayoutConstraints& inherited,
+                              MemberConstraints& constraints,
+                              ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   // Minimal alignment is byte-aligned.
@@ -231,8 +282,8 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
       for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
            memberIdx < numMembers; ++memberIdx) {
         const auto id = members[memberIdx];
-        const auto& constraint =
-            constraints[std::make_pair(member_id, memberIdx)];
+        const auto constraint =
+            getMemberConstraints(member_id, memberIdx, constraints, vstate);
         baseAlignment = std::max(
             baseAlignment,
             getBaseAlignment(id, roundUp, constraint, constraints, vstate));
@@ -252,8 +303,27 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
   return baseAlignment;
 }
 
-// Returns scalar alignment of a type.
-uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
+uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
+                          const LayoutConstraints& inherited,
+                          MemberConstraints& constraints,
+                          ValidationState_t& vstate) {
+  const auto kind = roundUp ? LayoutQueryKind::kExtendedAlignment
+                            : LayoutQueryKind::kBaseAlignment;
+  const auto query = getLayoutQuery(kind, member_id, inherited, vstate);
+  if (const uint32_t* cached = vstate.GetLayoutQueryResult(query)) {
+    return *cached;
+  }
+  const uint32_t alignment =
+      computeBaseAlignment(member_id, roundUp, inherited, constraints, vstate);
+  vstate.SetLayoutQueryResult(query, alignment);
+  return alignment;
+}
+
+// Returns scalar alignment of a type.  Results are memoized in |vstate|.
+uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate);
+
+// Computes the scalar alignment of a type, see getScalarAlignment.
+uint32_t computeScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(type_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -303,10 +373,26 @@ uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
   return 1;
 }
 
+uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
+  const LayoutQuery query{LayoutQueryKind::kScalarAlignment, type_id, 0, 0};
+  if (const uint32_t* cached = vstate.GetLayoutQueryResult(query)) {
+    return *cached;
+  }
+  const uint32_t alignment = computeScalarAlignment(type_id, vstate);
+  vstate.SetLayoutQueryResult(query, alignment);
+  return alignment;
+}
+
 // Returns size of a struct member. Doesn't include padding at the end of struct
 // or array.  Assumes that in the struct case, all members have offsets.
+// Results are memoized in |vstate|.
 uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
-                 MemberConstraints& constraints, ValidationState_t& vstate) {
+                 MemberConstraints& constraints, ValidationState_t& vstate);
+
+// Computes the size of a struct member, see getSize.
+uint32_t computeSize(uint32_t member_id, const LayoutConstraints& inherited,
+                     MemberConstraints& constraints,
+                     ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -392,7 +478,8 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
       // This check depends on the fact that all members have offsets.  This
       // has been checked earlier in the flow.
       assert(offset != 0xffffffff);
-      const auto& constraint = constraints[std::make_pair(lastMember, lastIdx)];
+      const auto constraint =
+          getMemberConstraints(lastMember, lastIdx, constraints, vstate);
       return offset + getSize(lastMember, constraint, constraints, vstate);
     }
     case spv::Op::OpTypePointer:
@@ -404,6 +491,18 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
   }
 }
 
+uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
+                 MemberConstraints& constraints, ValidationState_t& vstate) {
+  const auto query =
+      getLayoutQuery(LayoutQueryKind::kSize, member_id, inherited, vstate);
+  if (const uint32_t* cached = vstate.GetLayoutQueryResult(query)) {
+    return *cached;
+  }
+  const uint32_t size = computeSize(member_id, inherited, constraints, vstate);
+  vstate.SetLayoutQueryResult(query, size);
+  return size;
+}
+
 // A member is defined to improperly straddle if either of the following are
 // true:
 // - It is a vector with total size less than or equal to 16 bytes, and has
@@ -442,12 +541,22 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
                          bool scalar_block_layout, uint32_t incoming_offset,
                          MemberConstraints& constraints,
                          ValidationState_t& vstate) {
-  if (vstate.options()->skip_block_layout) return SPV_SUCCESS;
+  if (vstate.options()->skip_block_layout || vstate.IsFastValidation()) {
+    return SPV_SUCCESS;
+  }
 
   // blockRules are the same as bufferBlock rules if the uniform buffer
   // standard layout extension is being used.
   if (vstate.options()->uniform_buffer_standard_layout) blockRules = false;
 
+  // The outcome of the checks below only depends on the rules and on the
+  // offset of the struct, so each struct only needs to pass once for them.
+  const LayoutQuery checked_query{
+      LayoutQueryKind::kCheckedLayout, struct_id,
+      uint32_t(blockRules) | (uint32_t(scalar_block_layout) << 1),
+      incoming_offset};
+  if (vstate.GetLayoutQueryResult(checked_query)) return SPV_SUCCESS;
+
   // Relaxed layout and scalar layout can both be in effect at the same time.
   // For example, relaxed layout is implied by Vulkan 1.1.  But scalar layout
   // is more permissive than relaxed layout.
@@ -554,8 +663,8 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
     const auto memberIdx = member_offset.member;
     const auto offset = member_offset.offset;
     auto id = members[member_offset.member];
-    const LayoutConstraints& constraint =
-        constraints[std::make_pair(struct_id, uint32_t(memberIdx))];
+    const auto constraint =
+        getMemberConstraints(struct_id, memberIdx, constraints, vstate);
     // Scalar layout takes precedence because it's more permissive, and implying
     // an alignment that divides evenly into the alignment that would otherwise
     // be used.
@@ -713,6 +822,7 @@ spv_result_t checkLayout(uint32_t struct_id, spv::StorageClass storage_class,
       nextValidOffset = align(nextValidOffset, alignment);
     }
   }
+  vstate.SetLayoutQueryResult(checked_query, 1);
   return SPV_SUCCESS;
 }
 
@@ -1126,8 +1236,6 @@ void ComputeMemberConstraintsForArray(MemberConstraints* constraints,
                                       const LayoutConstraints& inherited,
                                       ValidationState_t& vstate);
 
-// Load |constraints| with all the member constraints for the given struct,
-// and all its contained structs.
 void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
                                        uint32_t struct_id,
                                        const LayoutConstraints& inherited,
@@ -1258,12 +1366,14 @@ spv_result_t CheckDecorationsOfVariables(ValidationState_t& vstate) {
 spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
   // Set of entry points that are known to use a push constant.
   std::unordered_set<uint32_t> uses_push_constant;
+  // Member constraints only depend on the decorations of the structs, so they
+  // are shared by all the buffers and loaded lazily by the layout checks.
+  MemberConstraints constraints;
   for (const auto& inst : vstate.ordered_instructions()) {
     const auto& words = inst.words();
     auto type_id = inst.type_id();
     const Instruction* type_inst = vstate.FindDef(type_id);
     bool scalar_block_layout = false;
-    MemberConstraints constraints;
     if (spv::Op::OpVariable == inst.opcode() ||
         spv::Op::OpUntypedVariableKHR == inst.opcode()) {
       const bool untyped_pointer =
@@ -1360,8 +1470,6 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
           }
           // Struct requirement is checked on variables so just move on here.
           if (spv::Op::OpTypeStruct != id_inst->opcode()) continue;
-          ComputeMemberConstraintsForStruct(&constraints, id,
-                                            LayoutConstraints(), vstate);
         }
 
         if (spvIsVulkanEnv(vstate.context()->target_env)) {
@@ -1499,12 +1607,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
                    spv::StorageClass::PhysicalStorageBuffer) {
       const bool buffer = true;
       const auto pointee_type_id = type_inst->GetOperandAs<uint32_t>(2u);
-      const auto* data_type_inst = vstate.FindDef(pointee_type_id);
       scalar_block_layout = vstate.options()->scalar_block_layout;
-      if (data_type_inst->opcode() == spv::Op::OpTypeStruct) {
-        ComputeMemberConstraintsForStruct(&constraints, pointee_type_id,
-                                          LayoutConstraints(), vstate);
-      }
       if (auto res = checkLayout(
               pointee_type_id, spv::StorageClass::PhysicalStorageBuffer,
               "Block", !buffer, scalar_block_layout, 0, constraints, vstate)) {
@@ -1582,13 +1685,10 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
       // Assume uniform storage class uses block rules unless we see a
       // BufferBlock decorated struct in the data type.
       bool bufferRules = sc == spv::StorageClass::Uniform ? false : true;
-      if (data_type->opcode() == spv::Op::OpTypeStruct) {
-        if (sc == spv::StorageClass::Uniform) {
-          bufferRules =
-              vstate.HasDecoration(data_type_id, spv::Decoration::BufferBlock);
-        }
-        ComputeMemberConstraintsForStruct(&constraints, data_type_id,
-                                          LayoutConstraints(), vstate);
+      if (sc == spv::StorageClass::Uniform &&
+          data_type->opcode() == spv::Op::OpTypeStruct) {
+        bufferRules =
+            vstate.HasDecoration(data_type_id, spv::Decoration::BufferBlock);
       }
       const char* deco_str =
           bufferRules
@@ -2173,11 +2273,8 @@ spv_result_t CheckDecorationsFromDecoration(ValidationState_t& vstate) {
   const bool is_shader = vstate.HasCapability(spv::Capability::Shader);
   const bool is_kernel = vstate.HasCapability(spv::Capability::Kernel);
 
-  for (const auto& kv : vstate.id_decorations()) {
-    const uint32_t id = kv.first;
-    const auto& decorations = kv.second;
-    if (decorations.empty()) continue;
-
+  for (const uint32_t id : vstate.decorated_ids()) {
+    const auto decorations = vstate.id_decorations(id);
     const Instruction* inst = vstate.FindDef(id);
     assert(inst);
 
@@ -2277,9 +2374,8 @@ spv::Decoration UsesExplicitLayout(
       type_inst->opcode() == spv::Op::OpTypeRuntimeArray ||
       type_inst->opcode() == spv::Op::OpTypePointer ||
       type_inst->opcode() == spv::Op::OpTypeUntypedPointerKHR) {
-    const auto& id_decs = vstate.id_decorations();
-    const auto iter = id_decs.find(type_id);
-    if (iter != id_decs.end()) {
+    const auto decorations = vstate.id_decorations(type_id);
+    if (!decorations.empty()) {
       bool allowLayoutDecorations = false;
       if (type_inst->opcode() == spv::Op::OpTypePointer ||
           type_inst->opcode() == spv::Op::OpTypeUntypedPointerKHR) {
@@ -2287,7 +2383,7 @@ spv::Decoration UsesExplicitLayout(
         allowLayoutDecorations = AllowsLayout(vstate, sc);
       }
       if (!allowLayoutDecorations) {
-        for (const auto& d : iter->second) {
+        for (const auto& d : decorations) {
           const spv::Decoration dec = d.dec_type();
           if (dec == spv::Decoration::Block ||
               dec == spv::Decoration::BufferBlock ||
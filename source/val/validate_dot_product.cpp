@@ -403,5 +403,19 @@ spv_result_t DotProductPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> DotProductPassOpcodes() {
+  return {
+      spv::Op::OpSDot,
+      spv::Op::OpUDot,
+      spv::Op::OpSUDot,
+      spv::Op::OpSDotAccSat,
+      spv::Op::OpUDotAccSat,
+      spv::Op::OpSUDotAccSat,
+      spv::Op::OpFDot2MixAcc32VALVE,
+      spv::Op::OpFDot2MixAcc16VALVE,
+      spv::Op::OpFDot4MixAcc32VALVE,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -403,5 +403,14 @@ spv_result_t FunctionPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> FunctionPassOpcodes() {
+  return {
+      spv::Op::OpFunction,
+      spv::Op::OpFunctionParameter,
+      spv::Op::OpFunctionCall,
+      spv::Op::OpCooperativeMatrixPerElementOpNV,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -543,5 +543,17 @@ spv_result_t GraphPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> GraphPassOpcodes() {
+  return {
+      spv::Op::OpTypeGraphARM,
+      spv::Op::OpGraphConstantARM,
+      spv::Op::OpGraphEntryPointARM,
+      spv::Op::OpGraphARM,
+      spv::Op::OpGraphInputARM,
+      spv::Op::OpGraphSetOutputARM,
+      spv::Op::OpGraphEndARM,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
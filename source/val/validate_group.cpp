@@ -225,5 +225,23 @@ spv_result_t GroupPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> GroupPassOpcodes() {
+  return {
+      spv::Op::OpGroupAny,
+      spv::Op::OpGroupAll,
+      spv::Op::OpGroupBroadcast,
+      spv::Op::OpGroupFAdd,
+      spv::Op::OpGroupFMax,
+      spv::Op::OpGroupFMin,
+      spv::Op::OpGroupIAdd,
+      spv::Op::OpGroupUMin,
+      spv::Op::OpGroupSMin,
+      spv::Op::OpGroupUMax,
+      spv::Op::OpGroupSMax,
+      spv::Op::OpGroupAsyncCopy,
+      spv::Op::OpGroupWaitEvents,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
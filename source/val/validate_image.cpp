@@ -2747,6 +2747,61 @@ spv_result_t ImagePass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> ImagePassOpcodes() {
+  return {
+      spv::Op::OpTypeImage,
+      spv::Op::OpTypeSampledImage,
+      spv::Op::OpSampledImage,
+      spv::Op::OpImageTexelPointer,
+      spv::Op::OpUntypedImageTexelPointerEXT,
+      spv::Op::OpImageSampleImplicitLod,
+      spv::Op::OpImageSampleExplicitLod,
+      spv::Op::OpImageSampleProjImplicitLod,
+      spv::Op::OpImageSampleProjExplicitLod,
+      spv::Op::OpImageSparseSampleImplicitLod,
+      spv::Op::OpImageSparseSampleExplicitLod,
+      spv::Op::OpImageSampleDrefImplicitLod,
+      spv::Op::OpImageSampleDrefExplicitLod,
+      spv::Op::OpImageSampleProjDrefImplicitLod,
+      spv::Op::OpImageSampleProjDrefExplicitLod,
+      spv::Op::OpImageSparseSampleDrefImplicitLod,
+      spv::Op::OpImageSparseSampleDrefExplicitLod,
+      spv::Op::OpImageFetch,
+      spv::Op::OpImageSparseFetch,
+      spv::Op::OpImageGather,
+      spv::Op::OpImageDrefGather,
+      spv::Op::OpImageSparseGather,
+      spv::Op::OpImageSparseDrefGather,
+      spv::Op::OpImageRead,
+      spv::Op::OpImageSparseRead,
+      spv::Op::OpImageWrite,
+      spv::Op::OpImage,
+      spv::Op::OpImageQueryFormat,
+      spv::Op::OpImageQueryOrder,
+      spv::Op::OpImageQuerySizeLod,
+      spv::Op::OpImageQuerySize,
+      spv::Op::OpImageQueryLod,
+      spv::Op::OpImageQueryLevels,
+      spv::Op::OpImageQuerySamples,
+      spv::Op::OpImageSparseSampleProjImplicitLod,
+      spv::Op::OpImageSparseSampleProjExplicitLod,
+      spv::Op::OpImageSparseSampleProjDrefImplicitLod,
+      spv::Op::OpImageSparseSampleProjDrefExplicitLod,
+      spv::Op::OpImageSparseTexelsResident,
+      spv::Op::OpImageSampleWeightedQCOM,
+      spv::Op::OpImageBoxFilterQCOM,
+      spv::Op::OpImageBlockMatchSSDQCOM,
+      spv::Op::OpImageBlockMatchSADQCOM,
+      spv::Op::OpImageBlockMatchWindowSADQCOM,
+      spv::Op::OpImageBlockMatchWindowSSDQCOM,
+      spv::Op::OpImageBlockMatchGatherSADQCOM,
+      spv::Op::OpImageBlockMatchGatherSSDQCOM,
+      spv::Op::OpColorAttachmentReadEXT,
+      spv::Op::OpDepthAttachmentReadEXT,
+      spv::Op::OpStencilAttachmentReadEXT,
+  };
+}
+
 bool IsImageInstruction(const spv::Op opcode) {
   switch (opcode) {
     case spv::Op::OpImageSampleImplicitLod:
@@ -173,5 +173,67 @@ spv_result_t InvalidTypePass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> InvalidTypePassOpcodes() {
+  return {
+      spv::Op::OpExtInst,
+      spv::Op::OpFAdd,
+      spv::Op::OpFSub,
+      spv::Op::OpFMul,
+      spv::Op::OpFDiv,
+      spv::Op::OpFRem,
+      spv::Op::OpFMod,
+      spv::Op::OpFNegate,
+      spv::Op::OpDPdx,
+      spv::Op::OpDPdy,
+      spv::Op::OpFwidth,
+      spv::Op::OpDPdxFine,
+      spv::Op::OpDPdyFine,
+      spv::Op::OpFwidthFine,
+      spv::Op::OpDPdxCoarse,
+      spv::Op::OpDPdyCoarse,
+      spv::Op::OpFwidthCoarse,
+      spv::Op::OpAtomicFAddEXT,
+      spv::Op::OpAtomicFMinEXT,
+      spv::Op::OpAtomicFMaxEXT,
+      spv::Op::OpAtomicLoad,
+      spv::Op::OpAtomicExchange,
+      spv::Op::OpGroupNonUniformRotateKHR,
+      spv::Op::OpGroupNonUniformBroadcast,
+      spv::Op::OpGroupNonUniformShuffle,
+      spv::Op::OpGroupNonUniformShuffleXor,
+      spv::Op::OpGroupNonUniformShuffleUp,
+      spv::Op::OpGroupNonUniformShuffleDown,
+      spv::Op::OpGroupNonUniformQuadBroadcast,
+      spv::Op::OpGroupNonUniformQuadSwap,
+      spv::Op::OpGroupNonUniformBroadcastFirst,
+      spv::Op::OpGroupNonUniformFAdd,
+      spv::Op::OpGroupNonUniformFMul,
+      spv::Op::OpGroupNonUniformFMin,
+      spv::Op::OpAtomicStore,
+      spv::Op::OpIsNan,
+      spv::Op::OpIsInf,
+      spv::Op::OpIsFinite,
+      spv::Op::OpIsNormal,
+      spv::Op::OpFOrdEqual,
+      spv::Op::OpFUnordEqual,
+      spv::Op::OpFOrdNotEqual,
+      spv::Op::OpFUnordNotEqual,
+      spv::Op::OpFOrdLessThan,
+      spv::Op::OpFUnordLessThan,
+      spv::Op::OpFOrdGreaterThan,
+      spv::Op::OpFUnordGreaterThan,
+      spv::Op::OpFOrdLessThanEqual,
+      spv::Op::OpFUnordLessThanEqual,
+      spv::Op::OpFOrdGreaterThanEqual,
+      spv::Op::OpFUnordGreaterThanEqual,
+      spv::Op::OpLessOrGreater,
+      spv::Op::OpOrdered,
+      spv::Op::OpUnordered,
+      spv::Op::OpSignBitSet,
+      spv::Op::OpGroupNonUniformAllEqual,
+      spv::Op::OpMatrixTimesMatrix,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
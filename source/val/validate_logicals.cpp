@@ -346,5 +346,49 @@ spv_result_t LogicalsPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> LogicalsPassOpcodes() {
+  return {
+      spv::Op::OpAny,
+      spv::Op::OpAll,
+      spv::Op::OpIsNan,
+      spv::Op::OpIsInf,
+      spv::Op::OpIsFinite,
+      spv::Op::OpIsNormal,
+      spv::Op::OpSignBitSet,
+      spv::Op::OpFOrdEqual,
+      spv::Op::OpFUnordEqual,
+      spv::Op::OpFOrdNotEqual,
+      spv::Op::OpFUnordNotEqual,
+      spv::Op::OpFOrdLessThan,
+      spv::Op::OpFUnordLessThan,
+      spv::Op::OpFOrdGreaterThan,
+      spv::Op::OpFUnordGreaterThan,
+      spv::Op::OpFOrdLessThanEqual,
+      spv::Op::OpFUnordLessThanEqual,
+      spv::Op::OpFOrdGreaterThanEqual,
+      spv::Op::OpFUnordGreaterThanEqual,
+      spv::Op::OpLessOrGreater,
+      spv::Op::OpOrdered,
+      spv::Op::OpUnordered,
+      spv::Op::OpLogicalEqual,
+      spv::Op::OpLogicalNotEqual,
+      spv::Op::OpLogicalOr,
+      spv::Op::OpLogicalAnd,
+      spv::Op::OpLogicalNot,
+      spv::Op::OpSelect,
+      spv::Op::OpIEqual,
+      spv::Op::OpINotEqual,
+      spv::Op::OpUGreaterThan,
+      spv::Op::OpUGreaterThanEqual,
+      spv::Op::OpULessThan,
+      spv::Op::OpULessThanEqual,
+      spv::Op::OpSGreaterThan,
+      spv::Op::OpSGreaterThanEqual,
+      spv::Op::OpSLessThan,
+      spv::Op::OpSLessThanEqual,
+      spv::Op::OpSpecConstantOp,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -37,8 +37,8 @@ bool HaveLayoutCompatibleMembers(ValidationState_t&, const Instruction*,
                                  const Instruction*);
 bool HaveSameLayoutDecorations(ValidationState_t&, const Instruction*,
                                const Instruction*);
-bool HasConflictingMemberOffsets(const std::set<Decoration>&,
-                                 const std::set<Decoration>&);
+bool HasConflictingMemberOffsets(const ValidationState_t::DecorationSpan&,
+                                 const ValidationState_t::DecorationSpan&);
 
 bool IsAllowedTypeOrArrayOfSame(ValidationState_t& _, const Instruction& type,
                                 std::initializer_list<spv::Op> allowed) {
@@ -107,8 +107,8 @@ bool HaveSameLayoutDecorations(ValidationState_t& _, const Instruction* type1,
          "type1 must be an OpTypeStruct instruction.");
   assert(type2->opcode() == spv::Op::OpTypeStruct &&
          "type2 must be an OpTypeStruct instruction.");
-  const std::set<Decoration>& type1_decorations = _.id_decorations(type1->id());
-  const std::set<Decoration>& type2_decorations = _.id_decorations(type2->id());
+  const auto type1_decorations = _.id_decorations(type1->id());
+  const auto type2_decorations = _.id_decorations(type2->id());
 
   // TODO: Will have to add other check for arrays an matricies if we want to
   // handle them.
@@ -120,8 +120,8 @@ bool HaveSameLayoutDecorations(ValidationState_t& _, const Instruction* type1,
 }
 
 bool HasConflictingMemberOffsets(
-    const std::set<Decoration>& type1_decorations,
-    const std::set<Decoration>& type2_decorations) {
+    const ValidationState_t::DecorationSpan& type1_decorations,
+    const ValidationState_t::DecorationSpan& type2_decorations) {
   {
     // We are interested in conflicting decoration.  If a decoration is in one
     // list but not the other, then we will assume the code is correct.  We are
@@ -3710,5 +3710,50 @@ spv_result_t MemoryPass(ValidationState_t& _, const Instruction* inst) {
 
   return SPV_SUCCESS;
 }
+
+std::vector<spv::Op> MemoryPassOpcodes() {
+  return {
+      spv::Op::OpVariable,
+      spv::Op::OpUntypedVariableKHR,
+      spv::Op::OpBufferPointerEXT,
+      spv::Op::OpLoad,
+      spv::Op::OpStore,
+      spv::Op::OpCopyMemory,
+      spv::Op::OpCopyMemorySized,
+      spv::Op::OpPtrAccessChain,
+      spv::Op::OpUntypedPtrAccessChainKHR,
+      spv::Op::OpUntypedInBoundsPtrAccessChainKHR,
+      spv::Op::OpAccessChain,
+      spv::Op::OpInBoundsAccessChain,
+      spv::Op::OpInBoundsPtrAccessChain,
+      spv::Op::OpUntypedAccessChainKHR,
+      spv::Op::OpUntypedInBoundsAccessChainKHR,
+      spv::Op::OpRawAccessChainNV,
+      spv::Op::OpArrayLength,
+      spv::Op::OpUntypedArrayLengthKHR,
+      spv::Op::OpCooperativeMatrixLoadNV,
+      spv::Op::OpCooperativeMatrixStoreNV,
+      spv::Op::OpCooperativeMatrixLengthKHR,
+      spv::Op::OpCooperativeMatrixLengthNV,
+      spv::Op::OpCooperativeMatrixLoadKHR,
+      spv::Op::OpCooperativeMatrixStoreKHR,
+      spv::Op::OpCooperativeMatrixLoadTensorNV,
+      spv::Op::OpCooperativeMatrixStoreTensorNV,
+      spv::Op::OpCooperativeVectorLoadNV,
+      spv::Op::OpCooperativeVectorStoreNV,
+      spv::Op::OpCooperativeVectorOuterProductAccumulateNV,
+      spv::Op::OpCooperativeVectorReduceSumAccumulateNV,
+      spv::Op::OpCooperativeVectorMatrixMulNV,
+      spv::Op::OpCooperativeVectorMatrixMulAddNV,
+      spv::Op::OpPredicatedLoadINTEL,
+      spv::Op::OpPredicatedStoreINTEL,
+      spv::Op::OpPtrEqual,
+      spv::Op::OpPtrNotEqual,
+      spv::Op::OpPtrDiff,
+      spv::Op::OpImageTexelPointer,
+      spv::Op::OpGenericPtrMemSemantics,
+      spv::Op::OpSpecConstantOp,
+  };
+}
 }  // namespace val
 }  // namespace spvtools
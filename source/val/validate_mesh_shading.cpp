@@ -234,5 +234,14 @@ spv_result_t MeshShadingPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> MeshShadingPassOpcodes() {
+  return {
+      spv::Op::OpEmitMeshTasksEXT,
+      spv::Op::OpSetMeshOutputsEXT,
+      spv::Op::OpVariable,
+      spv::Op::OpWritePackedPrimitiveIndices4x8NV,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -230,5 +230,19 @@ spv_result_t MiscPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> MiscPassOpcodes() {
+  return {
+      spv::Op::OpUndef,
+      spv::Op::OpBeginInvocationInterlockEXT,
+      spv::Op::OpEndInvocationInterlockEXT,
+      spv::Op::OpDemoteToHelperInvocationEXT,
+      spv::Op::OpIsHelperInvocationEXT,
+      spv::Op::OpReadClockKHR,
+      spv::Op::OpAssumeTrueKHR,
+      spv::Op::OpExpectKHR,
+      spv::Op::OpAbortKHR,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
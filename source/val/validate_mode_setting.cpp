@@ -1093,6 +1093,16 @@ spv_result_t ModeSettingPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> ModeSettingPassOpcodes() {
+  return {
+      spv::Op::OpEntryPoint,
+      spv::Op::OpExecutionMode,
+      spv::Op::OpExecutionModeId,
+      spv::Op::OpMemoryModel,
+      spv::Op::OpCapability,
+  };
+}
+
 spv_result_t ValidateDuplicateExecutionModes(ValidationState_t& _) {
   using PerEntryKey = std::tuple<spv::ExecutionMode, uint32_t>;
   using PerOperandKey = std::tuple<spv::ExecutionMode, uint32_t, uint32_t>;
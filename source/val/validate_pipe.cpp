@@ -349,5 +349,27 @@ spv_result_t PipePass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> PipePassOpcodes() {
+  return {
+      spv::Op::OpReadPipe,
+      spv::Op::OpWritePipe,
+      spv::Op::OpReservedReadPipe,
+      spv::Op::OpReservedWritePipe,
+      spv::Op::OpReserveReadPipePackets,
+      spv::Op::OpReserveWritePipePackets,
+      spv::Op::OpGroupReserveReadPipePackets,
+      spv::Op::OpGroupReserveWritePipePackets,
+      spv::Op::OpCommitReadPipe,
+      spv::Op::OpCommitWritePipe,
+      spv::Op::OpGroupCommitReadPipe,
+      spv::Op::OpGroupCommitWritePipe,
+      spv::Op::OpGetNumPipePackets,
+      spv::Op::OpGetMaxPipePackets,
+      spv::Op::OpIsValidReserveId,
+      spv::Op::OpCreatePipeFromPipeStorage,
+      spv::Op::OpConstantPipeStorage,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -69,5 +69,14 @@ spv_result_t PrimitivesPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> PrimitivesPassOpcodes() {
+  return {
+      spv::Op::OpEmitVertex,
+      spv::Op::OpEndPrimitive,
+      spv::Op::OpEmitStreamVertex,
+      spv::Op::OpEndStreamPrimitive,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
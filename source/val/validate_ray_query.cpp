@@ -381,5 +381,43 @@ spv_result_t RayQueryPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> RayQueryPassOpcodes() {
+  return {
+      spv::Op::OpRayQueryInitializeKHR,
+      spv::Op::OpRayQueryTerminateKHR,
+      spv::Op::OpRayQueryConfirmIntersectionKHR,
+      spv::Op::OpRayQueryGenerateIntersectionKHR,
+      spv::Op::OpRayQueryGetIntersectionFrontFaceKHR,
+      spv::Op::OpRayQueryProceedKHR,
+      spv::Op::OpRayQueryGetIntersectionCandidateAABBOpaqueKHR,
+      spv::Op::OpRayQueryGetIntersectionTKHR,
+      spv::Op::OpRayQueryGetRayTMinKHR,
+      spv::Op::OpRayQueryGetIntersectionTypeKHR,
+      spv::Op::OpRayQueryGetIntersectionInstanceCustomIndexKHR,
+      spv::Op::OpRayQueryGetIntersectionInstanceIdKHR,
+      spv::Op::
+          OpRayQueryGetIntersectionInstanceShaderBindingTableRecordOffsetKHR,
+      spv::Op::OpRayQueryGetIntersectionGeometryIndexKHR,
+      spv::Op::OpRayQueryGetIntersectionPrimitiveIndexKHR,
+      spv::Op::OpRayQueryGetRayFlagsKHR,
+      spv::Op::OpRayQueryGetIntersectionObjectRayDirectionKHR,
+      spv::Op::OpRayQueryGetIntersectionObjectRayOriginKHR,
+      spv::Op::OpRayQueryGetWorldRayDirectionKHR,
+      spv::Op::OpRayQueryGetWorldRayOriginKHR,
+      spv::Op::OpRayQueryGetIntersectionBarycentricsKHR,
+      spv::Op::OpRayQueryGetIntersectionObjectToWorldKHR,
+      spv::Op::OpRayQueryGetIntersectionWorldToObjectKHR,
+      spv::Op::OpRayQueryGetClusterIdNV,
+      spv::Op::OpRayQueryGetIntersectionSpherePositionNV,
+      spv::Op::OpRayQueryGetIntersectionLSSPositionsNV,
+      spv::Op::OpRayQueryGetIntersectionLSSRadiiNV,
+      spv::Op::OpRayQueryGetIntersectionSphereRadiusNV,
+      spv::Op::OpRayQueryGetIntersectionLSSHitValueNV,
+      spv::Op::OpRayQueryIsSphereHitNV,
+      spv::Op::OpRayQueryIsLSSHitNV,
+      spv::Op::OpRayQueryGetIntersectionTriangleVertexPositionsKHR,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -210,5 +210,13 @@ spv_result_t RayTracingPass(ValidationState_t& _, const Instruction* inst) {
 
   return SPV_SUCCESS;
 }
+
+std::vector<spv::Op> RayTracingPassOpcodes() {
+  return {
+      spv::Op::OpTraceRayKHR,
+      spv::Op::OpReportIntersectionKHR,
+      spv::Op::OpExecuteCallableKHR,
+  };
+}
 }  // namespace val
 }  // namespace spvtools
@@ -758,6 +758,47 @@ spv_result_t RayReorderNVPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> RayReorderNVPassOpcodes() {
+  return {
+      spv::Op::OpHitObjectIsMissNV,
+      spv::Op::OpHitObjectIsHitNV,
+      spv::Op::OpHitObjectIsEmptyNV,
+      spv::Op::OpHitObjectGetShaderRecordBufferHandleNV,
+      spv::Op::OpHitObjectGetHitKindNV,
+      spv::Op::OpHitObjectGetPrimitiveIndexNV,
+      spv::Op::OpHitObjectGetGeometryIndexNV,
+      spv::Op::OpHitObjectGetInstanceIdNV,
+      spv::Op::OpHitObjectGetInstanceCustomIndexNV,
+      spv::Op::OpHitObjectGetShaderBindingTableRecordIndexNV,
+      spv::Op::OpHitObjectGetCurrentTimeNV,
+      spv::Op::OpHitObjectGetRayTMaxNV,
+      spv::Op::OpHitObjectGetRayTMinNV,
+      spv::Op::OpHitObjectGetObjectToWorldNV,
+      spv::Op::OpHitObjectGetWorldToObjectNV,
+      spv::Op::OpHitObjectGetObjectRayOriginNV,
+      spv::Op::OpHitObjectGetObjectRayDirectionNV,
+      spv::Op::OpHitObjectGetWorldRayDirectionNV,
+      spv::Op::OpHitObjectGetWorldRayOriginNV,
+      spv::Op::OpHitObjectGetAttributesNV,
+      spv::Op::OpHitObjectExecuteShaderNV,
+      spv::Op::OpHitObjectRecordEmptyNV,
+      spv::Op::OpHitObjectRecordMissNV,
+      spv::Op::OpHitObjectRecordHitWithIndexNV,
+      spv::Op::OpHitObjectRecordHitNV,
+      spv::Op::OpHitObjectTraceRayMotionNV,
+      spv::Op::OpHitObjectTraceRayNV,
+      spv::Op::OpReorderThreadWithHitObjectNV,
+      spv::Op::OpReorderThreadWithHintNV,
+      spv::Op::OpHitObjectGetClusterIdNV,
+      spv::Op::OpHitObjectGetSpherePositionNV,
+      spv::Op::OpHitObjectGetSphereRadiusNV,
+      spv::Op::OpHitObjectGetLSSPositionsNV,
+      spv::Op::OpHitObjectGetLSSRadiiNV,
+      spv::Op::OpHitObjectIsSphereHitNV,
+      spv::Op::OpHitObjectIsLSSHitNV,
+  };
+}
+
 spv_result_t RayReorderEXTPass(ValidationState_t& _, const Instruction* inst) {
   const spv::Op opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
@@ -1406,5 +1447,45 @@ spv_result_t RayReorderEXTPass(ValidationState_t& _, const Instruction* inst) {
   }
   return SPV_SUCCESS;
 }
+
+std::vector<spv::Op> RayReorderEXTPassOpcodes() {
+  return {
+      spv::Op::OpHitObjectIsMissEXT,
+      spv::Op::OpHitObjectIsHitEXT,
+      spv::Op::OpHitObjectIsEmptyEXT,
+      spv::Op::OpHitObjectGetShaderRecordBufferHandleEXT,
+      spv::Op::OpHitObjectGetHitKindEXT,
+      spv::Op::OpHitObjectGetPrimitiveIndexEXT,
+      spv::Op::OpHitObjectGetGeometryIndexEXT,
+      spv::Op::OpHitObjectGetInstanceIdEXT,
+      spv::Op::OpHitObjectGetInstanceCustomIndexEXT,
+      spv::Op::OpHitObjectGetShaderBindingTableRecordIndexEXT,
+      spv::Op::OpHitObjectGetRayFlagsEXT,
+      spv::Op::OpHitObjectGetCurrentTimeEXT,
+      spv::Op::OpHitObjectGetRayTMaxEXT,
+      spv::Op::OpHitObjectGetRayTMinEXT,
+      spv::Op::OpHitObjectGetObjectToWorldEXT,
+      spv::Op::OpHitObjectGetWorldToObjectEXT,
+      spv::Op::OpHitObjectGetObjectRayOriginEXT,
+      spv::Op::OpHitObjectGetObjectRayDirectionEXT,
+      spv::Op::OpHitObjectGetWorldRayDirectionEXT,
+      spv::Op::OpHitObjectGetWorldRayOriginEXT,
+      spv::Op::OpHitObjectGetIntersectionTriangleVertexPositionsEXT,
+      spv::Op::OpHitObjectGetAttributesEXT,
+      spv::Op::OpHitObjectSetShaderBindingTableRecordIndexEXT,
+      spv::Op::OpHitObjectExecuteShaderEXT,
+      spv::Op::OpHitObjectRecordEmptyEXT,
+      spv::Op::OpHitObjectRecordFromQueryEXT,
+      spv::Op::OpHitObjectRecordMissEXT,
+      spv::Op::OpHitObjectRecordMissMotionEXT,
+      spv::Op::OpReorderThreadWithHintEXT,
+      spv::Op::OpReorderThreadWithHitObjectEXT,
+      spv::Op::OpHitObjectTraceRayEXT,
+      spv::Op::OpHitObjectTraceRayMotionEXT,
+      spv::Op::OpHitObjectReorderExecuteShaderEXT,
+      spv::Op::OpHitObjectTraceReorderExecuteEXT,
+      spv::Op::OpHitObjectTraceMotionReorderExecuteEXT,
+  };
+}
 }  // namespace val
 }  // namespace spvtools
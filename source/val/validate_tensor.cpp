@@ -246,5 +246,13 @@ spv_result_t TensorPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> TensorPassOpcodes() {
+  return {
+      spv::Op::OpTensorReadARM,
+      spv::Op::OpTensorWriteARM,
+      spv::Op::OpTensorQuerySizeARM,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -179,5 +179,20 @@ spv_result_t TensorLayoutPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+std::vector<spv::Op> TensorLayoutPassOpcodes() {
+  return {
+      spv::Op::OpCreateTensorLayoutNV,
+      spv::Op::OpCreateTensorViewNV,
+      spv::Op::OpTensorLayoutSetBlockSizeNV,
+      spv::Op::OpTensorLayoutSetDimensionNV,
+      spv::Op::OpTensorLayoutSetStrideNV,
+      spv::Op::OpTensorLayoutSliceNV,
+      spv::Op::OpTensorLayoutSetClampValueNV,
+      spv::Op::OpTensorViewSetDimensionNV,
+      spv::Op::OpTensorViewSetStrideNV,
+      spv::Op::OpTensorViewSetClipNV,
+  };
+}
+
 }  // namespace val
 }  // namespace spvtools
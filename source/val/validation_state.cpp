@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <mutex>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -40,6 +41,11 @@ namespace spvtools {
 namespace val {
 namespace {
 
+// When set, diagnostics created on this thread are collected here instead of
+// being reported. See ValidationState_t::SetThreadDeferredMessages.
+thread_local std::vector<ValidationState_t::DeferredMessage>*
+    thread_deferred_messages = nullptr;
+
 ModuleLayoutSection InstructionLayoutSection(
     ModuleLayoutSection current_section, spv::Op op) {
   // See Section 2.4
@@ -341,7 +347,8 @@ bool ValidationState_t::IsOpcodeInCurrentLayoutSection(spv::Op op) {
 
 DiagnosticStream ValidationState_t::diag(spv_result_t error_code,
                                          const Instruction* inst) {
-  if (error_code == SPV_WARNING) {
+  std::vector<DeferredMessage>* deferred = thread_deferred_messages;
+  if (error_code == SPV_WARNING && !deferred) {
     if (num_of_warnings_ == max_num_of_warnings_) {
       DiagnosticStream({0, 0, 0}, context_->consumer, "", error_code)
           << "Other warnings have been suppressed.\n";
@@ -359,11 +366,43 @@ DiagnosticStream ValidationState_t::diag(spv_result_t error_code,
     shader_debug_info = InspectShaderDebugInfo(*inst);
   }
 
+  if (deferred) {
+    MessageConsumer collect = [deferred](spv_message_level_t level,
+                                         const char* source,
+                                         const spv_position_t& position,
+                                         const char* message) {
+      deferred->push_back({level, source, position, message});
+    };
+    return DiagnosticStream({0, 0, inst ? inst->LineNum() : 0}, collect,
+                            disassembly, error_code, shader_debug_info);
+  }
+
   return DiagnosticStream({0, 0, inst ? inst->LineNum() : 0},
                           context_->consumer, disassembly, error_code,
                           shader_debug_info);
 }
 
+void ValidationState_t::SetThreadDeferredMessages(
+    std::vector<DeferredMessage>* messages) {
+  thread_deferred_messages = messages;
+}
+
+void ValidationState_t::EmitDeferredMessage(const DeferredMessage& message) {
+  if (message.level == SPV_MSG_WARNING) {
+    if (num_of_warnings_ == max_num_of_warnings_) {
+      DiagnosticStream({0, 0, 0}, context_->consumer, "", SPV_WARNING)
+          << "Other warnings have been suppressed.\n";
+    }
+    if (num_of_warnings_ >= max_num_of_warnings_) return;
+    ++num_of_warnings_;
+  }
+
+  if (context_->consumer) {
+    context_->consumer(message.level, message.source.c_str(),
+                       message.position, message.message.c_str());
+  }
+}
+
 std::vector<Function>& ValidationState_t::functions() {
   return module_functions_;
 }
@@ -651,6 +690,33 @@ void ValidationState_t::RegisterInstruction(Instruction* inst) {
   }
 }
 
+void ValidationState_t::FinalizeDecorations() {
+  size_t num_decorations = 0;
+  for (const auto& kv : pending_decorations_) {
+    num_decorations += kv.second.size();
+  }
+  decorations_.clear();
+  decorations_.reserve(num_decorations);
+  decorated_ids_.clear();
+  decoration_offsets_.clear();
+
+  // Targets at or past the id bound are reported as undefined ids later on,
+  // so they are kept out of the table rather than sizing it from them.
+  for (const auto& kv : pending_decorations_) {
+    if (kv.first >= getIdBound()) break;
+    if (kv.second.empty()) continue;
+    decoration_offsets_.resize(size_t(kv.first) + 1,
+                               uint32_t(decorations_.size()));
+    decorated_ids_.push_back(kv.first);
+    decorations_.insert(decorations_.end(), kv.second.begin(),
+                        kv.second.end());
+  }
+  if (!decorated_ids_.empty()) {
+    decoration_offsets_.push_back(uint32_t(decorations_.size()));
+  }
+  pending_decorations_.clear();
+}
+
 std::vector<Instruction*> ValidationState_t::getSampledImageConsumers(
     uint32_t sampled_image_id) const {
   std::vector<Instruction*> result;
@@ -672,6 +738,7 @@ void ValidationState_t::RegisterQCOMImageProcessingTextureConsumer(
   if (HasDecoration(texture_id, spv::Decoration::WeightTextureQCOM) ||
       HasDecoration(texture_id, spv::Decoration::BlockMatchTextureQCOM) ||
       HasDecoration(texture_id, spv::Decoration::BlockMatchSamplerQCOM)) {
+    std::lock_guard<std::mutex> lock(qcom_image_processing_consumers_mutex_);
     qcom_image_processing_consumers_.insert(consumer0->id());
     if (consumer1) {
       qcom_image_processing_consumers_.insert(consumer1->id());
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -33,6 +34,7 @@
 #include "source/spirv_definition.h"
 #include "source/spirv_validator_options.h"
 #include "source/table2.h"
+#include "source/util/hash_combine.h"
 #include "source/val/decoration.h"
 #include "source/val/function.h"
 #include "source/val/instruction.h"
@@ -206,6 +208,25 @@ class ValidationState_t {
 
   DiagnosticStream diag(spv_result_t error_code, const Instruction* inst);
 
+  /// A diagnostic collected while checks run concurrently. It is emitted
+  /// later by EmitDeferredMessage so that output follows module order.
+  struct DeferredMessage {
+    spv_message_level_t level;
+    std::string source;
+    spv_position_t position;
+    std::string message;
+  };
+
+  /// Redirects diagnostics created by diag() on the calling thread into
+  /// |messages|, or restores normal reporting when |messages| is nullptr.
+  /// Deferred messages do not count towards the warning limit until they are
+  /// emitted.
+  static void SetThreadDeferredMessages(std::vector<DeferredMessage>* messages);
+
+  /// Reports a previously deferred message to the context's consumer,
+  /// applying the same warning limit as diag().
+  void EmitDeferredMessage(const DeferredMessage& message);
+
   /// Returns the function states
   std::vector<Function>& functions();
 
@@ -468,74 +489,102 @@ class ValidationState_t {
   /// Registers the debug instruction information.
   void RegisterDebugInstruction(const Instruction* inst);
 
+  /// A contiguous range of decorations, in the order of Decoration::operator<.
+  /// The decorations of the <id> itself come first, followed by the
+  /// decorations of its members grouped by member index.
+  class DecorationSpan {
+   public:
+    using value_type = Decoration;
+    using const_iterator = const Decoration*;
+    using iterator = const_iterator;
+
+    DecorationSpan() = default;
+    DecorationSpan(const Decoration* first, const Decoration* last)
+        : begin_(first), end_(last) {}
+
+    const_iterator begin() const { return begin_; }
+    const_iterator end() const { return end_; }
+    size_t size() const { return size_t(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+
+   private:
+    const Decoration* begin_ = nullptr;
+    const Decoration* end_ = nullptr;
+  };
+
   /// Registers the decoration for the given <id>
   void RegisterDecorationForId(uint32_t id, const Decoration& dec) {
-    auto& dec_list = id_decorations_[id];
-    dec_list.insert(dec);
+    pending_decorations_[id].insert(dec);
   }
 
-  /// Registers the list of decorations for the given <id>
-  template <class InputIt>
-  void RegisterDecorationsForId(uint32_t id, InputIt begin, InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[id];
-    cur_decs.insert(begin, end);
+  /// Registers the decorations of the decoration group |group_id| for the
+  /// given <id>.
+  void RegisterGroupDecorationsForId(uint32_t group_id, uint32_t id) {
+    const std::set<Decoration>& group_decs = pending_decorations_[group_id];
+    pending_decorations_[id].insert(group_decs.begin(), group_decs.end());
   }
 
-  /// Registers the list of decorations for the given member of the given
-  /// structure.
-  template <class InputIt>
-  void RegisterDecorationsForStructMember(uint32_t struct_id,
-                                          uint32_t member_index, InputIt begin,
-                                          InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[struct_id];
-    for (InputIt iter = begin; iter != end; ++iter) {
-      Decoration dec = *iter;
+  /// Registers the decorations of the decoration group |group_id| for the
+  /// given member of the given structure.
+  void RegisterGroupDecorationsForStructMember(uint32_t group_id,
+                                               uint32_t struct_id,
+                                               uint32_t member_index) {
+    const std::set<Decoration>& group_decs = pending_decorations_[group_id];
+    std::set<Decoration>& cur_decs = pending_decorations_[struct_id];
+    for (Decoration dec : group_decs) {
       dec.set_struct_member_index(member_index);
       cur_decs.insert(dec);
     }
   }
 
+  /// Moves the registered decorations into the flat table queried by
+  /// id_decorations().  Called once all annotation instructions have been
+  /// registered; decorations are not visible to queries before that.
+  void FinalizeDecorations();
+
   /// Returns all the decorations for the given <id>. If no decorations exist
-  /// for the <id>, it registers an empty set for it in the map and
-  /// returns the empty set.
-  std::set<Decoration>& id_decorations(uint32_t id) {
-    return id_decorations_[id];
+  /// for the <id>, returns an empty span. This does not modify the state, so
+  /// it is safe to call while checks run concurrently.
+  DecorationSpan id_decorations(uint32_t id) const {
+    if (decoration_offsets_.empty() || id >= decoration_offsets_.size() - 1) {
+      return DecorationSpan();
+    }
+    const Decoration* decorations = decorations_.data();
+    return DecorationSpan(decorations + decoration_offsets_[id],
+                          decorations + decoration_offsets_[id + 1]);
   }
 
   /// Returns the range of decorations for the given field of the given <id>.
   struct FieldDecorationsIter {
-    std::set<Decoration>::const_iterator begin;
-    std::set<Decoration>::const_iterator end;
+    DecorationSpan::const_iterator begin;
+    DecorationSpan::const_iterator end;
   };
   FieldDecorationsIter id_member_decorations(uint32_t id,
-                                             uint32_t member_index) {
-    const auto& decorations = id_decorations_[id];
+                                             uint32_t member_index) const {
+    const auto decorations = id_decorations(id);
 
     // The decorations are sorted by member_index, so this look up will give the
     // exact range of decorations for this member index.
-    Decoration min_decoration((spv::Decoration)0, {}, member_index);
-    Decoration max_decoration(spv::Decoration::Max, {}, member_index);
+    const auto range = std::equal_range(
+        decorations.begin(), decorations.end(), int(member_index),
+        MemberIndexLess());
 
     FieldDecorationsIter result;
-    result.begin = decorations.lower_bound(min_decoration);
-    result.end = decorations.upper_bound(max_decoration);
+    result.begin = range.first;
+    result.end = range.second;
 
     return result;
   }
 
-  // Returns const pointer to the internal decoration container.
-  const std::map<uint32_t, std::set<Decoration>>& id_decorations() const {
-    return id_decorations_;
-  }
+  /// Returns the <id>s that have at least one decoration, in increasing order.
+  const std::vector<uint32_t>& decorated_ids() const { return decorated_ids_; }
 
   /// Returns true if the given id <id> has the given decoration <dec>,
   /// otherwise returns false.
   bool HasDecoration(uint32_t id, spv::Decoration dec) {
-    const auto& decorations = id_decorations_.find(id);
-    if (decorations == id_decorations_.end()) return false;
-
+    const auto decorations = id_decorations(id);
     return std::any_of(
-        decorations->second.begin(), decorations->second.end(),
+        decorations.begin(), decorations.end(),
         [dec](const Decoration& d) { return dec == d.dec_type(); });
   }
 
@@ -623,6 +672,12 @@ class ValidationState_t {
     return features_.env_relaxed_block_layout || options()->relax_block_layout;
   }
 
+  // Returns true if only the structural checks of SPV_VALIDATOR_LEVEL_FAST
+  // are run.
+  bool IsFastValidation() const {
+    return options()->level == SPV_VALIDATOR_LEVEL_FAST;
+  }
+
   // Returns true if allowing localsizeid, either because the environment always
   // allows it, or because it is enabled from the command-line.
   bool IsLocalSizeIdAllowed() const {
@@ -651,6 +706,43 @@ class ValidationState_t {
     return struct_has_nested_blockorbufferblock_struct_[id];
   }
 
+  /// Kinds of type layout queries memoized while checking explicit layouts.
+  enum class LayoutQueryKind : uint32_t {
+    kBaseAlignment,
+    kExtendedAlignment,
+    kScalarAlignment,
+    kSize,
+    kCheckedLayout,
+  };
+
+  /// Identifies a memoized type layout query.  For alignment and size
+  /// queries, |operand0| and |operand1| are the inherited matrix majorness
+  /// and matrix stride.  For checked layouts they are the layout rules and
+  /// the offset at which the struct was checked.
+  struct LayoutQuery {
+    LayoutQueryKind kind;
+    uint32_t type_id;
+    uint32_t operand0;
+    uint32_t operand1;
+
+    bool operator==(const LayoutQuery& other) const {
+      return kind == other.kind && type_id == other.type_id &&
+             operand0 == other.operand0 && operand1 == other.operand1;
+    }
+  };
+
+  /// Returns the memoized result of |query|, or nullptr if it has not been
+  /// computed yet.
+  const uint32_t* GetLayoutQueryResult(const LayoutQuery& query) const {
+    const auto it = layout_query_results_.find(query);
+    return it == layout_query_results_.end() ? nullptr : &it->second;
+  }
+
+  /// Memoizes |result| as the result of |query|.
+  void SetLayoutQueryResult(const LayoutQuery& query, uint32_t result) {
+    layout_query_results_[query] = result;
+  }
+
   /// Records that the structure type has a member decorated with a built-in.
   void RegisterStructTypeWithBuiltInMember(uint32_t id) {
     builtin_structs_.insert(id);
@@ -1045,6 +1137,9 @@ class ValidationState_t {
   /// Stores load instructions that load textures used
   //  in QCOM image processing functions
   std::unordered_set<uint32_t> qcom_image_processing_consumers_;
+  // Guards qcom_image_processing_consumers_, which is updated while function
+  // bodies are checked, possibly from several threads.
+  std::mutex qcom_image_processing_consumers_mutex_;
 
   /// A map of operand IDs and their names defined by the OpName instruction
   std::unordered_map<uint32_t, std::string> operand_names_;
@@ -1105,8 +1200,43 @@ class ValidationState_t {
   std::unordered_map<uint32_t, bool>
       struct_has_nested_blockorbufferblock_struct_;
 
-  /// Stores the list of decorations for a given <id>
-  std::map<uint32_t, std::set<Decoration>> id_decorations_;
+  /// Hashes a LayoutQuery.
+  struct LayoutQueryHash {
+    size_t operator()(const LayoutQuery& query) const {
+      return utils::hash_combine(0, uint32_t(query.kind), query.type_id,
+                                 query.operand0, query.operand1);
+    }
+  };
+
+  /// Memoized results of type layout queries, see LayoutQuery.
+  std::unordered_map<LayoutQuery, uint32_t, LayoutQueryHash>
+      layout_query_results_;
+
+  /// Orders decorations by the index of the member they apply to.
+  struct MemberIndexLess {
+    bool operator()(const Decoration& lhs, int member_index) const {
+      return lhs.struct_member_index() < member_index;
+    }
+    bool operator()(int member_index, const Decoration& rhs) const {
+      return member_index < rhs.struct_member_index();
+    }
+  };
+
+  /// Stores the list of decorations for a given <id> while the annotation
+  /// instructions are being registered.  Emptied by FinalizeDecorations().
+  std::map<uint32_t, std::set<Decoration>> pending_decorations_;
+
+  /// The decorations of all <id>s, sorted by <id> and then in the order of
+  /// Decoration::operator<.
+  std::vector<Decoration> decorations_;
+
+  /// The decorations of <id> are decorations_[decoration_offsets_[id]] up to
+  /// decorations_[decoration_offsets_[id + 1]].  <id>s past the end of the
+  /// table have no decorations.
+  std::vector<uint32_t> decoration_offsets_;
+
+  /// The <id>s that have at least one decoration, in increasing order.
+  std::vector<uint32_t> decorated_ids_;
 
   /// Stores type declarations which need to be unique (i.e. non-aggregates),
   /// in the form [opcode, operand words], result_id is not stored.
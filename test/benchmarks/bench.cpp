@@ -0,0 +1,496 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the core entry points of SPIRV-Tools.
+//
+// Every benchmark processes all the modules of a corpus once per iteration,
+// and is repeated until it ran for a minimum amount of time.  The results are
+// printed as a table, and can also be written as JSON in the format used by
+// Google Benchmark, so that its tools can compare two runs.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "source/diff/diff.h"
+#include "source/opt/build_module.h"
+#include "source/opt/ir_context.h"
+#include "source/spirv_target_env.h"
+#include "spirv-tools/libspirv.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/linker.hpp"
+#include "spirv-tools/optimizer.hpp"
+#include "tools/io.h"
+
+namespace {
+
+void print_usage(const char* argv0) {
+  printf(
+      R"(%s - Run the SPIRV-Tools microbenchmarks.
+
+USAGE: %s [options] [<path> ...]
+
+Each <path> is a SPIR-V binary file, or a directory whose .spv files are all
+used.  If no path is given, the corpus of the fuzzers in the source tree is
+used.
+
+Options:
+  -h, --help         Print this help.
+  --filter <text>    Only run the benchmarks whose name contains <text>.
+  --json <file>      Also write the results to <file> as JSON, in the format
+                     used by Google Benchmark.
+  --list             Print the names of the benchmarks and exit.
+  --min-time <sec>   Repeat each benchmark for at least <sec> seconds.
+                     Defaults to 0.5.
+  --target-env <env> Use the specified environment.  Defaults to %s.
+)",
+      argv0, argv0, spvTargetEnvDescription(SPV_ENV_UNIVERSAL_1_6));
+}
+
+// Ignores all messages, so that the modules the tools reject do not flood the
+// output.
+void IgnoreMessage(spv_message_level_t, const char*, const spv_position_t&,
+                   const char*) {}
+
+struct Module {
+  std::string path;
+  std::vector<uint32_t> binary;
+};
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  // Average times per iteration, in nanoseconds.
+  double real_time;
+  double cpu_time;
+  // The number of bytes of SPIR-V processed by one iteration.
+  size_t bytes;
+};
+
+// Runs the benchmarks and collects their results.
+class Runner {
+ public:
+  Runner(double min_time, std::string filter, bool list_only)
+      : min_time_(min_time),
+        filter_(std::move(filter)),
+        list_only_(list_only) {}
+
+  // Returns true if the benchmark called |name| was selected.
+  bool Selected(const std::string& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+  }
+
+  // Runs |body| repeatedly as the benchmark called |name|, if it is selected.
+  // Each call to |body| processes |bytes| bytes of SPIR-V.
+  void Run(const std::string& name, size_t bytes,
+           const std::function<void()>& body) {
+    if (!Selected(name)) return;
+    if (list_only_) {
+      printf("%s\n", name.c_str());
+      return;
+    }
+
+    // Warm up the caches and the allocator.
+    body();
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    const std::clock_t cpu_start = std::clock();
+    uint64_t iterations = 0;
+    std::chrono::duration<double> elapsed{0};
+    do {
+      body();
+      ++iterations;
+      elapsed = clock::now() - start;
+    } while (elapsed.count() < min_time_);
+    const double cpu_seconds =
+        static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.real_time = elapsed.count() * 1e9 / iterations;
+    result.cpu_time = cpu_seconds * 1e9 / iterations;
+    result.bytes = bytes;
+    printf("%-48s %10llu %14.3f %14.3f %10.2f\n", name.c_str(),
+           static_cast<unsigned long long>(iterations),
+           result.real_time / 1e6, result.cpu_time / 1e6,
+           bytes / (result.real_time / 1e9) / (1024 * 1024));
+    fflush(stdout);
+    results_.push_back(result);
+  }
+
+  bool list_only() const { return list_only_; }
+  const std::vector<Result>& results() const { return results_; }
+
+ private:
+  const double min_time_;
+  const std::string filter_;
+  const bool list_only_;
+  std::vector<Result> results_;
+};
+
+// Writes |results| to |filename| in the JSON format of Google Benchmark.
+bool WriteJson(const char* filename, const std::vector<Result>& results,
+               size_t num_modules) {
+  std::ofstream out(filename);
+  if (!out) {
+    fprintf(stderr, "error: could not open %s for writing\n", filename);
+    return false;
+  }
+
+  const std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+  out << "{\n"
+      << "  \"context\": {\n"
+      << "    \"date\": \"" << date << "\",\n"
+      << "    \"executable\": \"spirv-tools-bench\",\n"
+      << "    \"library_version\": \"" << spvSoftwareVersionDetailsString()
+      << "\",\n"
+      << "    \"num_modules\": " << num_modules << "\n"
+      << "  },\n"
+      << "  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& result = results[i];
+    out << (i ? ",\n" : "\n") << "    {\n"
+        << "      \"name\": \"" << result.name << "\",\n"
+        << "      \"run_name\": \"" << result.name << "\",\n"
+        << "      \"run_type\": \"iteration\",\n"
+        << "      \"iterations\": " << result.iterations << ",\n"
+        << "      \"real_time\": " << result.real_time << ",\n"
+        << "      \"cpu_time\": " << result.cpu_time << ",\n"
+        << "      \"time_unit\": \"ns\",\n"
+        << "      \"bytes_per_second\": "
+        << result.bytes / (result.real_time / 1e9) << "\n"
+        << "    }";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+// Adds the modules found at |path| to |modules|.
+bool LoadModules(const std::string& path, std::vector<Module>* modules) {
+  std::vector<std::string> files;
+  if (std::filesystem::is_directory(path)) {
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".spv") {
+        files.push_back(entry.path().string());
+      }
+    }
+    std::sort(files.begin(), files.end());
+  } else {
+    files.push_back(path);
+  }
+
+  for (const std::string& file : files) {
+    Module module;
+    module.path = file;
+    if (!ReadBinaryFile(file.c_str(), &module.binary)) return false;
+    modules->push_back(std::move(module));
+  }
+  return true;
+}
+
+size_t SizeInBytes(const std::vector<std::vector<uint32_t>>& binaries) {
+  size_t bytes = 0;
+  for (const auto& binary : binaries) bytes += binary.size() * sizeof(uint32_t);
+  return bytes;
+}
+
+// Keeps the results of the benchmarks alive, so that the compiler cannot
+// discard the work producing them.
+volatile size_t sink;
+
+spv_result_t CountInstruction(void* user_data,
+                              const spv_parsed_instruction_t*) {
+  ++*static_cast<size_t*>(user_data);
+  return SPV_SUCCESS;
+}
+
+std::unique_ptr<spvtools::Optimizer> MakeOptimizer(spv_target_env env) {
+  auto optimizer = std::make_unique<spvtools::Optimizer>(env);
+  optimizer->SetMessageConsumer(IgnoreMessage);
+  return optimizer;
+}
+
+// Runs |optimizer| on |binary| without validating it first.  Returns false if
+// the optimizer failed.
+bool RunOptimizer(const spvtools::Optimizer& optimizer,
+                  const std::vector<uint32_t>& binary,
+                  std::vector<uint32_t>* optimized) {
+  spvtools::OptimizerOptions options;
+  options.set_run_validator(false);
+  return optimizer.Run(binary.data(), binary.size(), optimized, options);
+}
+
+// Benchmarks the passes of the recipes of spirv-opt -O and -Os one at a time.
+// Each pass runs on the modules as they are right before the pass when
+// running the whole recipe, so that it sees the code it is meant to handle.
+// The time of a pass includes loading the module and writing it back, which
+// is what the build_module benchmark measures.
+void RunPassBenchmarks(Runner* runner, spv_target_env env,
+                       const std::vector<std::vector<uint32_t>>& binaries) {
+  std::vector<std::string> pass_names;
+  std::map<std::string, std::unique_ptr<spvtools::Optimizer>> optimizers;
+  std::map<std::string, std::vector<std::vector<uint32_t>>> inputs;
+
+  for (const bool size : {false, true}) {
+    auto recipe = MakeOptimizer(env);
+    if (size) {
+      recipe->RegisterSizePasses();
+    } else {
+      recipe->RegisterPerformancePasses();
+    }
+    std::vector<std::string> recipe_names;
+    for (const char* name : recipe->GetPassNames()) {
+      recipe_names.push_back(name);
+      if (optimizers.count(name)) continue;
+      // The name of a pass is the flag registering it, including its
+      // arguments.
+      auto optimizer = MakeOptimizer(env);
+      if (!optimizer->RegisterPassFromFlag(std::string("--") + name)) {
+        fprintf(stderr, "warning: cannot benchmark pass %s\n", name);
+        optimizer.reset();
+      } else {
+        pass_names.push_back(name);
+      }
+      optimizers[name] = std::move(optimizer);
+    }
+
+    const bool any_selected =
+        std::any_of(recipe_names.begin(), recipe_names.end(),
+                    [runner](const std::string& name) {
+                      return runner->Selected("opt/" + name);
+                    });
+    if (!any_selected || runner->list_only()) continue;
+    for (const auto& binary : binaries) {
+      std::vector<uint32_t> current = binary;
+      for (const std::string& name : recipe_names) {
+        const spvtools::Optimizer* optimizer = optimizers[name].get();
+        if (!optimizer) break;
+        if (runner->Selected("opt/" + name)) inputs[name].push_back(current);
+        std::vector<uint32_t> next;
+        if (!RunOptimizer(*optimizer, current, &next)) break;
+        current = std::move(next);
+      }
+    }
+  }
+
+  for (const std::string& name : pass_names) {
+    const spvtools::Optimizer* optimizer = optimizers[name].get();
+    const std::vector<std::vector<uint32_t>>& pass_inputs = inputs[name];
+    runner->Run("opt/" + name, SizeInBytes(pass_inputs), [&]() {
+      for (const auto& binary : pass_inputs) {
+        std::vector<uint32_t> optimized;
+        RunOptimizer(*optimizer, binary, &optimized);
+        sink = optimized.size();
+      }
+    });
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  double min_time = 0.5;
+  std::string filter;
+  const char* json_file = nullptr;
+  bool list_only = false;
+  spv_target_env env = SPV_ENV_UNIVERSAL_1_6;
+  std::vector<std::string> paths;
+
+  for (int argi = 1; argi < argc; ++argi) {
+    const char* cur_arg = argv[argi];
+    const bool has_value = argi + 1 < argc;
+    if (0 == strcmp(cur_arg, "--help") || 0 == strcmp(cur_arg, "-h")) {
+      print_usage(argv[0]);
+      return 0;
+    } else if (0 == strcmp(cur_arg, "--filter") && has_value) {
+      filter = argv[++argi];
+    } else if (0 == strcmp(cur_arg, "--json") && has_value) {
+      json_file = argv[++argi];
+    } else if (0 == strcmp(cur_arg, "--list")) {
+      list_only = true;
+    } else if (0 == strcmp(cur_arg, "--min-time") && has_value) {
+      min_time = atof(argv[++argi]);
+    } else if (0 == strcmp(cur_arg, "--target-env") && has_value) {
+      if (!spvParseTargetEnv(argv[++argi], &env)) {
+        fprintf(stderr, "error: unrecognized target environment '%s'\n",
+                argv[argi]);
+        return 1;
+      }
+    } else if (cur_arg[0] == '-') {
+      fprintf(stderr, "error: invalid option '%s'\n", cur_arg);
+      print_usage(argv[0]);
+      return 1;
+    } else {
+      paths.push_back(cur_arg);
+    }
+  }
+  if (paths.empty()) paths.push_back(SPIRV_TOOLS_BENCH_CORPUS);
+
+  std::vector<Module> modules;
+  for (const std::string& path : paths) {
+    if (!LoadModules(path, &modules)) return 1;
+  }
+  if (modules.empty()) {
+    fprintf(stderr, "error: no SPIR-V modules found\n");
+    return 1;
+  }
+
+  spvtools::SpirvTools tools(env);
+  tools.SetMessageConsumer(IgnoreMessage);
+
+  // Only the modules that can be disassembled are used, so that every
+  // benchmark sees the same modules.
+  std::vector<std::vector<uint32_t>> binaries;
+  std::vector<std::string> texts;
+  for (const Module& module : modules) {
+    std::string text;
+    if (!tools.Disassemble(module.binary, &text,
+                           SPV_BINARY_TO_TEXT_OPTION_NO_HEADER)) {
+      fprintf(stderr, "warning: skipping %s, which cannot be disassembled\n",
+              module.path.c_str());
+      continue;
+    }
+    binaries.push_back(module.binary);
+    texts.push_back(std::move(text));
+  }
+  const size_t bytes = SizeInBytes(binaries);
+
+  Runner runner(min_time, filter, list_only);
+  if (!list_only) {
+    printf("Running on %zu modules (%zu bytes)\n\n", binaries.size(), bytes);
+    printf("%-48s %10s %14s %14s %10s\n", "Benchmark", "Iterations",
+           "Time (ms)", "CPU (ms)", "MiB/s");
+  }
+
+  spv_context context = spvContextCreate(env);
+  runner.Run("parse", bytes, [&]() {
+    size_t count = 0;
+    for (const auto& binary : binaries) {
+      spvBinaryParse(context, &count, binary.data(), binary.size(), nullptr,
+                     CountInstruction, nullptr);
+    }
+    sink = count;
+  });
+  spvContextDestroy(context);
+
+  runner.Run("dis", bytes, [&]() {
+    for (const auto& binary : binaries) {
+      std::string text;
+      tools.Disassemble(binary, &text, SPV_BINARY_TO_TEXT_OPTION_NO_HEADER);
+      sink = text.size();
+    }
+  });
+
+  runner.Run("as", bytes, [&]() {
+    for (const std::string& text : texts) {
+      std::vector<uint32_t> binary;
+      tools.Assemble(text, &binary,
+                     SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+      sink = binary.size();
+    }
+  });
+
+  runner.Run("val", bytes, [&]() {
+    for (const auto& binary : binaries) {
+      sink = tools.Validate(binary);
+    }
+  });
+
+  runner.Run("build_module", bytes, [&]() {
+    for (const auto& binary : binaries) {
+      auto ir_context =
+          spvtools::BuildModule(env, IgnoreMessage, binary.data(),
+                                binary.size());
+      sink = ir_context != nullptr;
+    }
+  });
+
+  for (const bool size : {false, true}) {
+    auto optimizer = MakeOptimizer(env);
+    if (size) {
+      optimizer->RegisterSizePasses();
+    } else {
+      optimizer->RegisterPerformancePasses();
+    }
+    runner.Run(size ? "opt/-Os" : "opt/-O", bytes, [&]() {
+      for (const auto& binary : binaries) {
+        std::vector<uint32_t> optimized;
+        RunOptimizer(*optimizer, binary, &optimized);
+        sink = optimized.size();
+      }
+    });
+  }
+
+  RunPassBenchmarks(&runner, env, binaries);
+
+  spvtools::Context link_context(env);
+  runner.Run("link", bytes, [&]() {
+    for (const auto& binary : binaries) {
+      const uint32_t* data = binary.data();
+      const size_t size = binary.size();
+      std::vector<uint32_t> linked;
+      spvtools::Link(link_context, &data, &size, 1, &linked);
+      sink = linked.size();
+    }
+  });
+
+  // Each module is compared with its version optimized with -O.  Diffing may
+  // change the modules, so they are loaded again every time.
+  std::vector<std::vector<uint32_t>> optimized_binaries;
+  if (runner.Selected("diff") && !list_only) {
+    auto optimizer = MakeOptimizer(env);
+    optimizer->RegisterPerformancePasses();
+    for (const auto& binary : binaries) {
+      optimized_binaries.emplace_back();
+      if (!RunOptimizer(*optimizer, binary, &optimized_binaries.back())) {
+        optimized_binaries.back() = binary;
+      }
+    }
+  }
+  runner.Run("diff", bytes + SizeInBytes(optimized_binaries), [&]() {
+    for (size_t i = 0; i < binaries.size(); ++i) {
+      auto src = spvtools::BuildModule(env, IgnoreMessage, binaries[i].data(),
+                                       binaries[i].size());
+      auto dst = spvtools::BuildModule(env, IgnoreMessage,
+                                       optimized_binaries[i].data(),
+                                       optimized_binaries[i].size());
+      if (!src || !dst) continue;
+      std::ostringstream out;
+      spvtools::diff::Diff(src.get(), dst.get(), out,
+                           spvtools::diff::Options());
+      sink = out.str().size();
+    }
+  });
+
+  if (json_file && !list_only &&
+      !WriteJson(json_file, runner.results(), binaries.size())) {
+    return 1;
+  }
+  return 0;
+}
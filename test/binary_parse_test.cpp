@@ -1087,6 +1087,13 @@ INSTANTIATE_TEST_SUITE_P(
              {spvOpcodeMake(2, spv::Op::OpTypeBool), 1},
          }),
          "Id 1 is defined more than once"},
+        // Ids at or above the bound are tracked separately.
+        {Concatenate({
+             ExpectedHeaderForBound(2),
+             {spvOpcodeMake(2, spv::Op::OpTypeVoid), 7},
+             {spvOpcodeMake(2, spv::Op::OpTypeBool), 7},
+         }),
+         "Id 7 is defined more than once"},
         {Concatenate({ExpectedHeaderForBound(3),
                       MakeInstruction(spv::Op::OpExtInst, {2, 3, 100, 4, 5})}),
          "OpExtInst set Id 100 does not reference an OpExtInstImport result "
@@ -1103,6 +1110,11 @@ INSTANTIATE_TEST_SUITE_P(
         {Concatenate({ExpectedHeaderForBound(3),
                       MakeInstruction(spv::Op::OpSwitch, {1, 2, 42, 3})}),
          "Invalid OpSwitch: selector id 1 has no type"},
+        // Like the next case, with a selector above the bound.
+        {Concatenate({ExpectedHeaderForBound(3),
+                      MakeInstruction(spv::Op::OpLabel, {9}),
+                      MakeInstruction(spv::Op::OpSwitch, {9, 2, 42, 3})}),
+         "Invalid OpSwitch: selector id 9 has no type"},
         // In this case, the OpSwitch selector refers to an ID that has
         // no type.
         {Concatenate({ExpectedHeaderForBound(3),
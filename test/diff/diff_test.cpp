@@ -222,6 +222,145 @@ TEST(DiffHeaderTest, Diff) {
   EXPECT_EQ(diff_result.str(), diff);
 }
 
+TEST(DiffMultiThreadedTest, Diff) {
+  // Named functions are definite matches, and the unnamed ones are matched by
+  // their bodies.
+  const std::string src = R"(OpCapability Shader
+    OpMemoryModel Logical GLSL450
+    OpEntryPoint GLCompute %main "main"
+    OpExecutionMode %main LocalSize 1 1 1
+    OpName %main "main"
+    OpName %f1 "f1("
+    OpName %f2 "f2("
+    %void = OpTypeVoid
+    %func = OpTypeFunction %void
+    %int = OpTypeInt 32 1
+    %ptr = OpTypePointer Private %int
+    %int_0 = OpConstant %int 0
+    %int_1 = OpConstant %int 1
+    %a = OpVariable %ptr Private
+    %b = OpVariable %ptr Private
+
+    %main = OpFunction %void None %func
+    %main_entry = OpLabel
+    %c1 = OpFunctionCall %void %f1
+    %c2 = OpFunctionCall %void %f2
+    %c3 = OpFunctionCall %void %g1
+    %c4 = OpFunctionCall %void %g2
+    OpReturn
+    OpFunctionEnd
+
+    %f1 = OpFunction %void None %func
+    %f1_entry = OpLabel
+    %f1_load = OpLoad %int %a
+    %f1_add = OpIAdd %int %f1_load %int_1
+    OpStore %b %f1_add
+    OpReturn
+    OpFunctionEnd
+
+    %f2 = OpFunction %void None %func
+    %f2_entry = OpLabel
+    %f2_load = OpLoad %int %b
+    OpStore %a %f2_load
+    OpReturn
+    OpFunctionEnd
+
+    %g1 = OpFunction %void None %func
+    %g1_entry = OpLabel
+    OpStore %a %int_0
+    OpStore %b %int_1
+    OpReturn
+    OpFunctionEnd
+
+    %g2 = OpFunction %void None %func
+    %g2_entry = OpLabel
+    %g2_load = OpLoad %int %a
+    %g2_mul = OpIMul %int %g2_load %g2_load
+    OpStore %a %g2_mul
+    OpReturn
+    OpFunctionEnd
+)";
+
+  const std::string dst = R"(OpCapability Shader
+    OpMemoryModel Logical GLSL450
+    OpEntryPoint GLCompute %main "main"
+    OpExecutionMode %main LocalSize 1 1 1
+    OpName %main "main"
+    OpName %f1 "f1("
+    OpName %f2 "f2("
+    %void = OpTypeVoid
+    %func = OpTypeFunction %void
+    %int = OpTypeInt 32 1
+    %ptr = OpTypePointer Private %int
+    %int_0 = OpConstant %int 0
+    %int_1 = OpConstant %int 1
+    %int_2 = OpConstant %int 2
+    %b = OpVariable %ptr Private
+    %a = OpVariable %ptr Private
+
+    %main = OpFunction %void None %func
+    %main_entry = OpLabel
+    %c1 = OpFunctionCall %void %f1
+    %c2 = OpFunctionCall %void %f2
+    %c4 = OpFunctionCall %void %g2
+    %c3 = OpFunctionCall %void %g1
+    OpReturn
+    OpFunctionEnd
+
+    %f1 = OpFunction %void None %func
+    %f1_entry = OpLabel
+    %f1_load = OpLoad %int %a
+    %f1_add = OpIAdd %int %f1_load %int_2
+    OpStore %b %f1_add
+    OpReturn
+    OpFunctionEnd
+
+    %f2 = OpFunction %void None %func
+    %f2_entry = OpLabel
+    %f2_load = OpLoad %int %b
+    %f2_neg = OpSNegate %int %f2_load
+    OpStore %a %f2_neg
+    OpReturn
+    OpFunctionEnd
+
+    %g2 = OpFunction %void None %func
+    %g2_entry = OpLabel
+    %g2_load = OpLoad %int %a
+    %g2_mul = OpIMul %int %g2_load %g2_load
+    %g2_add = OpIAdd %int %g2_mul %int_1
+    OpStore %a %g2_add
+    OpReturn
+    OpFunctionEnd
+
+    %g1 = OpFunction %void None %func
+    %g1_entry = OpLabel
+    OpStore %a %int_0
+    OpStore %b %int_2
+    OpReturn
+    OpFunctionEnd
+)";
+
+  std::unique_ptr<spvtools::opt::IRContext> src_context = Assemble(src);
+  ASSERT_TRUE(src_context);
+  std::unique_ptr<spvtools::opt::IRContext> dst_context = Assemble(dst);
+  ASSERT_TRUE(dst_context);
+
+  // The diff should be the same whatever the number of threads.
+  Options options;
+  std::ostringstream expected_diff;
+  ASSERT_EQ(SPV_SUCCESS, spvtools::diff::Diff(src_context.get(),
+                                              dst_context.get(), expected_diff,
+                                              options));
+
+  options.num_threads = 4;
+  std::ostringstream diff;
+  ASSERT_EQ(SPV_SUCCESS,
+            spvtools::diff::Diff(src_context.get(), dst_context.get(), diff,
+                                 options));
+
+  EXPECT_EQ(expected_diff.str(), diff.str());
+}
+
 }  // namespace
 }  // namespace diff
 }  // namespace spvtools
@@ -14,6 +14,7 @@
 
 #include "source/diff/lcs.h"
 
+#include <algorithm>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -25,15 +26,16 @@ namespace {
 using Sequence = std::vector<int>;
 using LCS = LongestCommonSubsequence<Sequence>;
 
-void VerifyMatch(const Sequence& src, const Sequence& dst,
-                 size_t expected_match_count) {
-  DiffMatch src_match, dst_match;
-
-  LCS lcs(src, dst);
-  size_t match_count =
-      lcs.Get<int>([](int s, int d) { return s == d; }, &src_match, &dst_match);
-
-  EXPECT_EQ(match_count, expected_match_count);
+// Checks that |src_match| and |dst_match| mark the same number of elements,
+// and that the marked elements form a common subsequence of |src| and |dst|.
+// Returns the length of that subsequence.
+size_t VerifyCommonSubsequence(const Sequence& src, const Sequence& dst,
+                               const DiffMatch& src_match,
+                               const DiffMatch& dst_match) {
+  EXPECT_EQ(src_match.size(), src.size());
+  EXPECT_EQ(dst_match.size(), dst.size());
+  EXPECT_EQ(std::count(src_match.begin(), src_match.end(), true),
+            std::count(dst_match.begin(), dst_match.end(), true));
 
   size_t src_cur = 0;
   size_t dst_cur = 0;
@@ -56,7 +58,20 @@ void VerifyMatch(const Sequence& src, const Sequence& dst,
     }
   }
 
-  EXPECT_EQ(matches_seen, expected_match_count);
+  return matches_seen;
+}
+
+void VerifyMatch(const Sequence& src, const Sequence& dst,
+                 size_t expected_match_count) {
+  DiffMatch src_match, dst_match;
+
+  LCS lcs(src, dst);
+  size_t match_count =
+      lcs.Get<int>([](int s, int d) { return s == d; }, &src_match, &dst_match);
+
+  EXPECT_EQ(match_count, expected_match_count);
+  EXPECT_EQ(VerifyCommonSubsequence(src, dst, src_match, dst_match),
+            expected_match_count);
 }
 
 TEST(LCSTest, EmptySequences) {
@@ -324,6 +339,51 @@ TEST(LCSTest, Large) {
   VerifyMatch(src, dst, 723);
 }
 
+TEST(LCSTest, LargeWithFewEdits) {
+  // Too large for the table, so this exercises the linear space algorithm.
+  Sequence src, dst;
+  for (int i = 0; i < 20000; ++i) {
+    src.push_back(i);
+    if (i % 10 != 0) {
+      dst.push_back(i);
+    }
+    if (i % 7 == 0) {
+      dst.push_back(-1);
+    }
+  }
+
+  VerifyMatch(src, dst, 18000);
+}
+
+TEST(LCSTest, LargeAndVeryDifferent) {
+  // Random sequences over a small alphabet need more edits than the linear
+  // space algorithm allows itself, so it cuts its search short.  The result
+  // may not be the longest, but must still be a common subsequence.
+  Sequence src, dst;
+  uint32_t state = 1;
+  auto next_element = [&state]() {
+    state = state * 1103515245u + 12345u;
+    return static_cast<int>((state >> 16) % 16);
+  };
+  for (int i = 0; i < 9000; ++i) {
+    src.push_back(next_element());
+  }
+  for (int i = 0; i < 9000; ++i) {
+    dst.push_back(next_element());
+  }
+
+  DiffMatch src_match, dst_match;
+
+  LCS lcs(src, dst);
+  size_t match_count =
+      lcs.Get<int>([](int s, int d) { return s == d; }, &src_match, &dst_match);
+
+  EXPECT_EQ(VerifyCommonSubsequence(src, dst, src_match, dst_match),
+            match_count);
+  // The longest common subsequence has 3567 elements.
+  EXPECT_GT(match_count, 3400u);
+}
+
 }  // namespace
 }  // namespace diff
 }  // namespace spvtools
@@ -1812,6 +1812,42 @@ TEST(FuzzerutilTest, TypesAreCompatible) {
       context.get(), spv::Op::OpAtomicXor, 3, int_type, uint_type));
 }
 
+TEST(FuzzerutilTest, ModuleCopySupplierSuppliesIndependentCopies) {
+  const std::string shader = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %4 "main"
+               OpExecutionMode %4 OriginUpperLeft
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %6 = OpTypeInt 32 1
+          %7 = OpConstant %6 1
+          %4 = OpFunction %2 None %3
+          %5 = OpLabel
+          %8 = OpIAdd %6 %7 %7
+               OpReturn
+               OpFunctionEnd
+  )";
+
+  const auto env = SPV_ENV_UNIVERSAL_1_3;
+  const auto consumer = nullptr;
+  std::shared_ptr<const opt::IRContext> donor =
+      BuildModule(env, consumer, shader, kFuzzAssembleOption);
+  ASSERT_NE(nullptr, donor);
+
+  fuzzerutil::ModuleSupplier supplier =
+      fuzzerutil::MakeModuleCopySupplier(donor);
+  std::unique_ptr<opt::IRContext> first = supplier();
+  ASSERT_TRUE(IsEqual(env, shader, first.get()));
+
+  // Changing a supplied copy affects neither the shared module nor the copies
+  // supplied later.
+  first->KillInst(first->get_def_use_mgr()->GetDef(8));
+  ASSERT_FALSE(IsEqual(env, shader, first.get()));
+  ASSERT_TRUE(IsEqual(env, shader, donor.get()));
+  ASSERT_TRUE(IsEqual(env, shader, supplier().get()));
+}
+
 }  // namespace
 }  // namespace fuzz
 }  // namespace spvtools
@@ -471,6 +471,119 @@ TEST(ReplayerTest, ReplayWithOverflowIds) {
   ASSERT_EQ(2, replayer_result.applied_transformations.transformation_size());
 }
 
+TEST(ReplayerTest, ResumeFromCheckpoint) {
+  const std::string kTestShader = R"(
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %4 "main"
+               OpExecutionMode %4 OriginUpperLeft
+               OpSource ESSL 320
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %8 = OpTypeInt 32 1
+          %9 = OpTypePointer Function %8
+         %50 = OpTypePointer Private %8
+         %11 = OpConstant %8 1
+          %4 = OpFunction %2 None %3
+          %5 = OpLabel
+         %10 = OpVariable %9 Function
+               OpStore %10 %11
+         %12 = OpFunctionCall %2 %6
+               OpReturn
+               OpFunctionEnd
+          %6 = OpFunction %2 None %3
+          %7 = OpLabel
+               OpReturn
+               OpFunctionEnd
+  )";
+
+  const auto env = SPV_ENV_UNIVERSAL_1_3;
+  spvtools::ValidatorOptions validator_options;
+
+  std::vector<uint32_t> binary_in;
+  SpirvTools t(env);
+  t.SetMessageConsumer(kConsoleMessageConsumer);
+  ASSERT_TRUE(t.Assemble(kTestShader, &binary_in, kFuzzAssembleOption));
+  ASSERT_TRUE(t.Validate(binary_in));
+
+  protobufs::TransformationSequence transformations;
+  *transformations.add_transformation() =
+      TransformationAddConstantScalar(100, 8, {42}, true).ToMessage();
+  *transformations.add_transformation() =
+      TransformationAddGlobalVariable(101, 50, spv::StorageClass::Private, 100,
+                                      true)
+          .ToMessage();
+  *transformations.add_transformation() =
+      TransformationAddParameter(6, 102, 8, {{12, 100}}, 103).ToMessage();
+  *transformations.add_transformation() =
+      TransformationAddSynonym(
+          11,
+          protobufs::TransformationAddSynonym::SynonymType::
+              TransformationAddSynonym_SynonymType_COPY_OBJECT,
+          104, MakeInstructionDescriptor(12, spv::Op::OpFunctionCall, 0))
+          .ToMessage();
+
+  // Full replay, recording a checkpoint after every other transformation.
+  protobufs::FactSequence empty_facts;
+  std::vector<Replayer::Checkpoint> checkpoints;
+  Replayer full_replayer(env, kConsoleMessageConsumer, binary_in, empty_facts,
+                         transformations,
+                         transformations.transformation_size(), true,
+                         validator_options);
+  full_replayer.RecordCheckpoints(2, &checkpoints);
+  auto full_result = full_replayer.Run();
+  ASSERT_EQ(Replayer::ReplayerResultStatus::kComplete, full_result.status);
+  ASSERT_EQ(2u, checkpoints.size());
+  ASSERT_EQ(2u, checkpoints[0].num_applied_transformations);
+  ASSERT_EQ(4u, checkpoints[1].num_applied_transformations);
+
+  // Remove the third transformation and resume from the first checkpoint.
+  protobufs::TransformationSequence shorter_transformations;
+  for (int i : {0, 1, 3}) {
+    *shorter_transformations.add_transformation() =
+        transformations.transformation(i);
+  }
+  Replayer resumed_replayer(env, kConsoleMessageConsumer, binary_in,
+                            empty_facts, shorter_transformations,
+                            shorter_transformations.transformation_size(),
+                            true, validator_options);
+  resumed_replayer.ResumeFrom(&checkpoints[0]);
+  auto resumed_result = resumed_replayer.Run();
+  ASSERT_EQ(Replayer::ReplayerResultStatus::kComplete, resumed_result.status);
+  ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+      shorter_transformations, resumed_result.applied_transformations));
+
+  // The result should be that of a replay from the input binary.
+  auto expected_result =
+      Replayer(env, kConsoleMessageConsumer, binary_in, empty_facts,
+               shorter_transformations,
+               shorter_transformations.transformation_size(), true,
+               validator_options)
+          .Run();
+  ASSERT_EQ(Replayer::ReplayerResultStatus::kComplete, expected_result.status);
+  std::vector<uint32_t> expected_binary;
+  expected_result.transformed_module->module()->ToBinary(&expected_binary,
+                                                         false);
+  std::vector<uint32_t> resumed_binary;
+  resumed_result.transformed_module->module()->ToBinary(&resumed_binary,
+                                                        false);
+  ASSERT_EQ(expected_binary, resumed_binary);
+
+  // The facts from before the checkpoint should have been carried over.
+  auto fact_manager = resumed_result.transformation_context->GetFactManager();
+  ASSERT_TRUE(fact_manager->IdIsIrrelevant(100));
+  ASSERT_TRUE(fact_manager->PointeeValueIsIrrelevant(101));
+  ASSERT_FALSE(fact_manager->IdIsIrrelevant(102));
+  ASSERT_TRUE(fact_manager->IsSynonymous(MakeDataDescriptor(11, {}),
+                                         MakeDataDescriptor(104, {})));
+
+  // The checkpoint should not have been affected by the resumed replay.
+  ASSERT_FALSE(checkpoints[0].fact_manager->IsSynonymous(
+      MakeDataDescriptor(11, {}), MakeDataDescriptor(104, {})));
+  ASSERT_EQ(nullptr, checkpoints[0].ir_context->get_def_use_mgr()->GetDef(104));
+}
+
 }  // namespace
 }  // namespace fuzz
 }  // namespace spvtools
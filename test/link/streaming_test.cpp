@@ -0,0 +1,240 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/opt/build_module.h"
+#include "test/link/linker_fixture.h"
+
+namespace spvtools {
+namespace {
+
+using ::testing::HasSubstr;
+using Streaming = spvtest::LinkerTest;
+
+// Links |bodies| with and without streaming, and expects the same result.
+void ExpectSameAsDefault(spvtest::LinkerTest* test,
+                         const std::vector<std::string>& bodies,
+                         LinkerOptions options = LinkerOptions()) {
+  spvtest::Binary default_binary;
+  ASSERT_EQ(SPV_SUCCESS,
+            test->AssembleAndLink(bodies, &default_binary, options))
+      << test->GetErrorMessage();
+
+  options.SetStreaming(true);
+  spvtest::Binary streamed_binary;
+  ASSERT_EQ(SPV_SUCCESS,
+            test->AssembleAndLink(bodies, &streamed_binary, options))
+      << test->GetErrorMessage();
+
+  std::string default_text;
+  std::string streamed_text;
+  EXPECT_EQ(SPV_SUCCESS, test->Disassemble(default_binary, &default_text));
+  EXPECT_EQ(SPV_SUCCESS, test->Disassemble(streamed_binary, &streamed_text));
+  EXPECT_EQ(default_text, streamed_text);
+  EXPECT_EQ(default_binary, streamed_binary);
+}
+
+TEST_F(Streaming, SameAsDefault) {
+  const std::string body1 = R"(
+OpCapability Linkage
+OpCapability Shader
+%1 = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpSource GLSL 450
+OpName %s "S"
+OpMemberName %s 0 "a"
+OpName %foo "foo"
+OpDecorate %foo LinkageAttributes "foo" Import
+OpDecorate %rs Block
+%void = OpTypeVoid
+%float = OpTypeFloat 32
+%s = OpTypeStruct %float %float
+%rs = OpTypeStruct %float
+%ptr = OpTypePointer Function %s
+%fn = OpTypeFunction %float %ptr
+%foo = OpFunction %float None %fn
+%p = OpFunctionParameter %ptr
+OpFunctionEnd
+)";
+  const std::string body2 = R"(
+OpCapability Linkage
+OpCapability Shader
+%1 = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpSource GLSL 450
+OpName %s "T"
+OpName %foo "foo"
+OpDecorate %foo LinkageAttributes "foo" Export
+OpDecorate %rs Block
+%void = OpTypeVoid
+%float = OpTypeFloat 32
+%int = OpTypeInt 32 1
+%s = OpTypeStruct %float %float
+%rs = OpTypeStruct %float
+%ptr = OpTypePointer Function %s
+%fn = OpTypeFunction %float %ptr
+%zero = OpConstant %float 0
+%foo = OpFunction %float None %fn
+%p = OpFunctionParameter %ptr
+%entry = OpLabel
+%x = OpExtInst %float %1 Sqrt %zero
+OpReturnValue %x
+OpFunctionEnd
+)";
+  const std::string body3 = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+%void = OpTypeVoid
+%main_fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%main = OpFunction %void None %main_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  ExpectSameAsDefault(this, {body1, body2, body3});
+
+  LinkerOptions options;
+  options.SetCreateLibrary(true);
+  ExpectSameAsDefault(this, {body1, body2, body3}, options);
+}
+
+TEST_F(Streaming, ForwardPointers) {
+  const std::string body = R"(
+OpCapability Addresses
+OpCapability Kernel
+OpCapability Linkage
+OpMemoryModel Physical64 OpenCL
+OpTypeForwardPointer %ptr CrossWorkgroup
+%int = OpTypeInt 32 0
+%node = OpTypeStruct %int %ptr
+%ptr = OpTypePointer CrossWorkgroup %node
+%other = OpTypePointer CrossWorkgroup %int
+)";
+
+  ExpectSameAsDefault(this, {body, body});
+}
+
+TEST_F(Streaming, MemoryModelMismatch) {
+  const std::string body1 = R"(
+OpMemoryModel Logical Simple
+)";
+  const std::string body2 = R"(
+OpMemoryModel Logical GLSL450
+)";
+
+  LinkerOptions options;
+  options.SetStreaming(true);
+  spvtest::Binary linked_binary;
+  EXPECT_EQ(SPV_ERROR_INTERNAL,
+            AssembleAndLink({body1, body2}, &linked_binary, options));
+  EXPECT_THAT(GetErrorMessage(),
+              HasSubstr("Conflicting memory models: Simple (input modules 1 "
+                        "through 1) vs GLSL450 (input module 2)."));
+}
+
+TEST_F(Streaming, DuplicateEntryPoint) {
+  const std::string body = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%main = OpFunction %void None %fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  LinkerOptions options;
+  options.SetStreaming(true);
+  spvtest::Binary linked_binary;
+  EXPECT_EQ(SPV_ERROR_INTERNAL,
+            AssembleAndLink({body, body}, &linked_binary, options));
+  EXPECT_THAT(GetErrorMessage(),
+              HasSubstr("The entry point \"main\", with execution model "
+                        "GLCompute, was already defined."));
+}
+
+// The ids differ from the default mode, as the debug line instructions added
+// by the loader take their ids from the linked module, but they must still be
+// unique.
+TEST_F(Streaming, DebugLines) {
+  const std::string body = R"(
+OpCapability Shader
+OpCapability Linkage
+OpExtension "SPV_KHR_non_semantic_info"
+%ext = OpExtInstImport "NonSemantic.Shader.DebugInfo.100"
+OpMemoryModel Logical GLSL450
+%file = OpString "a.hlsl"
+%code = OpString "void f() {}"
+%void = OpTypeVoid
+%uint = OpTypeInt 32 0
+%uint_0 = OpConstant %uint 0
+%uint_1 = OpConstant %uint 1
+%uint_2 = OpConstant %uint 2
+%fn = OpTypeFunction %void
+%src = OpExtInst %void %ext DebugSource %file %code
+%f = OpFunction %void None %fn
+%entry = OpLabel
+%line1 = OpExtInst %void %ext DebugLine %src %uint_1 %uint_1 %uint_0 %uint_0
+%x = OpCopyObject %uint %uint_1
+%y = OpCopyObject %uint %x
+OpBranch %next
+%next = OpLabel
+%line2 = OpExtInst %void %ext DebugLine %src %uint_2 %uint_2 %uint_0 %uint_0
+%z = OpCopyObject %uint %uint_2
+OpReturn
+OpFunctionEnd
+)";
+
+  LinkerOptions options;
+  options.SetStreaming(true);
+  spvtest::Binary linked_binary;
+  ASSERT_EQ(SPV_SUCCESS,
+            AssembleAndLink({body, body, body}, &linked_binary, options))
+      << GetErrorMessage();
+  EXPECT_TRUE(Validate(linked_binary)) << GetErrorMessage();
+
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, linked_binary.data(),
+                  linked_binary.size(), /* extra_line_tracking = */ false);
+  ASSERT_NE(nullptr, context);
+  const uint32_t id_bound = context->module()->id_bound();
+  std::unordered_set<uint32_t> result_ids;
+  uint32_t num_debug_lines = 0;
+  context->module()->ForEachInst(
+      [id_bound, &result_ids, &num_debug_lines](const opt::Instruction* inst) {
+        if (inst->IsDebugLineInst()) ++num_debug_lines;
+        if (inst->result_id() != 0) {
+          EXPECT_TRUE(result_ids.insert(inst->result_id()).second)
+              << "Duplicate id " << inst->result_id();
+          EXPECT_LT(inst->result_id(), id_bound);
+        }
+      },
+      /* run_on_debug_line_insts = */ true);
+  // Each module has two different lines.
+  EXPECT_GE(num_debug_lines, 6u);
+}
+
+}  // namespace
+}  // namespace spvtools
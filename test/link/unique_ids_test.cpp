@@ -139,5 +139,44 @@ TEST_F(UniqueIds, UniquelyMerged) {
   EXPECT_THAT(GetErrorMessage(), std::string());
 }
 
+// The NonSemantic DebugLine instructions attached to the instructions of each
+// module, including those added by the loader, must get ids of their own.
+TEST_F(UniqueIds, DebugLinesInFunctions) {
+  const std::string body = R"(
+OpCapability Shader
+OpCapability Linkage
+OpExtension "SPV_KHR_non_semantic_info"
+%ext = OpExtInstImport "NonSemantic.Shader.DebugInfo.100"
+OpMemoryModel Logical GLSL450
+%file = OpString "a.hlsl"
+%code = OpString "void f() {}"
+%void = OpTypeVoid
+%uint = OpTypeInt 32 0
+%uint_0 = OpConstant %uint 0
+%uint_1 = OpConstant %uint 1
+%uint_2 = OpConstant %uint 2
+%fn = OpTypeFunction %void
+%src = OpExtInst %void %ext DebugSource %file %code
+%f = OpFunction %void None %fn
+%entry = OpLabel
+%line1 = OpExtInst %void %ext DebugLine %src %uint_1 %uint_1 %uint_0 %uint_0
+%x = OpCopyObject %uint %uint_1
+%y = OpCopyObject %uint %x
+OpBranch %next
+%next = OpLabel
+%line2 = OpExtInst %void %ext DebugLine %src %uint_2 %uint_2 %uint_0 %uint_0
+%z = OpCopyObject %uint %uint_2
+OpReturn
+OpFunctionEnd
+)";
+
+  spvtest::Binary linked_binary;
+  LinkerOptions options;
+  options.SetVerifyIds(true);
+  ASSERT_EQ(SPV_SUCCESS, AssembleAndLink({body, body}, &linked_binary, options))
+      << GetErrorMessage();
+  EXPECT_TRUE(Validate(linked_binary)) << GetErrorMessage();
+}
+
 }  // namespace
 }  // namespace spvtools
@@ -1430,6 +1430,39 @@ TEST(AnalyzeInstDefUse, AddNewInstruction) {
   CheckUse(expected, &manager, context->module()->IdBound());
 }
 
+TEST(AnalyzeInstDefUse, UsersMayChangeWhileIterating) {
+  const std::string input = R"(
+%1 = OpTypeInt 32 0
+%2 = OpConstant %1 1
+%3 = OpConstant %1 2
+%4 = OpConstant %1 3
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, input,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  DefUseManager manager(context->module());
+
+  Instruction* first = manager.GetDef(2);
+  Instruction* removed = manager.GetDef(3);
+  Instruction added(context.get(), spv::Op::OpConstant, 1, 5,
+                    {{SPV_OPERAND_TYPE_LITERAL_INTEGER, {4}}});
+
+  // Users are visited in the order they were created.  A user added during
+  // the iteration is visited, and a removed one is not.
+  std::vector<Instruction*> visited;
+  manager.ForEachUser(1, [&](Instruction* user) {
+    if (user == first) {
+      manager.ClearInst(removed);
+      manager.AnalyzeInstDefUse(&added);
+    }
+    visited.push_back(user);
+  });
+  EXPECT_EQ((std::vector<Instruction*>{first, manager.GetDef(4), &added}),
+            visited);
+  EXPECT_EQ(3u, manager.NumUsers(1));
+}
+
 struct KillInstTestCase {
   const char* before;
   std::unordered_set<uint32_t> indices_for_inst_to_kill;
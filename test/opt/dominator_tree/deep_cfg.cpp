@@ -0,0 +1,80 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "source/opt/dominator_analysis.h"
+#include "source/opt/pass.h"
+#include "test/opt/function_utils.h"
+#include "test/opt/pass_fixture.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+using PassClassTest = PassTest<::testing::Test>;
+
+// Block %(10 + i) branches to the next block and back to block
+// %(10 + i / 2), so the CFG is a long chain with many nested back-edges.
+std::string DeepChain(uint32_t num_blocks) {
+  std::string text = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %4 "main"
+               OpExecutionMode %4 OriginUpperLeft
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %5 = OpTypeBool
+          %6 = OpConstantTrue %5
+          %4 = OpFunction %2 None %3
+)";
+  for (uint32_t i = 0; i < num_blocks; ++i) {
+    text += "%" + std::to_string(10 + i) + " = OpLabel\n";
+    if (i + 1 == num_blocks) {
+      text += "OpReturn\n";
+    } else {
+      text += "OpBranchConditional %6 %" + std::to_string(11 + i) + " %" +
+              std::to_string(10 + i / 2) + "\n";
+    }
+  }
+  text += "OpFunctionEnd\n";
+  return text;
+}
+
+TEST_F(PassClassTest, DeepChainDominators) {
+  const uint32_t kNumBlocks = 20000;
+  const std::string text = DeepChain(kNumBlocks);
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  const Function* f = spvtest::GetFunction(context->module(), 4);
+
+  DominatorAnalysis* dom = context->GetDominatorAnalysis(f);
+  for (uint32_t i = 1; i < kNumBlocks; ++i) {
+    ASSERT_EQ(9 + i, dom->ImmediateDominator(10 + i)->id());
+  }
+
+  // Every block only reaches the return through the blocks after it.
+  PostDominatorAnalysis* post_dom = context->GetPostDominatorAnalysis(f);
+  for (uint32_t i = 0; i + 1 < kNumBlocks; ++i) {
+    ASSERT_EQ(11 + i, post_dom->ImmediateDominator(10 + i)->id());
+  }
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
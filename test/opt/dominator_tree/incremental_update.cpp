@@ -0,0 +1,273 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/opt/block_merge_pass.h"
+#include "source/opt/dominator_analysis.h"
+#include "source/opt/pass.h"
+#include "test/opt/assembly_builder.h"
+#include "test/opt/function_utils.h"
+#include "test/opt/pass_fixture.h"
+#include "test/opt/pass_utils.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+using PassClassTest = PassTest<::testing::Test>;
+
+// Blocks %17 and %18 are unreachable.  The conditional branches with the same
+// target twice let the tests add an edge by changing a single operand.
+const std::string kShader = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %4 "main"
+               OpExecutionMode %4 OriginUpperLeft
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %5 = OpTypeBool
+          %6 = OpConstantTrue %5
+          %4 = OpFunction %2 None %3
+         %10 = OpLabel
+               OpBranchConditional %6 %11 %12
+         %11 = OpLabel
+               OpBranchConditional %6 %13 %13
+         %12 = OpLabel
+               OpBranch %13
+         %13 = OpLabel
+               OpBranchConditional %6 %14 %15
+         %14 = OpLabel
+               OpBranch %16
+         %15 = OpLabel
+               OpBranch %16
+         %16 = OpLabel
+               OpReturn
+         %17 = OpLabel
+               OpBranch %14
+         %18 = OpLabel
+               OpBranch %17
+               OpFunctionEnd
+)";
+
+std::unique_ptr<IRContext> BuildShader() {
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, kShader,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  EXPECT_NE(nullptr, context) << "Assembling failed for shader:\n" << kShader;
+  return context;
+}
+
+// Checks that |tree| matches a tree built from scratch for |f|.
+void ExpectSameAsRebuilt(IRContext* context, const Function* f,
+                         const DominatorTree& tree) {
+  DominatorTree expected(tree.IsPostDominator());
+  expected.InitializeTree(*context->cfg(), f);
+
+  for (const BasicBlock& a : *f) {
+    EXPECT_EQ(expected.ImmediateDominator(&a), tree.ImmediateDominator(&a))
+        << "Block " << a.id();
+    for (const BasicBlock& b : *f) {
+      EXPECT_EQ(expected.Dominates(&a, &b), tree.Dominates(&a, &b))
+          << "Blocks " << a.id() << " and " << b.id();
+    }
+  }
+}
+
+BasicBlock* GetBlock(IRContext* context, uint32_t id) {
+  return context->get_instr_block(id);
+}
+
+TEST_F(PassClassTest, InsertAndDeleteEdgeBetweenReachableBlocks) {
+  std::unique_ptr<IRContext> context = BuildShader();
+  const Function* f = spvtest::GetFunction(context->module(), 4);
+  DominatorTree tree;
+  tree.InitializeTree(*context->cfg(), f);
+  EXPECT_EQ(13u, tree.ImmediateDominator(16)->id());
+
+  BasicBlock* bb11 = GetBlock(context.get(), 11);
+  BasicBlock* bb16 = GetBlock(context.get(), 16);
+  bb11->terminator()->SetInOperand(2, {16});
+  tree.InsertEdge(*context->cfg(), bb11, bb16);
+  EXPECT_EQ(10u, tree.ImmediateDominator(16)->id());
+  ExpectSameAsRebuilt(context.get(), f, tree);
+
+  bb11->terminator()->SetInOperand(2, {13});
+  tree.DeleteEdge(*context->cfg(), bb11, bb16);
+  EXPECT_EQ(13u, tree.ImmediateDominator(16)->id());
+  ExpectSameAsRebuilt(context.get(), f, tree);
+}
+
+TEST_F(PassClassTest, InsertAndDeleteEdgeToUnreachableBlock) {
+  std::unique_ptr<IRContext> context = BuildShader();
+  const Function* f = spvtest::GetFunction(context->module(), 4);
+  DominatorTree tree;
+  tree.InitializeTree(*context->cfg(), f);
+  EXPECT_EQ(nullptr, tree.GetTreeNode(18));
+
+  // %18 and %17 become reachable, and %17 branches to %14.
+  BasicBlock* bb11 = GetBlock(context.get(), 11);
+  BasicBlock* bb18 = GetBlock(context.get(), 18);
+  bb11->terminator()->SetInOperand(2, {18});
+  tree.InsertEdge(*context->cfg(), bb11, bb18);
+  EXPECT_EQ(11u, tree.ImmediateDominator(18)->id());
+  EXPECT_EQ(18u, tree.ImmediateDominator(17)->id());
+  EXPECT_EQ(10u, tree.ImmediateDominator(14)->id());
+  ExpectSameAsRebuilt(context.get(), f, tree);
+
+  bb11->terminator()->SetInOperand(2, {13});
+  tree.DeleteEdge(*context->cfg(), bb11, bb18);
+  EXPECT_EQ(nullptr, tree.GetTreeNode(18));
+  EXPECT_EQ(nullptr, tree.GetTreeNode(17));
+  EXPECT_EQ(13u, tree.ImmediateDominator(14)->id());
+  ExpectSameAsRebuilt(context.get(), f, tree);
+}
+
+TEST_F(PassClassTest, SeveralEdgeUpdatesBeforeQuery) {
+  std::unique_ptr<IRContext> context = BuildShader();
+  const Function* f = spvtest::GetFunction(context->module(), 4);
+  DominatorTree tree;
+  tree.InitializeTree(*context->cfg(), f);
+
+  // The DF numbering is only recomputed by the query after the last update,
+  // so the updates in between must work from the depths alone.
+  BasicBlock* bb11 = GetBlock(context.get(), 11);
+  BasicBlock* bb16 = GetBlock(context.get(), 16);
+  BasicBlock* bb18 = GetBlock(context.get(), 18);
+  bb11->terminator()->SetInOperand(2, {16});
+  tree.InsertEdge(*context->cfg(), bb11, bb16);
+  bb11->terminator()->SetInOperand(2, {18});
+  tree.DeleteEdge(*context->cfg(), bb11, bb16);
+  tree.InsertEdge(*context->cfg(), bb11, bb18);
+  EXPECT_FALSE(tree.Dominates(13, 16));
+  EXPECT_TRUE(tree.Dominates(18, 17));
+  ExpectSameAsRebuilt(context.get(), f, tree);
+}
+
+TEST_F(PassClassTest, EdgeUpdatesRebuildPostDominatorTree) {
+  std::unique_ptr<IRContext> context = BuildShader();
+  const Function* f = spvtest::GetFunction(context->module(), 4);
+  DominatorTree tree(true);
+  tree.InitializeTree(*context->cfg(), f);
+  EXPECT_EQ(13u, tree.ImmediateDominator(11)->id());
+
+  BasicBlock* bb11 = GetBlock(context.get(), 11);
+  BasicBlock* bb16 = GetBlock(context.get(), 16);
+  bb11->terminator()->SetInOperand(2, {16});
+  tree.InsertEdge(*context->cfg(), bb11, bb16);
+  EXPECT_EQ(16u, tree.ImmediateDominator(11)->id());
+  ExpectSameAsRebuilt(context.get(), f, tree);
+}
+
+// Splits %13 before its terminator, checks the updated tree, and then merges
+// the blocks back in the tree only.
+void SplitAndMerge(bool post) {
+  std::unique_ptr<IRContext> context = BuildShader();
+  Function* f = spvtest::GetFunction(context->module(), 4);
+  DominatorTree original(post);
+  original.InitializeTree(*context->cfg(), f);
+  DominatorTree tree(post);
+  tree.InitializeTree(*context->cfg(), f);
+
+  BasicBlock* bb13 = GetBlock(context.get(), 13);
+  BasicBlock* new_bb = bb13->SplitBasicBlock(context.get(), 20, bb13->tail());
+  bb13->AddInstruction(MakeUnique<Instruction>(
+      context.get(), spv::Op::OpBranch, 0, 0,
+      std::initializer_list<Operand>{{SPV_OPERAND_TYPE_ID, {20}}}));
+  context->set_instr_block(new_bb->GetLabelInst(), new_bb);
+  context->cfg()->RegisterBlock(new_bb);
+
+  tree.SplitBlock(bb13, new_bb);
+  ExpectSameAsRebuilt(context.get(), f, tree);
+
+  tree.MergeBlocks(bb13, new_bb);
+  EXPECT_EQ(nullptr, tree.GetTreeNode(20));
+  for (const BasicBlock& a : *f) {
+    if (a.id() == 20) continue;
+    EXPECT_EQ(original.ImmediateDominator(&a), tree.ImmediateDominator(&a))
+        << "Block " << a.id();
+    for (const BasicBlock& b : *f) {
+      if (b.id() == 20) continue;
+      EXPECT_EQ(original.Dominates(&a, &b), tree.Dominates(&a, &b))
+          << "Blocks " << a.id() << " and " << b.id();
+    }
+  }
+}
+
+TEST_F(PassClassTest, SplitAndMergeBlocks) { SplitAndMerge(false); }
+
+TEST_F(PassClassTest, SplitAndMergeBlocksPostDominator) {
+  SplitAndMerge(true);
+}
+
+TEST_F(PassClassTest, BlockMergeUpdatesDominatorTrees) {
+  // %13 is merged into %11, and %15 into %14.
+  const std::string text = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %4 "main"
+               OpExecutionMode %4 OriginUpperLeft
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %5 = OpTypeBool
+          %6 = OpConstantTrue %5
+          %4 = OpFunction %2 None %3
+         %10 = OpLabel
+               OpSelectionMerge %14 None
+               OpBranchConditional %6 %11 %12
+         %11 = OpLabel
+               OpBranch %13
+         %13 = OpLabel
+               OpBranch %14
+         %12 = OpLabel
+               OpBranch %14
+         %14 = OpLabel
+               OpBranch %15
+         %15 = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  Function* f = spvtest::GetFunction(context->module(), 4);
+  context->GetDominatorAnalysis(f);
+  context->GetPostDominatorAnalysis(f);
+
+  BlockMergePass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  EXPECT_EQ(nullptr, context->get_def_use_mgr()->GetDef(13));
+  EXPECT_EQ(nullptr, context->get_def_use_mgr()->GetDef(15));
+  EXPECT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisCFG |
+                                        IRContext::kAnalysisDominatorAnalysis));
+
+  DominatorAnalysis* dominators = context->FindDominatorAnalysis(f);
+  ASSERT_NE(nullptr, dominators);
+  EXPECT_EQ(10u, dominators->GetDomTree().ImmediateDominator(14)->id());
+  ExpectSameAsRebuilt(context.get(), f, dominators->GetDomTree());
+
+  PostDominatorAnalysis* post_dominators =
+      context->FindPostDominatorAnalysis(f);
+  ASSERT_NE(nullptr, post_dominators);
+  EXPECT_EQ(14u, post_dominators->GetDomTree().ImmediateDominator(11)->id());
+  ExpectSameAsRebuilt(context.get(), f, post_dominators->GetDomTree());
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
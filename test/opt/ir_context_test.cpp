@@ -302,6 +302,65 @@ TEST_F(IRContextTest, TakeNextUniqueIdIncrementing) {
     EXPECT_EQ(i, localContext.TakeNextUniqueId());
 }
 
+TEST_F(IRContextTest, InstructionsMayOutliveTheirContext) {
+  std::unique_ptr<Instruction> inst;
+  std::unique_ptr<Instruction> clone;
+  {
+    IRContext localContext(SPV_ENV_UNIVERSAL_1_2, nullptr);
+    inst.reset(new (&localContext) Instruction(
+        &localContext, spv::Op::OpTypeInt, 0, 1,
+        {{SPV_OPERAND_TYPE_LITERAL_INTEGER, {32}},
+         {SPV_OPERAND_TYPE_LITERAL_INTEGER, {0}}}));
+    clone.reset(inst->Clone(&localContext));
+  }
+  EXPECT_EQ(spv::Op::OpTypeInt, inst->opcode());
+  EXPECT_EQ(32u, clone->GetSingleWordInOperand(0));
+}
+
+TEST_F(IRContextTest, CloneHasTheSameBinaryAndIsIndependent) {
+  const std::string text = R"(
+               OpCapability Shader
+               OpExtension "SPV_KHR_non_semantic_info"
+          %1 = OpExtInstImport "NonSemantic.Shader.DebugInfo.100"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %2 "main"
+               OpExecutionMode %2 OriginUpperLeft
+          %3 = OpString "a.frag"
+          %4 = OpTypeVoid
+          %5 = OpTypeInt 32 0
+          %6 = OpConstant %5 1
+          %7 = OpTypeFunction %4
+          %8 = OpExtInst %4 %1 DebugSource %3
+          %2 = OpFunction %4 None %7
+          %9 = OpLabel
+         %10 = OpExtInst %4 %1 DebugLine %8 %6 %6 %6 %6
+               OpLine %3 2 1
+               OpReturn
+               OpFunctionEnd
+  )";
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  std::vector<uint32_t> original;
+  context->module()->ToBinary(&original, false);
+
+  std::unique_ptr<IRContext> clone = context->Clone();
+  std::vector<uint32_t> copy;
+  clone->module()->ToBinary(&copy, false);
+  EXPECT_EQ(original, copy);
+
+  clone->KillInst(&*clone->module()->execution_mode_begin());
+  copy.clear();
+  clone->module()->ToBinary(&copy, false);
+  EXPECT_NE(original, copy);
+
+  std::vector<uint32_t> after;
+  context->module()->ToBinary(&after, false);
+  EXPECT_EQ(original, after);
+}
+
 TEST_F(IRContextTest, KillGroupDecorationWitNoDecorations) {
   const std::string text = R"(
                OpCapability Shader
@@ -0,0 +1,187 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/module_template.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "source/opt/build_module.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/optimizer.hpp"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+const spv_target_env kEnv = SPV_ENV_UNIVERSAL_1_3;
+
+const std::string kPreamble = R"(
+OpCapability Shader
+%glsl = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+OpName %main "main"
+OpName %out "out"
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%int = OpTypeInt 32 1
+%float = OpTypeFloat 32
+%int_2 = OpConstant %int 2
+%float_2 = OpConstant %float 2
+%ptr_float = OpTypePointer Private %float
+%out = OpVariable %ptr_float Private
+)";
+
+// A function body switching on a module-level constant and calling an
+// extended instruction, which the parser can only decode knowing the
+// module-level instructions.
+const std::string kBodyA = R"(
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpSelectionMerge %merge None
+OpSwitch %int_2 %merge 1 %case
+%case = OpLabel
+%sqrt = OpExtInst %float %glsl Sqrt %float_2
+OpStore %out %sqrt
+OpBranch %merge
+%merge = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+const std::string kBodyB = R"(
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+%value = OpExtInst %float %glsl Fabs %float_2
+OpStore %out %value
+OpReturn
+OpFunctionEnd
+)";
+
+std::vector<uint32_t> Assemble(const std::string& text) {
+  std::vector<uint32_t> binary;
+  SpirvTools tools(kEnv);
+  EXPECT_TRUE(tools.Assemble(text, &binary,
+                             SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS))
+      << text;
+  return binary;
+}
+
+std::vector<uint32_t> ToBinary(IRContext* context) {
+  std::vector<uint32_t> binary;
+  context->module()->ToBinary(&binary, /* skip_nop = */ false);
+  return binary;
+}
+
+// Checks that loading |variant| through |module_template| gives the same
+// module as loading it directly.
+void ExpectSameAsBuildModule(const ModuleTemplate& module_template,
+                             const std::vector<uint32_t>& variant) {
+  std::unique_ptr<IRContext> expected =
+      BuildModule(kEnv, nullptr, variant.data(), variant.size());
+  std::unique_ptr<IRContext> actual =
+      module_template.BuildModule(nullptr, variant.data(), variant.size());
+  ASSERT_NE(nullptr, expected);
+  ASSERT_NE(nullptr, actual);
+  EXPECT_EQ(ToBinary(expected.get()), ToBinary(actual.get()));
+  EXPECT_EQ(expected->module()->IdBound(), actual->module()->IdBound());
+}
+
+TEST(ModuleTemplateTest, ReusesMatchingModuleLevelInstructions) {
+  const std::vector<uint32_t> base = Assemble(kPreamble + kBodyA);
+  const std::vector<uint32_t> variant = Assemble(kPreamble + kBodyB);
+  auto module_template =
+      ModuleTemplate::Create(kEnv, nullptr, base.data(), base.size());
+  ASSERT_NE(nullptr, module_template);
+
+  EXPECT_TRUE(module_template->Matches(base.data(), base.size()));
+  EXPECT_TRUE(module_template->Matches(variant.data(), variant.size()));
+  ExpectSameAsBuildModule(*module_template, base);
+  ExpectSameAsBuildModule(*module_template, variant);
+}
+
+TEST(ModuleTemplateTest, ParsesModulesThatDoNotMatch) {
+  const std::vector<uint32_t> base = Assemble(kPreamble + kBodyA);
+  const std::vector<uint32_t> variant =
+      Assemble(kPreamble + "%float_3 = OpConstant %float 3\n" + kBodyB);
+  auto module_template =
+      ModuleTemplate::Create(kEnv, nullptr, base.data(), base.size());
+  ASSERT_NE(nullptr, module_template);
+
+  EXPECT_FALSE(module_template->Matches(variant.data(), variant.size()));
+  ExpectSameAsBuildModule(*module_template, variant);
+}
+
+TEST(ModuleTemplateTest, ModuleWithoutFunctionsIsNotReused) {
+  const std::vector<uint32_t> base = Assemble(kPreamble);
+  auto module_template =
+      ModuleTemplate::Create(kEnv, nullptr, base.data(), base.size());
+  ASSERT_NE(nullptr, module_template);
+
+  EXPECT_FALSE(module_template->Matches(base.data(), base.size()));
+  ExpectSameAsBuildModule(*module_template, base);
+}
+
+TEST(ModuleTemplateTest, ModuleWithLineInfoIsNotReused) {
+  const std::string preamble = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+%file = OpString "shader.comp"
+OpLine %file 1 1
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+)";
+  const std::string body = R"(
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+  const std::vector<uint32_t> base = Assemble(preamble + body);
+  auto module_template =
+      ModuleTemplate::Create(kEnv, nullptr, base.data(), base.size());
+  ASSERT_NE(nullptr, module_template);
+
+  EXPECT_FALSE(module_template->Matches(base.data(), base.size()));
+  ExpectSameAsBuildModule(*module_template, base);
+}
+
+TEST(ModuleTemplateTest, OptimizerUsesModuleTemplate) {
+  const std::vector<uint32_t> base = Assemble(kPreamble + kBodyA);
+  const std::vector<uint32_t> variant = Assemble(kPreamble + kBodyB);
+
+  Optimizer plain(kEnv);
+  plain.RegisterPerformancePasses();
+  std::vector<uint32_t> expected;
+  ASSERT_TRUE(plain.Run(variant.data(), variant.size(), &expected));
+
+  Optimizer templated(kEnv);
+  templated.RegisterPerformancePasses();
+  ASSERT_TRUE(templated.SetModuleTemplate(base.data(), base.size()));
+  std::vector<uint32_t> actual;
+  ASSERT_TRUE(templated.Run(variant.data(), variant.size(), &actual));
+
+  EXPECT_EQ(expected, actual);
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
@@ -14,6 +14,7 @@
 
 #include <initializer_list>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,6 +30,7 @@ namespace {
 
 using spvtest::GetIdBound;
 using ::testing::Eq;
+using ::testing::HasSubstr;
 
 // A null pass whose constructors accept arguments
 class NullPassWithArgs : public NullPass {
@@ -186,6 +188,68 @@ TEST(PassManager, RecomputeIdBoundAutomatically) {
   EXPECT_THAT(GetIdBound(*context.module()), Eq(201u));
 }
 
+// A pass that kills the last instruction in the debug1 section, after looking
+// at its uses.
+class KillLastDebug1InstPass : public Pass {
+ public:
+  const char* name() const override { return "KillLastDebug1Inst"; }
+  Status Process() override {
+    Instruction* inst = &*(--context()->debug1_end());
+    get_def_use_mgr()->ForEachUser(inst, [](Instruction*) {});
+    context()->KillInst(inst);
+    return Status::SuccessWithChange;
+  }
+};
+
+TEST(PassManager, ProfileCountsTheWorkOfEachPass) {
+  PassManager manager;
+  std::ostringstream profile;
+  manager.SetPassProfile(&profile, false);
+  manager.AddPass<AppendMultipleOpNopPass>(3);
+  manager.AddPass<KillLastDebug1InstPass>();
+
+  IRContext context(SPV_ENV_UNIVERSAL_1_2, MakeUnique<Module>(),
+                    manager.consumer());
+  EXPECT_EQ(Pass::Status::SuccessWithChange, manager.Run(&context));
+
+  const std::string json = profile.str();
+  const size_t append_pos = json.find("{\"name\": \"AppendOpNop\"");
+  const size_t kill_pos = json.find("{\"name\": \"KillLastDebug1Inst\"");
+  ASSERT_NE(std::string::npos, append_pos);
+  ASSERT_NE(std::string::npos, kill_pos);
+  ASSERT_LT(append_pos, kill_pos);
+
+  const std::string append = json.substr(append_pos, kill_pos - append_pos);
+  EXPECT_THAT(append, HasSubstr("\"status\": \"changed\""));
+  EXPECT_THAT(append, HasSubstr("\"instructions_created\": 3,"));
+  EXPECT_THAT(append, HasSubstr("\"instructions_killed\": 0,"));
+  EXPECT_THAT(append, HasSubstr("\"analysis_builds\": {}"));
+
+  const std::string kill = json.substr(kill_pos);
+  EXPECT_THAT(kill, HasSubstr("\"instructions_created\": 0,"));
+  EXPECT_THAT(kill, HasSubstr("\"instructions_killed\": 1,"));
+  EXPECT_THAT(kill, HasSubstr("\"analysis_builds\": {\"def-use\": 1"));
+  EXPECT_THAT(kill,
+              HasSubstr("\"analysis_invalidations\": {\"def-use\": 1"));
+}
+
+TEST(PassManager, ProfileAsChromeTrace) {
+  PassManager manager;
+  std::ostringstream profile;
+  manager.SetPassProfile(&profile, true);
+  manager.AddPass<AppendOpNopPass>();
+
+  IRContext context(SPV_ENV_UNIVERSAL_1_2, MakeUnique<Module>(),
+                    manager.consumer());
+  manager.Run(&context);
+
+  EXPECT_THAT(profile.str(), HasSubstr("\"traceEvents\": ["));
+  EXPECT_THAT(profile.str(),
+              HasSubstr("{\"name\": \"AppendOpNop\", \"cat\": \"pass\", "
+                        "\"ph\": \"X\""));
+  EXPECT_THAT(profile.str(), HasSubstr("\"instructions_created\": 1,"));
+}
+
 }  // anonymous namespace
 }  // namespace opt
 }  // namespace spvtools
@@ -216,6 +216,61 @@ OpDecorate %1 GLSLPacked
   EXPECT_EQ(GetErrorMessage(), "");
 }
 
+TEST_F(RemoveDuplicatesTest, SameTypeAndDecorationsInDifferentOrder) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 GLSLPacked
+OpDecorate %1 Block
+OpDecorate %2 Block
+OpDecorate %2 GLSLPacked
+%3 = OpTypeInt 32 0
+%1 = OpTypeStruct %3 %3
+%2 = OpTypeStruct %3 %3
+)";
+  const std::string after = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 GLSLPacked
+OpDecorate %1 Block
+%3 = OpTypeInt 32 0
+%1 = OpTypeStruct %3 %3
+)";
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
+TEST_F(RemoveDuplicatesTest, DuplicateDecorations) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 Block
+OpMemberDecorate %1 0 Offset 0
+OpDecorate %1 Block
+OpMemberDecorate %1 1 Offset 4
+OpMemberDecorate %1 0 Offset 0
+OpMemberDecorate %1 1 Offset 8
+%2 = OpTypeInt 32 0
+%1 = OpTypeStruct %2 %2
+)";
+  const std::string after = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 Block
+OpMemberDecorate %1 0 Offset 0
+OpMemberDecorate %1 1 Offset 4
+OpMemberDecorate %1 1 Offset 8
+%2 = OpTypeInt 32 0
+%1 = OpTypeStruct %2 %2
+)";
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
 TEST_F(RemoveDuplicatesTest, SameTypeAndDifferentName) {
   const std::string spirv = R"(
 OpCapability Shader
@@ -304,6 +359,35 @@ OpGroupDecorate %2 %4
   EXPECT_EQ(GetErrorMessage(), "");
 }
 
+// Group decorations are not compared, so identical ones are kept.
+TEST_F(RemoveDuplicatesTest, KeepIdenticalGroupDecorations) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 Constant
+OpDecorate %1 Constant
+%1 = OpDecorationGroup
+OpGroupDecorate %1 %2
+OpGroupDecorate %1 %2
+%3 = OpTypeInt 32 0
+%2 = OpVariable %3 Uniform
+)";
+  const std::string after = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 Constant
+%1 = OpDecorationGroup
+OpGroupDecorate %1 %2
+OpGroupDecorate %1 %2
+%3 = OpTypeInt 32 0
+%2 = OpVariable %3 Uniform
+)";
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
 // Test what happens when a type is a resource type.  For now we are merging
 // them, but, if we want to merge types and make reflection work (issue #1372),
 // we will not be able to merge %2 and %3 below.
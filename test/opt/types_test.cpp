@@ -502,6 +502,35 @@ TEST(Types, RemoveDecorations) {
   }
 }
 
+TEST(Types, HashIgnoresDecorationOrder) {
+  Integer u32(32, false);
+  Struct s1({&u32, &u32});
+  s1.AddDecoration({uint32_t(spv::Decoration::Block)});
+  s1.AddDecoration({uint32_t(spv::Decoration::GLSLPacked)});
+  s1.AddMemberDecoration(0, {uint32_t(spv::Decoration::Offset), 0});
+  s1.AddMemberDecoration(0, {uint32_t(spv::Decoration::RelaxedPrecision)});
+  Struct s2({&u32, &u32});
+  s2.AddDecoration({uint32_t(spv::Decoration::GLSLPacked)});
+  s2.AddDecoration({uint32_t(spv::Decoration::Block)});
+  s2.AddMemberDecoration(0, {uint32_t(spv::Decoration::RelaxedPrecision)});
+  s2.AddMemberDecoration(0, {uint32_t(spv::Decoration::Offset), 0});
+
+  EXPECT_TRUE(s1 == s2);
+  EXPECT_EQ(s1.HashValue(), s2.HashValue());
+}
+
+TEST(Types, ForwardPointerHashMatchesEquality) {
+  Integer u32(32, false);
+  Pointer pointer(&u32, spv::StorageClass::CrossWorkgroup);
+  ForwardPointer fp1(1, spv::StorageClass::CrossWorkgroup);
+  ForwardPointer fp2(2, spv::StorageClass::CrossWorkgroup);
+  fp1.SetTargetPointer(&pointer);
+  fp2.SetTargetPointer(&pointer);
+
+  EXPECT_TRUE(fp1 == fp2);
+  EXPECT_EQ(fp1.HashValue(), fp2.HashValue());
+}
+
 TEST(Types, UntypedPointer) {
   std::unique_ptr<Type> type(new Pointer(nullptr, spv::StorageClass::Uniform));
   const auto untyped = type->AsPointer();
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "tools/io.h"
+
+namespace spvtools {
+namespace {
+
+using ::testing::ElementsAre;
+
+class ReadBinaryFileTest : public ::testing::Test {
+ protected:
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  // Writes |size| bytes of |data| to a temporary file and returns its name.
+  const char* WriteTempFile(const void* data, size_t size) {
+    path_ = (std::filesystem::temp_directory_path() /
+             ("read_binary_file_test_" +
+              std::string(::testing::UnitTest::GetInstance()
+                              ->current_test_info()
+                              ->name())))
+                .string();
+    EXPECT_TRUE(WriteFile<char>(path_.c_str(), "wb",
+                                static_cast<const char*>(data), size));
+    return path_.c_str();
+  }
+
+ private:
+  std::string path_;
+};
+
+TEST_F(ReadBinaryFileTest, ReadsBinary) {
+  const uint32_t words[] = {0x07230203, 0x00010000, 0, 5, 0};
+  const char* filename = WriteTempFile(words, sizeof(words));
+
+  BinaryFileContents contents;
+  ASSERT_TRUE(ReadBinaryFile(filename, &contents));
+#if defined(__linux__)
+  EXPECT_TRUE(contents.is_mapped());
+#endif
+  std::vector<uint32_t> read(contents.data(),
+                             contents.data() + contents.size());
+  EXPECT_THAT(read, ElementsAre(0x07230203, 0x00010000, 0, 5, 0));
+
+  // The vector overload reads the same words.
+  std::vector<uint32_t> vector_contents;
+  ASSERT_TRUE(ReadBinaryFile(filename, &vector_contents));
+  EXPECT_EQ(read, vector_contents);
+}
+
+TEST_F(ReadBinaryFileTest, ReadsHexStream) {
+  // A multiple of four bytes long, so that only the contents tell it apart
+  // from a binary.
+  const char hex[] = "0x07230203 0x10000 0x0 ";
+  const char* filename = WriteTempFile(hex, strlen(hex));
+
+  BinaryFileContents contents;
+  ASSERT_TRUE(ReadBinaryFile(filename, &contents));
+  EXPECT_FALSE(contents.is_mapped());
+  std::vector<uint32_t> read(contents.data(),
+                             contents.data() + contents.size());
+  EXPECT_THAT(read, ElementsAre(0x07230203, 0x00010000, 0));
+}
+
+TEST_F(ReadBinaryFileTest, RejectsPartialWord) {
+  const char bytes[] = {0x03, 0x02, 0x23, 0x07, 0x00, 0x00};
+  const char* filename = WriteTempFile(bytes, sizeof(bytes));
+
+  BinaryFileContents contents;
+  EXPECT_FALSE(ReadBinaryFile(filename, &contents));
+}
+
+TEST_F(ReadBinaryFileTest, ReadsEmptyFile) {
+  const char* filename = WriteTempFile("", 0);
+
+  BinaryFileContents contents;
+  ASSERT_TRUE(ReadBinaryFile(filename, &contents));
+  EXPECT_TRUE(contents.empty());
+}
+
+}  // namespace
+}  // namespace spvtools
@@ -17,8 +17,13 @@
 #include <unordered_map>
 
 #include "source/opt/build_module.h"
+#include "source/reduce/merge_blocks_reduction_opportunity_finder.h"
 #include "source/reduce/operand_to_const_reduction_opportunity_finder.h"
+#include "source/reduce/operand_to_dominating_id_reduction_opportunity_finder.h"
+#include "source/reduce/operand_to_undef_reduction_opportunity_finder.h"
+#include "source/reduce/remove_block_reduction_opportunity_finder.h"
 #include "source/reduce/remove_unused_instruction_reduction_opportunity_finder.h"
+#include "source/reduce/simple_conditional_branch_to_branch_opportunity_finder.h"
 #include "test/reduce/reduce_test_util.h"
 
 namespace spvtools {
@@ -558,6 +563,100 @@ TEST(ReducerTest, ShaderReduceWhileDivReachable) {
   ASSERT_EQ(status, Reducer::ReductionResultStatus::kComplete);
 }
 
+TEST(ReducerTest, ParallelReductionMatchesSerialReduction) {
+  std::vector<uint32_t> binary_in;
+  SpirvTools t(kEnv);
+  ASSERT_TRUE(
+      t.Assemble(kShaderWithLoopsDivAndMul, &binary_in, kReduceAssembleOption));
+
+  std::vector<std::vector<uint32_t>> binaries_out;
+  for (uint32_t num_threads : {1u, 4u}) {
+    Reducer reducer(kEnv);
+    reducer.SetInterestingnessFunction(InterestingWhileSDivReachable);
+    reducer.AddDefaultReductionPasses();
+    reducer.SetMessageConsumer(kMessageConsumer);
+
+    spvtools::ReducerOptions reducer_options;
+    reducer_options.set_step_limit(500);
+    reducer_options.set_fail_on_validation_error(true);
+    reducer_options.set_num_threads(num_threads);
+    spvtools::ValidatorOptions validator_options;
+
+    std::vector<uint32_t> binary_out;
+    Reducer::ReductionResultStatus status = reducer.Run(
+        binary_in, &binary_out, reducer_options, validator_options);
+    ASSERT_EQ(status, Reducer::ReductionResultStatus::kComplete);
+    binaries_out.push_back(std::move(binary_out));
+  }
+  ASSERT_EQ(binaries_out[0], binaries_out[1]);
+}
+
+// Wraps a finder, hiding whether it finds opportunities per function, so that
+// reduction passes using it search the whole module at every step.
+class WholeModuleFinder : public ReductionOpportunityFinder {
+ public:
+  explicit WholeModuleFinder(std::unique_ptr<ReductionOpportunityFinder> finder)
+      : finder_(std::move(finder)) {}
+
+  std::vector<std::unique_ptr<ReductionOpportunity>> GetAvailableOpportunities(
+      opt::IRContext* context, uint32_t target_function) const override {
+    return finder_->GetAvailableOpportunities(context, target_function);
+  }
+
+  std::string GetName() const override { return finder_->GetName(); }
+
+ private:
+  std::unique_ptr<ReductionOpportunityFinder> finder_;
+};
+
+TEST(ReducerTest, PerFunctionFindingMatchesWholeModuleFinding) {
+  std::vector<uint32_t> binary_in;
+  SpirvTools t(kEnv);
+  ASSERT_TRUE(t.Assemble(kShaderWithMultipleFunctions, &binary_in,
+                         kReduceAssembleOption));
+
+  std::vector<std::vector<uint32_t>> binaries_out;
+  for (bool whole_module : {false, true}) {
+    std::vector<std::unique_ptr<ReductionOpportunityFinder>> finders;
+    finders.push_back(
+        MakeUnique<RemoveUnusedInstructionReductionOpportunityFinder>(false));
+    finders.push_back(MakeUnique<OperandToUndefReductionOpportunityFinder>());
+    finders.push_back(
+        MakeUnique<OperandToDominatingIdReductionOpportunityFinder>());
+    finders.push_back(MakeUnique<RemoveBlockReductionOpportunityFinder>());
+    finders.push_back(
+        MakeUnique<SimpleConditionalBranchToBranchOpportunityFinder>());
+    finders.push_back(MakeUnique<MergeBlocksReductionOpportunityFinder>());
+
+    Reducer reducer(kEnv);
+    PingPongInteresting ping_pong_interesting(20);
+    reducer.SetInterestingnessFunction(
+        [&ping_pong_interesting](const std::vector<uint32_t>&,
+                                 uint32_t) -> bool {
+          return ping_pong_interesting.IsInteresting();
+        });
+    for (auto& finder : finders) {
+      if (whole_module) {
+        finder = MakeUnique<WholeModuleFinder>(std::move(finder));
+      }
+      reducer.AddReductionPass(std::move(finder));
+    }
+    reducer.SetMessageConsumer(kMessageConsumer);
+
+    spvtools::ReducerOptions reducer_options;
+    reducer_options.set_step_limit(500);
+    reducer_options.set_fail_on_validation_error(true);
+    spvtools::ValidatorOptions validator_options;
+
+    std::vector<uint32_t> binary_out;
+    Reducer::ReductionResultStatus status = reducer.Run(
+        binary_in, &binary_out, reducer_options, validator_options);
+    ASSERT_EQ(status, Reducer::ReductionResultStatus::kComplete);
+    binaries_out.push_back(std::move(binary_out));
+  }
+  ASSERT_EQ(binaries_out[0], binaries_out[1]);
+}
+
 // Computes an instruction count for each function in the module represented by
 // |binary|.
 std::unordered_map<uint32_t, uint32_t> GetFunctionInstructionCount(
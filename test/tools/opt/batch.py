@@ -0,0 +1,93 @@
+# Copyright (c) 2026 LunarG Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import placeholder
+import expect
+import re
+
+from spirv_test_framework import inside_spirv_testsuite
+
+
+def empty_main_assembly():
+  return """
+         OpCapability Shader
+         OpMemoryModel Logical GLSL450
+         OpEntryPoint Vertex %4 "main"
+         OpName %4 "main"
+    %2 = OpTypeVoid
+    %3 = OpTypeFunction %2
+    %4 = OpFunction %2 None %3
+    %5 = OpLabel
+         OpReturn
+         OpFunctionEnd"""
+
+
+def invalid_assembly():
+  # The function returns a value, but its type says it returns void.
+  return """
+         OpCapability Shader
+         OpMemoryModel Logical GLSL450
+         OpEntryPoint Vertex %4 "main"
+    %2 = OpTypeVoid
+    %3 = OpTypeFunction %2
+    %6 = OpTypeInt 32 1
+    %7 = OpConstant %6 1
+    %4 = OpFunction %2 None %3
+    %5 = OpLabel
+         OpReturnValue %7
+         OpFunctionEnd"""
+
+
+@inside_spirv_testsuite('SpirvOptBatch')
+class TestBatchManifest(expect.ReturnCodeIsZero, expect.NoOutputOnStderr,
+                        expect.StdoutMatch):
+  """Tests that every module of a manifest is optimized."""
+
+  manifest = placeholder.ManifestFile([
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm'),
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm'),
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm'),
+  ])
+  spirv_args = [
+      '--batch', '--jobs=2', '-O', manifest, '-o',
+      placeholder.TempFileName('batch_output')
+  ]
+  expected_stdout = re.compile(r'^(.*\.spv: ok\n){3}$')
+
+
+@inside_spirv_testsuite('SpirvOptBatch')
+class TestBatchManifestWithInvalidModule(expect.ReturnCodeIsNonZero,
+                                         expect.StdoutMatch):
+  """Tests that a failing module is reported without stopping the others."""
+
+  manifest = placeholder.ManifestFile([
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm'),
+      placeholder.FileSPIRVShader(invalid_assembly(), '.spvasm'),
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm'),
+  ])
+  spirv_args = [
+      '--batch', '-O', manifest, '-o',
+      placeholder.TempFileName('batch_output')
+  ]
+  expected_stdout = re.compile(r'^.*\.spv: ok\n.*\.spv: failed\n.*\.spv: ok\n$')
+
+
+@inside_spirv_testsuite('SpirvOptBatch')
+class TestBatchRequiresOutputDirectory(expect.ErrorMessage):
+  """Tests that --batch does not write to standard output."""
+
+  manifest = placeholder.ManifestFile([])
+  spirv_args = ['--batch', manifest, '-o', '-']
+  expected_error = ('error: --batch requires an input manifest or directory '
+                    'and an output directory\n')
@@ -159,6 +159,34 @@ class FileSPIRVShader(PlaceHolder):
     return self.filename
 
 
+class ManifestFile(PlaceHolder):
+  """Stands for a spirv-opt --batch manifest listing the given shaders."""
+
+  def __init__(self, shaders):
+    assert all(isinstance(shader, PlaceHolder) for shader in shaders)
+    self.shaders = shaders
+    self.filename = None
+
+  def instantiate_for_spirv_args(self, testcase):
+    """Instantiates the shaders and writes their names into a temporary file.
+
+        Returns:
+            The name of the temporary file.
+        """
+    names = [shader.instantiate_for_spirv_args(testcase)
+             for shader in self.shaders]
+    manifest, self.filename = tempfile.mkstemp(
+        dir=testcase.directory, suffix='.txt')
+    manifest_object = os.fdopen(manifest, 'w')
+    manifest_object.write(''.join('%s\n' % name for name in names))
+    manifest_object.close()
+    return self.filename
+
+  def instantiate_for_expectation(self, testcase):
+    assert self.filename is not None
+    return self.filename
+
+
 class StdinShader(PlaceHolder):
   """Stands for a shader whose source code is from stdin."""
 
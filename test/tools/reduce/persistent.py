@@ -0,0 +1,84 @@
+# Copyright (c) 2026 LunarG Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import placeholder
+import expect
+import sys
+
+from spirv_test_framework import inside_spirv_testsuite, SpirvTest
+
+PERSISTENT_TEST = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)),
+    'persistent_interestingness_test.py')
+
+
+def reducible_assembly():
+  return """
+         OpCapability Shader
+         OpMemoryModel Logical GLSL450
+         OpEntryPoint Vertex %4 "main"
+         OpName %4 "main"
+    %2 = OpTypeVoid
+    %3 = OpTypeFunction %2
+    %6 = OpTypeInt 32 1
+    %7 = OpTypePointer Function %6
+    %8 = OpConstant %6 1
+    %4 = OpFunction %2 None %3
+    %5 = OpLabel
+    %9 = OpVariable %7 Function
+         OpStore %9 %8
+         OpReturn
+         OpFunctionEnd"""
+
+
+class ReducedOutput(SpirvTest):
+  """Mixin class for checking that the reduced binary is a SPIR-V module
+    smaller than the input."""
+
+  def check_reduced_output(self, status):
+    input_filename = status.inputs[0].filename
+    output_filename = os.path.join(status.directory, 'reduced.spv')
+    if not os.path.isfile(output_filename):
+      return False, 'Cannot find file: ' + output_filename
+    with open(output_filename, 'rb') as output_file:
+      if output_file.read(4) != b'\x03\x02\x23\x07':
+        return False, 'The reduced binary has the wrong magic number'
+    if os.path.getsize(output_filename) >= os.path.getsize(input_filename):
+      return False, 'The binary was not reduced'
+    return True, ''
+
+
+@inside_spirv_testsuite('SpirvReducePersistentTest')
+class TestPersistentTestWithJobs(expect.ReturnCodeIsZero,
+                                 expect.NoOutputOnStderr, ReducedOutput):
+  """Tests that a pool of persistent test processes reduces a module."""
+
+  spirv_args = [
+      placeholder.FileSPIRVShader(reducible_assembly(), '.spvasm'), '-o',
+      placeholder.TempFileName('reduced.spv'), '--persistent-test',
+      '--jobs=2', '--', sys.executable, PERSISTENT_TEST
+  ]
+
+
+@inside_spirv_testsuite('SpirvReducePersistentTest')
+class TestPersistentTestExitingMidRun(expect.ErrorMessageSubstr):
+  """Tests that test processes exiting during the reduction are reported."""
+
+  spirv_args = [
+      placeholder.FileSPIRVShader(reducible_assembly(), '.spvasm'), '-o',
+      placeholder.TempFileName('reduced.spv'), '--persistent-test',
+      '--jobs=2', '--', sys.executable, PERSISTENT_TEST, '--exit-after=1'
+  ]
+  expected_error_substr = 'The persistent interestingness test exited'
@@ -0,0 +1,54 @@
+# Copyright (c) 2026 LunarG Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""An interestingness test for spirv-reduce --persistent-test.
+
+Every request holding a SPIR-V binary is answered as interesting.  With
+--exit-after=<n>, the test exits after answering <n> requests, as if it had
+crashed.
+"""
+
+import struct
+import sys
+
+SPIRV_MAGIC_NUMBER = 0x07230203
+
+
+def main():
+  exit_after = None
+  for arg in sys.argv[1:]:
+    if arg.startswith('--exit-after='):
+      exit_after = int(arg[len('--exit-after='):])
+
+  requests = sys.stdin.buffer
+  answers = sys.stdout.buffer
+  num_answered = 0
+  while exit_after is None or num_answered < exit_after:
+    header = requests.read(4)
+    if len(header) < 4:
+      # The reducer closed our input.
+      return 0
+    (num_bytes,) = struct.unpack('<I', header)
+    binary = requests.read(num_bytes)
+    if len(binary) != num_bytes:
+      return 1
+    is_spirv = (num_bytes >= 4 and
+                struct.unpack('<I', binary[0:4])[0] == SPIRV_MAGIC_NUMBER)
+    answers.write(b'\x01' if is_spirv else b'\x00')
+    answers.flush()
+    num_answered += 1
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
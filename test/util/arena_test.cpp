@@ -0,0 +1,95 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+bool IsAligned(void* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+}
+
+TEST(ArenaTest, AllocationsAreAlignedAndDistinct) {
+  Arena* arena = new Arena();
+  std::vector<void*> allocations;
+  for (size_t size = 1; size <= 200; ++size) {
+    void* ptr = Arena::Allocate(arena, size);
+    EXPECT_TRUE(IsAligned(ptr));
+    memset(ptr, 0xAB, size);
+    allocations.push_back(ptr);
+  }
+  EXPECT_EQ(200u, arena->live_allocations());
+
+  for (void* ptr : allocations) {
+    Arena::Deallocate(ptr);
+  }
+  EXPECT_EQ(0u, arena->live_allocations());
+  Arena::Release(arena);
+}
+
+TEST(ArenaTest, ReusesFreedMemoryOfTheSameSize) {
+  Arena* arena = new Arena();
+  void* first = Arena::Allocate(arena, 64);
+  Arena::Deallocate(first);
+  void* second = Arena::Allocate(arena, 64);
+  EXPECT_EQ(first, second);
+  Arena::Deallocate(second);
+  Arena::Release(arena);
+}
+
+TEST(ArenaTest, LargeAllocationsUseTheGlobalAllocator) {
+  Arena* arena = new Arena();
+  void* ptr = Arena::Allocate(arena, 4096);
+  EXPECT_TRUE(IsAligned(ptr));
+  EXPECT_EQ(0u, arena->live_allocations());
+  Arena::Deallocate(ptr);
+  Arena::Release(arena);
+}
+
+TEST(ArenaTest, AllocatesWithoutArena) {
+  void* ptr = Arena::Allocate(nullptr, 32);
+  EXPECT_TRUE(IsAligned(ptr));
+  Arena::Deallocate(ptr);
+  Arena::Deallocate(nullptr);
+  Arena::Release(nullptr);
+}
+
+TEST(ArenaTest, MemoryOutlivesRelease) {
+  Arena* arena = new Arena();
+  std::vector<uint32_t*> allocations;
+  for (uint32_t i = 0; i < 10000; ++i) {
+    uint32_t* ptr =
+        static_cast<uint32_t*>(Arena::Allocate(arena, sizeof(uint32_t)));
+    *ptr = i;
+    allocations.push_back(ptr);
+  }
+  Arena::Release(arena);
+
+  for (uint32_t i = 0; i < allocations.size(); ++i) {
+    EXPECT_EQ(i, *allocations[i]);
+    Arena::Deallocate(allocations[i]);
+  }
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for validating function bodies on several threads.
+
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "test/unit_spirv.h"
+#include "test/val/val_fixtures.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::Values;
+
+using ValidateConcurrency = spvtest::ValidateBase<uint32_t>;
+
+const char kHeader[] = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%int = OpTypeInt 32 0
+%float = OpTypeFloat 32
+%int_1 = OpConstant %int 1
+%float_1 = OpConstant %float 1
+)";
+
+// Returns a function named |name| whose body adds ones using |opcode| on the
+// given operand type.
+std::string MakeFunction(const std::string& name, const std::string& opcode,
+                         const std::string& type, const std::string& operand) {
+  std::ostringstream ss;
+  ss << "%" << name << " = OpFunction %void None %void_fn\n"
+     << "%" << name << "_entry = OpLabel\n"
+     << "%" << name << "_sum = " << opcode << " %" << type << " %" << operand
+     << " %" << operand << "\n"
+     << "OpReturn\n"
+     << "OpFunctionEnd\n";
+  return ss.str();
+}
+
+TEST_P(ValidateConcurrency, ManyValidFunctions) {
+  std::string spirv = kHeader;
+  for (int i = 0; i < 32; ++i) {
+    spirv += MakeFunction("f" + std::to_string(i), "OpIAdd", "int", "int_1");
+    spirv += MakeFunction("g" + std::to_string(i), "OpFAdd", "float",
+                          "float_1");
+  }
+
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), GetParam());
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_P(ValidateConcurrency, ReportsFirstErrorInModuleOrder) {
+  std::string spirv = kHeader;
+  for (int i = 0; i < 16; ++i) {
+    spirv += MakeFunction("f" + std::to_string(i), "OpIAdd", "int", "int_1");
+  }
+  // Two invalid functions; only the first one may be reported.
+  spirv += MakeFunction("bad_float", "OpFAdd", "int", "int_1");
+  for (int i = 0; i < 16; ++i) {
+    spirv += MakeFunction("g" + std::to_string(i), "OpIAdd", "int", "int_1");
+  }
+  spirv += MakeFunction("bad_int", "OpIAdd", "float", "float_1");
+
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), GetParam());
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected floating scalar or vector type as Result "
+                        "Type: FAdd"));
+}
+
+TEST_P(ValidateConcurrency, MatchesSerialDiagnostic) {
+  std::string spirv = kHeader;
+  for (int i = 0; i < 8; ++i) {
+    spirv += MakeFunction("f" + std::to_string(i), "OpIAdd", "int", "int_1");
+  }
+  spirv += MakeFunction("bad", "OpIAdd", "float", "float_1");
+  CompileSuccessfully(spirv);
+
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 1);
+  const spv_result_t serial_result = ValidateInstructions();
+  const std::string serial_diagnostic = getDiagnosticString();
+
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), GetParam());
+  EXPECT_EQ(serial_result, ValidateInstructions());
+  EXPECT_EQ(serial_diagnostic, getDiagnosticString());
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, ValidateConcurrency, Values(0, 1, 2, 8));
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
@@ -31,6 +31,7 @@ namespace val {
 namespace {
 
 using ::testing::Combine;
+using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::HasSubstr;
 using ::testing::Values;
@@ -64,10 +65,10 @@ TEST_F(ValidateDecorations, ValidateOpDecorateRegistration) {
   CompileSuccessfully(spirv);
   EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
   // Must have 2 decorations.
-  EXPECT_THAT(
-      vstate_->id_decorations(id),
-      Eq(std::set<Decoration>{Decoration(spv::Decoration::Location, {4}),
-                              Decoration(spv::Decoration::Centroid)}));
+  EXPECT_THAT(vstate_->id_decorations(id),
+              ElementsAreArray(std::set<Decoration>{
+                  Decoration(spv::Decoration::Location, {4}),
+                  Decoration(spv::Decoration::Centroid)}));
 }
 
 TEST_F(ValidateDecorations, ValidateOpMemberDecorateRegistration) {
@@ -90,17 +91,61 @@ TEST_F(ValidateDecorations, ValidateOpMemberDecorateRegistration) {
 
   // The array must have 1 decoration.
   const uint32_t arr_id = 1;
-  EXPECT_THAT(
-      vstate_->id_decorations(arr_id),
-      Eq(std::set<Decoration>{Decoration(spv::Decoration::ArrayStride, {4})}));
+  EXPECT_THAT(vstate_->id_decorations(arr_id),
+              ElementsAreArray(std::set<Decoration>{
+                  Decoration(spv::Decoration::ArrayStride, {4})}));
 
   // The struct must have 3 decorations.
   const uint32_t struct_id = 2;
-  EXPECT_THAT(
-      vstate_->id_decorations(struct_id),
-      Eq(std::set<Decoration>{Decoration(spv::Decoration::NonReadable, {}, 2),
-                              Decoration(spv::Decoration::Offset, {2}, 2),
-                              Decoration(spv::Decoration::BufferBlock)}));
+  EXPECT_THAT(vstate_->id_decorations(struct_id),
+              ElementsAreArray(std::set<Decoration>{
+                  Decoration(spv::Decoration::NonReadable, {}, 2),
+                  Decoration(spv::Decoration::Offset, {2}, 2),
+                  Decoration(spv::Decoration::BufferBlock)}));
+}
+
+TEST_F(ValidateDecorations, UndecoratedIdsHaveNoDecorations) {
+  std::string spirv = R"(
+    OpCapability Shader
+    OpCapability Linkage
+    OpMemoryModel Logical GLSL450
+    OpMemberDecorate %struct 1 Offset 4
+    OpMemberDecorate %struct 0 Offset 0
+    %float = OpTypeFloat 32
+    %struct = OpTypeStruct %float %float
+)";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+
+  const uint32_t struct_id = 1;
+  const uint32_t float_id = 2;
+  EXPECT_THAT(vstate_->decorated_ids(), ElementsAreArray({struct_id}));
+  EXPECT_TRUE(vstate_->id_decorations(float_id).empty());
+  EXPECT_TRUE(vstate_->id_decorations(0xffffffff).empty());
+
+  // Member decorations are grouped by member index.
+  auto member_decorations = vstate_->id_member_decorations(struct_id, 1);
+  ASSERT_EQ(1, member_decorations.end - member_decorations.begin);
+  EXPECT_EQ(Decoration(spv::Decoration::Offset, {4}, 1),
+            *member_decorations.begin);
+  member_decorations = vstate_->id_member_decorations(struct_id, 2);
+  EXPECT_EQ(member_decorations.begin, member_decorations.end);
+}
+
+TEST_F(ValidateDecorations, DecorateIdPastBoundIsUndefined) {
+  std::string spirv = R"(
+    OpCapability Shader
+    OpCapability Linkage
+    OpMemoryModel Logical GLSL450
+    OpDecorate %var Flat
+    %float = OpTypeFloat 32
+)";
+  CompileSuccessfully(spirv);
+  // Retarget the OpDecorate, which starts at word 12 after the header, the
+  // two OpCapability and the OpMemoryModel instructions, to the largest id.
+  OverwriteAssembledBinary(13, 0xffffffff);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("4294967295"));
 }
 
 TEST_F(ValidateDecorations, ValidateOpMemberDecorateOutOfBound) {
@@ -161,10 +206,14 @@ TEST_F(ValidateDecorations, ValidateGroupDecorateRegistration) {
 
   // Decoration group is applied to id 1, 2, 3, and 4. Note that id 1 (which is
   // the decoration group id) also has all the decorations.
-  EXPECT_THAT(vstate_->id_decorations(1), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(2), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(3), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(4), Eq(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(1),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(2),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(3),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(4),
+              ElementsAreArray(expected_decorations));
 }
 
 TEST_F(ValidateDecorations, ValidateGroupMemberDecorateRegistration) {
@@ -188,9 +237,12 @@ TEST_F(ValidateDecorations, ValidateGroupMemberDecorateRegistration) {
       std::set<Decoration>{Decoration(spv::Decoration::Offset, {3}, 3)};
 
   // Decoration group is applied to id 2, 3, and 4.
-  EXPECT_THAT(vstate_->id_decorations(2), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(3), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(4), Eq(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(2),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(3),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(4),
+              ElementsAreArray(expected_decorations));
 }
 
 TEST_F(ValidateDecorations, LinkageImportUsedForInitializedVariableBad) {
@@ -2739,6 +2791,51 @@ TEST_F(ValidateDecorations, BlockArrayBaseAlignmentWithVulkan1_1StillBad) {
           "member 1 at offset 8 is not aligned to 16"));
 }
 
+TEST_F(ValidateDecorations, SharedStructCheckedForEachLayoutRules) {
+  // %Inner satisfies the storage buffer rules first, but its array stride is
+  // still too small for the uniform buffer rules.
+  std::string spirv = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Vertex %main "main"
+               OpSource GLSL 450
+               OpDecorate %_arr_float_uint_2 ArrayStride 4
+               OpMemberDecorate %Inner 0 Offset 0
+               OpMemberDecorate %S 0 Offset 0
+               OpDecorate %S Block
+               OpDecorate %ssbo DescriptorSet 0
+               OpDecorate %ssbo Binding 0
+               OpDecorate %ubo DescriptorSet 0
+               OpDecorate %ubo Binding 1
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+       %uint = OpTypeInt 32 0
+     %uint_2 = OpConstant %uint 2
+%_arr_float_uint_2 = OpTypeArray %float %uint_2
+      %Inner = OpTypeStruct %_arr_float_uint_2
+          %S = OpTypeStruct %Inner
+%_ptr_StorageBuffer_S = OpTypePointer StorageBuffer %S
+%_ptr_Uniform_S = OpTypePointer Uniform %S
+       %ssbo = OpVariable %_ptr_StorageBuffer_S StorageBuffer
+        %ubo = OpVariable %_ptr_Uniform_S Uniform
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+               OpReturn
+               OpFunctionEnd
+  )";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_1);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID,
+            ValidateAndRetrieveValidationState(SPV_ENV_VULKAN_1_1));
+  EXPECT_THAT(
+      getDiagnosticString(),
+      HasSubstr("decorated as Block for variable in Uniform storage class "
+                "must follow relaxed uniform buffer layout rules: member 0 "
+                "contains an array with stride 4 not satisfying alignment to "
+                "16"));
+}
+
 TEST_F(ValidateDecorations,
        BlockArrayBaseAlignmentWithBlockStandardLayoutGood) {
   // Same as previous test, but with VK_KHR_uniform_buffer_standard_layout
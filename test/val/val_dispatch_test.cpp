@@ -0,0 +1,555 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests that the instructions reach the checks of every validator pass
+// registered with an opcode list.  Each test has an invalid instruction that
+// only the pass under test reports.
+
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "test/unit_spirv.h"
+#include "test/val/val_fixtures.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using ::testing::HasSubstr;
+
+using ValidateDispatch = spvtest::ValidateBase<bool>;
+
+std::string GenerateShaderCode(
+    const std::string& body,
+    const std::string& capabilities_and_extensions = "",
+    const std::string& annotations = "",
+    const std::string& declarations = "") {
+  std::ostringstream ss;
+  ss << R"(
+OpCapability Shader
+)" << capabilities_and_extensions
+     << R"(
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+)" << annotations
+     << R"(
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%bool = OpTypeBool
+%int = OpTypeInt 32 1
+%uint = OpTypeInt 32 0
+%float = OpTypeFloat 32
+%v2float = OpTypeVector %float 2
+%true = OpConstantTrue %bool
+%false = OpConstantFalse %bool
+%int_1 = OpConstant %int 1
+%uint_0 = OpConstant %uint 0
+%uint_1 = OpConstant %uint 1
+%float_1 = OpConstant %float 1
+%v2float_1 = OpConstantComposite %v2float %float_1 %float_1
+%_ptr_Function_float = OpTypePointer Function %float
+)" << declarations
+     << R"(
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+%var = OpVariable %_ptr_Function_float Function
+)" << body
+     << R"(
+OpReturn
+OpFunctionEnd
+)";
+  return ss.str();
+}
+
+TEST_F(ValidateDispatch, Misc) {
+  CompileSuccessfully(GenerateShaderCode("", "", "", "%u = OpUndef %void"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Cannot create undefined values with void type"));
+}
+
+TEST_F(ValidateDispatch, Debug) {
+  CompileSuccessfully(
+      GenerateShaderCode("", "", "OpMemberName %float 0 \"foo\""));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("is not a struct type."));
+}
+
+TEST_F(ValidateDispatch, Annotation) {
+  CompileSuccessfully(GenerateShaderCode(
+      "", "", "OpMemberDecorate %struct 1 RelaxedPrecision",
+      "%struct = OpTypeStruct %float"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Index 1 provided in OpMemberDecorate for struct"));
+}
+
+TEST_F(ValidateDispatch, ModeSetting) {
+  CompileSuccessfully(GenerateShaderCode("", "OpCapability Geometry",
+                                         "OpExecutionMode %main InputPoints"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Execution mode can only be used with the Geometry "
+                        "execution model."));
+}
+
+TEST_F(ValidateDispatch, MemoryLoad) {
+  CompileSuccessfully(GenerateShaderCode("%x = OpLoad %int %var"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("does not match Pointer <id>"));
+}
+
+// OpVariable is also listed by the mesh shading checks.
+TEST_F(ValidateDispatch, MemoryVariable) {
+  CompileSuccessfully(GenerateShaderCode(
+      "", "", "", "%bad = OpVariable %_ptr_Function_float Function"));
+  EXPECT_EQ(SPV_ERROR_INVALID_LAYOUT, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Variables can not have a function[7] storage class "
+                        "outside of a function"));
+}
+
+TEST_F(ValidateDispatch, Function) {
+  CompileSuccessfully(
+      GenerateShaderCode("%x = OpFunctionCall %void %float_1"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("is not a function."));
+}
+
+TEST_F(ValidateDispatch, Image) {
+  const std::string declarations = R"(
+%type_image = OpTypeImage %float 2D 0 0 0 1 Unknown
+%_ptr_image = OpTypePointer UniformConstant %type_image
+%image = OpVariable %_ptr_image UniformConstant
+%type_sampler = OpTypeSampler
+%_ptr_sampler = OpTypePointer UniformConstant %type_sampler
+%sampler = OpVariable %_ptr_sampler UniformConstant
+%type_sampled_image = OpTypeSampledImage %type_image
+)";
+  const std::string body = R"(
+%img = OpLoad %type_image %image
+%smp = OpLoad %type_sampler %sampler
+%simg = OpSampledImage %type_sampled_image %img %smp
+%res = OpImageSampleImplicitLod %float %simg %v2float_1
+)";
+
+  CompileSuccessfully(GenerateShaderCode(body, "", "", declarations));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected Result Type to be int or float vector type"));
+}
+
+TEST_F(ValidateDispatch, Conversion) {
+  CompileSuccessfully(GenerateShaderCode("%x = OpConvertFToS %float %float_1"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected int scalar or vector type as Result Type: "
+                        "ConvertFToS"));
+}
+
+TEST_F(ValidateDispatch, Composites) {
+  CompileSuccessfully(
+      GenerateShaderCode("%x = OpCompositeExtract %float %v2float_1 2"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Vector access is out of bounds, vector size is 2, "
+                        "but access index is 2"));
+}
+
+// OpSpecConstantOp is listed by several passes, each checking the opcodes it
+// knows.
+TEST_F(ValidateDispatch, CompositesSpecConstantOp) {
+  CompileSuccessfully(GenerateShaderCode(
+      "", "", "",
+      "%s = OpSpecConstantOp %float CompositeExtract %v2float_1 2"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Vector access is out of bounds"));
+}
+
+TEST_F(ValidateDispatch, Arithmetics) {
+  CompileSuccessfully(GenerateShaderCode("%x = OpFAdd %int %float_1 %float_1"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected floating scalar or vector type as Result "
+                        "Type: FAdd"));
+}
+
+TEST_F(ValidateDispatch, Bitwise) {
+  CompileSuccessfully(
+      GenerateShaderCode("%x = OpBitwiseAnd %float %int_1 %int_1"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected int scalar or vector type as Result Type: "
+                        "BitwiseAnd"));
+}
+
+TEST_F(ValidateDispatch, Logicals) {
+  CompileSuccessfully(GenerateShaderCode("%x = OpLogicalNot %int %true"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected bool scalar or vector type as Result Type: "
+                        "LogicalNot"));
+}
+
+TEST_F(ValidateDispatch, LogicalsSpecConstantOp) {
+  CompileSuccessfully(GenerateShaderCode(
+      "", "", "", "%s = OpSpecConstantOp %int LogicalNot %true"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected bool scalar or vector type as Result Type: "
+                        "SpecConstantOp"));
+}
+
+TEST_F(ValidateDispatch, ControlFlow) {
+  CompileSuccessfully(GenerateShaderCode(R"(
+OpReturnValue %float_1
+%next = OpLabel
+)"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("s type does not match OpFunction's return type."));
+}
+
+TEST_F(ValidateDispatch, Derivatives) {
+  CompileSuccessfully(GenerateShaderCode("%x = OpDPdx %int %float_1"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected Result Type to be float scalar or vector "
+                        "type: DPdx"));
+}
+
+TEST_F(ValidateDispatch, Atomics) {
+  CompileSuccessfully(GenerateShaderCode(
+      "%x = OpAtomicIAdd %float %var %uint_1 %uint_0 %float_1"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(
+      getDiagnosticString(),
+      HasSubstr("AtomicIAdd: expected Result Type to be integer scalar type"));
+}
+
+TEST_F(ValidateDispatch, Primitives) {
+  CompileSuccessfully(GenerateShaderCode("OpEmitStreamVertex %float_1",
+                                         "OpCapability GeometryStreams"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("EmitStreamVertex: expected Stream to be int scalar"));
+}
+
+TEST_F(ValidateDispatch, Barriers) {
+  CompileSuccessfully(
+      GenerateShaderCode("OpControlBarrier %float_1 %uint_1 %uint_0"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("ControlBarrier: expected scope to be a 32-bit int"));
+}
+
+TEST_F(ValidateDispatch, DotProduct) {
+  const std::string capabilities = R"(
+OpCapability DotProductKHR
+OpCapability DotProductInputAll
+OpExtension "SPV_KHR_integer_dot_product"
+)";
+
+  CompileSuccessfully(
+      GenerateShaderCode("%x = OpSDot %float %int_1 %int_1", capabilities));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Result must be an int scalar type"));
+}
+
+TEST_F(ValidateDispatch, Group) {
+  CompileSuccessfully(GenerateShaderCode("%x = OpGroupAny %int %uint_1 %true",
+                                         "OpCapability Groups"));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Result must be a boolean scalar type"));
+}
+
+TEST_F(ValidateDispatch, Pipe) {
+  const std::string spirv = R"(
+OpCapability Kernel
+OpCapability Addresses
+OpCapability Linkage
+OpCapability Pipes
+OpCapability GenericPointer
+OpCapability Int64
+OpMemoryModel Physical64 OpenCL
+OpEntryPoint Kernel %main "main"
+%uint = OpTypeInt 32 0
+%uint64 = OpTypeInt 64 0
+%uint_4 = OpConstant %uint 4
+%_ptr_Generic_uint = OpTypePointer Generic %uint
+%_ptr_Function_uint = OpTypePointer Function %uint
+%void = OpTypeVoid
+%read_pipe_type = OpTypePipe ReadOnly
+%fn = OpTypeFunction %void %read_pipe_type
+%main = OpFunction %void None %fn
+%read_pipe = OpFunctionParameter %read_pipe_type
+%label = OpLabel
+%func_var = OpVariable %_ptr_Function_uint Function
+%generic_ptr = OpPtrCastToGeneric %_ptr_Generic_uint %func_var
+%x = OpReadPipe %uint64 %read_pipe %generic_ptr %uint_4 %uint_4
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_UNIVERSAL_1_1);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA,
+            ValidateInstructions(SPV_ENV_UNIVERSAL_1_1));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Result Type must be a 32-bit int scalar"));
+}
+
+TEST_F(ValidateDispatch, RayQuery) {
+  const std::string capabilities = R"(
+OpCapability RayQueryKHR
+OpExtension "SPV_KHR_ray_query"
+)";
+
+  CompileSuccessfully(
+      GenerateShaderCode("OpRayQueryTerminateKHR %var", capabilities));
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Ray Query must be a pointer to OpTypeRayQueryKHR"));
+}
+
+TEST_F(ValidateDispatch, RayTracing) {
+  const std::string spirv = R"(
+OpCapability RayTracingKHR
+OpExtension "SPV_KHR_ray_tracing"
+OpMemoryModel Logical GLSL450
+OpEntryPoint RayGenerationKHR %main "main"
+OpDecorate %top_level_as DescriptorSet 0
+OpDecorate %top_level_as Binding 0
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%type_as = OpTypeAccelerationStructureKHR
+%as_uc_ptr = OpTypePointer UniformConstant %type_as
+%top_level_as = OpVariable %as_uc_ptr UniformConstant
+%uint = OpTypeInt 32 0
+%uint_1 = OpConstant %uint 1
+%float = OpTypeFloat 32
+%f32vec3 = OpTypeVector %float 3
+%float_0 = OpConstant %float 0
+%v3composite = OpConstantComposite %f32vec3 %float_0 %float_0 %float_0
+%int = OpTypeInt 32 1
+%payload_ptr = OpTypePointer RayPayloadKHR %int
+%payload = OpVariable %payload_ptr RayPayloadKHR
+%main = OpFunction %void None %func
+%label = OpLabel
+%as = OpLoad %type_as %top_level_as
+OpTraceRayKHR %as %float_0 %uint_1 %uint_1 %uint_1 %uint_1 %v3composite %float_0 %v3composite %float_0 %payload
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Ray Flags must be a 32-bit int scalar"));
+}
+
+TEST_F(ValidateDispatch, RayReorderNV) {
+  const std::string spirv = R"(
+OpCapability RayTracingKHR
+OpCapability ShaderInvocationReorderNV
+OpExtension "SPV_KHR_ray_tracing"
+OpExtension "SPV_NV_shader_invocation_reorder"
+OpMemoryModel Logical GLSL450
+OpEntryPoint RayGenerationNV %main "main"
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%uint = OpTypeInt 32 0
+%uint_4 = OpConstant %uint 4
+%float = OpTypeFloat 32
+%float_4 = OpConstant %float 4
+%main = OpFunction %void None %func
+%label = OpLabel
+OpReorderThreadWithHintNV %float_4 %uint_4
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_2);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_2));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Hint must be a 32-bit int scalar"));
+}
+
+TEST_F(ValidateDispatch, RayReorderEXT) {
+  const std::string spirv = R"(
+OpCapability RayTracingKHR
+OpCapability ShaderInvocationReorderEXT
+OpExtension "SPV_KHR_ray_tracing"
+OpExtension "SPV_EXT_shader_invocation_reorder"
+OpMemoryModel Logical GLSL450
+OpEntryPoint RayGenerationNV %main "main"
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%uint = OpTypeInt 32 0
+%uint_4 = OpConstant %uint 4
+%float = OpTypeFloat 32
+%float_4 = OpConstant %float 4
+%main = OpFunction %void None %func
+%label = OpLabel
+OpReorderThreadWithHintEXT %float_4 %uint_4
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_2);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_2));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Hint must be a 32-bit int scalar"));
+}
+
+// OpVariable is also listed by the memory checks.
+TEST_F(ValidateDispatch, MeshShadingVariable) {
+  const std::string spirv = R"(
+OpCapability MeshShadingEXT
+OpExtension "SPV_EXT_mesh_shader"
+OpMemoryModel Logical GLSL450
+OpEntryPoint MeshEXT %main "main" %x
+OpExecutionModeId %main LocalSizeId %uint_1 %uint_1 %uint_1
+OpExecutionMode %main OutputVertices 3
+OpExecutionMode %main OutputPrimitivesEXT 1
+OpExecutionMode %main OutputTrianglesEXT
+OpDecorate %x Location 0
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%uint = OpTypeInt 32 0
+%uint_1 = OpConstant %uint 1
+%uint_3 = OpConstant %uint 3
+%o_ptr = OpTypePointer Output %uint
+%x = OpVariable %o_ptr Output
+%main = OpFunction %void None %func
+%label = OpLabel
+OpSetMeshOutputsEXT %uint_3 %uint_1
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_3));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("In the MeshEXT Execution Mode, all Output Variables "
+                        "must contain an Array."));
+}
+
+TEST_F(ValidateDispatch, TensorLayout) {
+  const std::string capabilities = R"(
+OpCapability TensorAddressingNV
+OpExtension "SPV_NV_tensor_addressing"
+)";
+
+  CompileSuccessfully(
+      GenerateShaderCode("%tl = OpCreateTensorLayoutNV %uint", capabilities),
+      SPV_ENV_UNIVERSAL_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_UNIVERSAL_1_3));
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("is not a tensor layout type."));
+}
+
+TEST_F(ValidateDispatch, Tensor) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability VulkanMemoryModel
+OpCapability TensorsARM
+OpExtension "SPV_ARM_tensors"
+OpMemoryModel Logical Vulkan
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+OpDecorate %tensor_var DescriptorSet 0
+OpDecorate %tensor_var Binding 0
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%uint = OpTypeInt 32 0
+%uint_vec4 = OpTypeVector %uint 4
+%uint_1 = OpConstant %uint 1
+%uint_4 = OpConstant %uint 4
+%uint_arr4 = OpTypeArray %uint %uint_4
+%uint_arr4_1_1_1_1 = OpConstantComposite %uint_arr4 %uint_1 %uint_1 %uint_1 %uint_1
+%tensor_uint_4 = OpTypeTensorARM %uint %uint_4
+%tensor_uint_4_ptr = OpTypePointer UniformConstant %tensor_uint_4
+%tensor_var = OpVariable %tensor_uint_4_ptr UniformConstant
+%fn = OpFunction %void None %func
+%fn_label = OpLabel
+%tensor = OpLoad %tensor_uint_4 %tensor_var
+%val = OpTensorReadARM %uint_vec4 %tensor %uint_arr4_1_1_1_1
+OpReturn
+OpFunctionEnd
+%main = OpFunction %void None %func
+%label = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_3));
+  EXPECT_THAT(
+      getDiagnosticString(),
+      HasSubstr(
+          "Expected Result Type to be a scalar type or array of scalar type"));
+}
+
+TEST_F(ValidateDispatch, Graph) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability VulkanMemoryModel
+OpCapability GraphARM
+OpCapability TensorsARM
+OpExtension "SPV_ARM_graph"
+OpExtension "SPV_ARM_tensors"
+OpMemoryModel Logical Vulkan
+%uint = OpTypeInt 32 0
+%graph_type = OpTypeGraphARM 0
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_3));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("A graph type must have at least one output"));
+}
+
+TEST_F(ValidateDispatch, InvalidType) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability BFloat16TypeKHR
+OpExtension "SPV_KHR_bfloat16"
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%bfloat16 = OpTypeFloat 16 BFloat16KHR
+%bf16_1 = OpConstant %bfloat16 1
+%main = OpFunction %void None %func
+%label = OpLabel
+%x = OpFMul %bfloat16 %bf16_1 %bf16_1
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA,
+            ValidateInstructions(SPV_ENV_UNIVERSAL_1_6));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("FMul doesn't support BFloat16 type."));
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
@@ -0,0 +1,224 @@
+// Copyright (c) 2026 LunarG Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for the validator levels.
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "test/unit_spirv.h"
+#include "test/val/val_fixtures.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using ::testing::HasSubstr;
+
+using ValidateLevel = spvtest::ValidateBase<bool>;
+
+TEST_F(ValidateLevel, FastSkipsBlockLayout) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Vertex %main "main"
+OpDecorate %_arr_float_uint_2 ArrayStride 16
+OpDecorate %u DescriptorSet 0
+OpDecorate %u Binding 0
+OpMemberDecorate %S 0 Offset 0
+OpMemberDecorate %S 1 Offset 8
+OpDecorate %S Block
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%v2float = OpTypeVector %float 2
+%uint = OpTypeInt 32 0
+%uint_2 = OpConstant %uint 2
+%_arr_float_uint_2 = OpTypeArray %float %uint_2
+%S = OpTypeStruct %v2float %_arr_float_uint_2
+%_ptr_Uniform_S = OpTypePointer Uniform %S
+%u = OpVariable %_ptr_Uniform_S Uniform
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_1);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_VULKAN_1_1));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("member 1 at offset 8 is not aligned to 16"));
+
+  spvValidatorOptionsSetLevel(getValidatorOptions(), SPV_VALIDATOR_LEVEL_FAST);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions(SPV_ENV_VULKAN_1_1));
+}
+
+TEST_F(ValidateLevel, FastSkipsBuiltIns) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+OpDecorate %workgroup_size BuiltIn WorkgroupSize
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%v3float = OpTypeVector %float 3
+%float_1 = OpConstant %float 1
+%workgroup_size = OpConstantComposite %v3float %float_1 %float_1 %float_1
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_0);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_0));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("BuiltIn WorkgroupSize variable needs to be a "
+                        "3-component 32-bit int vector"));
+
+  spvValidatorOptionsSetLevel(getValidatorOptions(), SPV_VALIDATOR_LEVEL_FAST);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions(SPV_ENV_VULKAN_1_0));
+}
+
+TEST_F(ValidateLevel, FastSkipsImage) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+OpDecorate %image DescriptorSet 0
+OpDecorate %image Binding 0
+OpDecorate %sampler DescriptorSet 0
+OpDecorate %sampler Binding 1
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%v2float = OpTypeVector %float 2
+%float_1 = OpConstant %float 1
+%v2float_1 = OpConstantComposite %v2float %float_1 %float_1
+%type_image = OpTypeImage %float 2D 0 0 0 1 Unknown
+%_ptr_image = OpTypePointer UniformConstant %type_image
+%image = OpVariable %_ptr_image UniformConstant
+%type_sampler = OpTypeSampler
+%_ptr_sampler = OpTypePointer UniformConstant %type_sampler
+%sampler = OpVariable %_ptr_sampler UniformConstant
+%type_sampled_image = OpTypeSampledImage %type_image
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+%img = OpLoad %type_image %image
+%smp = OpLoad %type_sampler %sampler
+%simg = OpSampledImage %type_sampled_image %img %smp
+%res = OpImageSampleImplicitLod %float %simg %v2float_1
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected Result Type to be int or float vector type"));
+
+  spvValidatorOptionsSetLevel(getValidatorOptions(), SPV_VALIDATOR_LEVEL_FAST);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateLevel, FastSkipsRayTracing) {
+  const std::string spirv = R"(
+OpCapability RayTracingKHR
+OpExtension "SPV_KHR_ray_tracing"
+OpMemoryModel Logical GLSL450
+OpEntryPoint RayGenerationKHR %main "main"
+OpDecorate %top_level_as DescriptorSet 0
+OpDecorate %top_level_as Binding 0
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%type_as = OpTypeAccelerationStructureKHR
+%as_uc_ptr = OpTypePointer UniformConstant %type_as
+%top_level_as = OpVariable %as_uc_ptr UniformConstant
+%uint = OpTypeInt 32 0
+%uint_1 = OpConstant %uint 1
+%float = OpTypeFloat 32
+%v3float = OpTypeVector %float 3
+%float_0 = OpConstant %float 0
+%v3float_0 = OpConstantComposite %v3float %float_0 %float_0 %float_0
+%int = OpTypeInt 32 1
+%payload_ptr = OpTypePointer RayPayloadKHR %int
+%payload = OpVariable %payload_ptr RayPayloadKHR
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+%as = OpLoad %type_as %top_level_as
+OpTraceRayKHR %as %float_0 %uint_1 %uint_1 %uint_1 %uint_1 %v3float_0 %float_0 %v3float_0 %float_0 %payload
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Ray Flags must be a 32-bit int scalar"));
+
+  spvValidatorOptionsSetLevel(getValidatorOptions(), SPV_VALIDATOR_LEVEL_FAST);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateLevel, FastStillChecksIds) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%int = OpTypeInt 32 0
+%int_1 = OpConstant %int 1
+%func = OpFunction %void None %void_fn
+%entry = OpLabel
+%sum = OpIAdd %int %int_1 %undefined
+OpReturn
+OpFunctionEnd
+)";
+
+  spvValidatorOptionsSetLevel(getValidatorOptions(), SPV_VALIDATOR_LEVEL_FAST);
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("has not been defined"));
+}
+
+TEST_F(ValidateLevel, FastStillChecksControlFlow) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%func = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+%dead = OpLabel
+OpBranch %entry
+OpFunctionEnd
+)";
+
+  spvValidatorOptionsSetLevel(getValidatorOptions(), SPV_VALIDATOR_LEVEL_FAST);
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_CFG, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("[%entry]' of function '3[%func]' is targeted by "
+                        "block '5[%dead]'"));
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
@@ -167,7 +167,7 @@ int main(int, const char** argv) {
   }
 
   // Read the input binary.
-  std::vector<uint32_t> contents;
+  BinaryFileContents contents;
   if (!ReadBinaryFile(inFile.c_str(), &contents)) return 1;
 
   // If printing to standard output, then spvBinaryToText should
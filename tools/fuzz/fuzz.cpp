@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <cstring>
@@ -20,6 +22,7 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include "source/fuzz/force_render_red.h"
 #include "source/fuzz/fuzzer.h"
@@ -85,6 +88,8 @@ facts about the SPIR-V binary are read from this file.
 The transformed SPIR-V binary is written to <output.spv>.  Human-readable and
 binary representations of the transformations that were applied are written to
 <output.transformations_json> and <output.transformations>, respectively.
+When fuzzing with --seeds=N for N > 1, the files for seed S are instead
+<output_S.spv>, <output_S.transformations_json> and <output_S.transformations>.
 
 When passing --shrink=<input.transformations> an <interestingness_test>
 must also be provided; this is the path to a script that returns 0 if and only
@@ -137,6 +142,11 @@ Options (in lexicographical order):
                  that was used previously.
                - simple: each time a fuzzer pass is requested, one is provided
                  at random from the set of enabled passes.
+  --jobs=
+               Number of seeds to fuzz concurrently when --seeds is used.  Each
+               run has its own copy of the module and its own random number
+               generator; the donor modules are parsed once and shared.  The
+               default is 1.
   --fuzzing-target=
               This option will adjust probabilities of applying certain
               transformations s.t. the module always remains valid according
@@ -161,6 +171,12 @@ Options (in lexicographical order):
   --seed=
                Unsigned 32-bit integer seed to control random number
                generation.
+  --seeds=
+               Number of consecutive seeds to fuzz, starting from the one given
+               by --seed, or from a random seed.  The results for each seed
+               are written out as soon as its run finishes, and are the same
+               as those of a run with just that seed.  The default is 1.
+               Ignored unless fuzzing.
   --shrink=
                File from which to read a sequence of transformations to shrink
                (instead of fuzzing)
@@ -207,7 +223,8 @@ FuzzStatus ParseFlags(
     std::string* shrink_transformations_file,
     std::string* shrink_temp_file_prefix,
     spvtools::fuzz::RepeatedPassStrategy* repeated_pass_strategy,
-    FuzzingTarget* fuzzing_target, spvtools::FuzzerOptions* fuzzer_options,
+    FuzzingTarget* fuzzing_target, uint32_t* num_seeds, uint32_t* num_jobs,
+    spvtools::FuzzerOptions* fuzzer_options,
     spvtools::ValidatorOptions* validator_options) {
   uint32_t positional_arg_index = 0;
   bool only_positional_arguments_remain = false;
@@ -268,6 +285,18 @@ FuzzStatus ParseFlags(
           spvtools::Error(FuzzDiagnostic, nullptr, {}, ss.str().c_str());
           return {FuzzActions::STOP, 1};
         }
+      } else if (0 == strncmp(cur_arg, "--jobs=", sizeof("--jobs=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        char* end = nullptr;
+        errno = 0;
+        const auto jobs =
+            static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
+        if (end == split_flag.second.c_str() || errno != 0 || jobs == 0) {
+          spvtools::Error(FuzzDiagnostic, nullptr, {},
+                          "The --jobs argument must be a positive integer.");
+          return {FuzzActions::STOP, 1};
+        }
+        *num_jobs = jobs;
       } else if (0 == strncmp(cur_arg, "--fuzzing-target=",
                               sizeof("--fuzzing-target=") - 1)) {
         std::string target = spvtools::utils::SplitFlagArgs(cur_arg).second;
@@ -305,6 +334,18 @@ FuzzStatus ParseFlags(
             static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
         assert(end != split_flag.second.c_str() && errno == 0);
         fuzzer_options->set_random_seed(seed);
+      } else if (0 == strncmp(cur_arg, "--seeds=", sizeof("--seeds=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        char* end = nullptr;
+        errno = 0;
+        const auto seeds =
+            static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
+        if (end == split_flag.second.c_str() || errno != 0 || seeds == 0) {
+          spvtools::Error(FuzzDiagnostic, nullptr, {},
+                          "The --seeds argument must be a positive integer.");
+          return {FuzzActions::STOP, 1};
+        }
+        *num_seeds = seeds;
       } else if (0 == strncmp(cur_arg, "--shrinker-step-limit=",
                               sizeof("--shrinker-step-limit=") - 1)) {
         const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
@@ -559,40 +600,52 @@ bool Shrink(const spv_target_env& target_env,
              shrink_result.status;
 }
 
+// Reads the donor files listed, one per line, in the file |donors|.  Each
+// donor is parsed once, and every fuzzer run gets its own in-memory copy of it
+// when it needs one.
+bool ReadDonors(
+    const spv_target_env& target_env, const std::string& donors,
+    std::vector<spvtools::fuzz::fuzzerutil::ModuleSupplier>* donor_suppliers) {
+  std::ifstream donors_file(donors);
+  if (!donors_file) {
+    spvtools::Error(FuzzDiagnostic, nullptr, {}, "Error opening donors file");
+    return false;
+  }
+  std::string donor_filename;
+  while (std::getline(donors_file, donor_filename)) {
+    std::vector<uint32_t> donor_binary;
+    if (!ReadBinaryFile(donor_filename.c_str(), &donor_binary)) {
+      return false;
+    }
+    std::shared_ptr<const spvtools::opt::IRContext> donor =
+        spvtools::BuildModule(target_env, spvtools::utils::CLIMessageConsumer,
+                              donor_binary.data(), donor_binary.size());
+    if (!donor) {
+      spvtools::Error(FuzzDiagnostic, nullptr, {},
+                      ("Error parsing donor file '" + donor_filename + "'")
+                          .c_str());
+      return false;
+    }
+    donor_suppliers->push_back(
+        spvtools::fuzz::fuzzerutil::MakeModuleCopySupplier(std::move(donor)));
+  }
+  return true;
+}
+
 bool Fuzz(const spv_target_env& target_env,
           spv_const_fuzzer_options fuzzer_options,
           spv_validator_options validator_options,
           const std::vector<uint32_t>& binary_in,
           const spvtools::fuzz::protobufs::FactSequence& initial_facts,
-          const std::string& donors,
+          const std::vector<spvtools::fuzz::fuzzerutil::ModuleSupplier>&
+              donor_suppliers,
           spvtools::fuzz::RepeatedPassStrategy repeated_pass_strategy,
-          FuzzingTarget fuzzing_target, std::vector<uint32_t>* binary_out,
+          FuzzingTarget fuzzing_target, uint32_t seed,
+          std::vector<uint32_t>* binary_out,
           spvtools::fuzz::protobufs::TransformationSequence*
               transformations_applied) {
   auto message_consumer = spvtools::utils::CLIMessageConsumer;
 
-  std::vector<spvtools::fuzz::fuzzerutil::ModuleSupplier> donor_suppliers;
-
-  std::ifstream donors_file(donors);
-  if (!donors_file) {
-    spvtools::Error(FuzzDiagnostic, nullptr, {}, "Error opening donors file");
-    return false;
-  }
-  std::string donor_filename;
-  while (std::getline(donors_file, donor_filename)) {
-    donor_suppliers.emplace_back(
-        [donor_filename, message_consumer,
-         target_env]() -> std::unique_ptr<spvtools::opt::IRContext> {
-          std::vector<uint32_t> donor_binary;
-          if (!ReadBinaryFile(donor_filename.c_str(), &donor_binary)) {
-            return nullptr;
-          }
-          return spvtools::BuildModule(target_env, message_consumer,
-                                       donor_binary.data(),
-                                       donor_binary.size());
-        });
-  }
-
   std::unique_ptr<spvtools::opt::IRContext> ir_context;
   if (!spvtools::fuzz::fuzzerutil::BuildIRContext(target_env, message_consumer,
                                                   binary_in, validator_options,
@@ -605,10 +658,7 @@ bool Fuzz(const spv_target_env& target_env,
           fuzzing_target == FuzzingTarget::kSpirv) &&
          "Not all fuzzing targets are handled");
   auto fuzzer_context = spvtools::MakeUnique<spvtools::fuzz::FuzzerContext>(
-      spvtools::MakeUnique<spvtools::fuzz::PseudoRandomGenerator>(
-          fuzzer_options->has_random_seed
-              ? fuzzer_options->random_seed
-              : static_cast<uint32_t>(std::random_device()())),
+      spvtools::MakeUnique<spvtools::fuzz::PseudoRandomGenerator>(seed),
       spvtools::fuzz::FuzzerContext::GetMinFreshId(ir_context.get()),
       fuzzing_target == FuzzingTarget::kWgsl);
 
@@ -636,6 +686,108 @@ bool Fuzz(const spv_target_env& target_env,
   return true;
 }
 
+// Writes |binary| to |out_binary_file| and, unless |transformations| is null,
+// writes the transformations in binary and JSON form next to it.
+bool WriteOutput(
+    const std::string& out_binary_file, const std::vector<uint32_t>& binary,
+    const spvtools::fuzz::protobufs::TransformationSequence* transformations) {
+  if (!WriteFile<uint32_t>(out_binary_file.c_str(), "wb", binary.data(),
+                           binary.size())) {
+    spvtools::Error(FuzzDiagnostic, nullptr, {}, "Error writing out binary");
+    return false;
+  }
+
+  if (!transformations) {
+    return true;
+  }
+
+  // If not found, dot_pos will be std::string::npos, which can be used in
+  // substr to mean "the end of the string"; there is no need to check the
+  // result.
+  size_t dot_pos = out_binary_file.rfind('.');
+  std::string output_file_prefix = out_binary_file.substr(0, dot_pos);
+  std::ofstream transformations_file;
+  transformations_file.open(output_file_prefix + ".transformations",
+                            std::ios::out | std::ios::binary);
+  bool success = transformations->SerializeToOstream(&transformations_file);
+  transformations_file.close();
+  if (!success) {
+    spvtools::Error(FuzzDiagnostic, nullptr, {},
+                    "Error writing out transformations binary");
+    return false;
+  }
+
+  std::string json_string;
+  auto json_options = google::protobuf::util::JsonPrintOptions();
+  json_options.add_whitespace = true;
+  auto json_generation_status = google::protobuf::util::MessageToJsonString(
+      *transformations, &json_string, json_options);
+  if (!json_generation_status.ok()) {
+    spvtools::Error(FuzzDiagnostic, nullptr, {},
+                    "Error writing out transformations in JSON format");
+    return false;
+  }
+
+  std::ofstream transformations_json_file(output_file_prefix +
+                                          ".transformations_json");
+  transformations_json_file << json_string;
+  transformations_json_file.close();
+  return true;
+}
+
+// Fuzzes the |num_seeds| consecutive seeds starting at |first_seed|, running
+// up to |num_jobs| of them at a time.  Each run builds its own module, contexts
+// and random number generator from the shared, read-only |binary_in|,
+// |initial_facts| and |donor_suppliers|.  The results for seed S are written
+// to <output_S.spv> and its transformation files as soon as the run finishes.
+// Returns true if and only if every run succeeded.
+bool FuzzSeeds(const spv_target_env& target_env,
+               spv_const_fuzzer_options fuzzer_options,
+               spv_validator_options validator_options,
+               const std::vector<uint32_t>& binary_in,
+               const spvtools::fuzz::protobufs::FactSequence& initial_facts,
+               const std::vector<spvtools::fuzz::fuzzerutil::ModuleSupplier>&
+                   donor_suppliers,
+               spvtools::fuzz::RepeatedPassStrategy repeated_pass_strategy,
+               FuzzingTarget fuzzing_target, uint32_t first_seed,
+               uint32_t num_seeds, uint32_t num_jobs,
+               const std::string& out_binary_file) {
+  // If not found, dot_pos will be std::string::npos; the extension is then
+  // empty.
+  const size_t dot_pos = out_binary_file.rfind('.');
+  const std::string prefix = out_binary_file.substr(0, dot_pos);
+  const std::string extension =
+      dot_pos == std::string::npos ? "" : out_binary_file.substr(dot_pos);
+
+  std::atomic<uint32_t> next_run(0);
+  std::atomic<bool> success(true);
+  auto worker = [&]() {
+    for (uint32_t run = next_run++; run < num_seeds; run = next_run++) {
+      const uint32_t seed = first_seed + run;
+      std::vector<uint32_t> binary_out;
+      spvtools::fuzz::protobufs::TransformationSequence transformations_applied;
+      if (!Fuzz(target_env, fuzzer_options, validator_options, binary_in,
+                initial_facts, donor_suppliers, repeated_pass_strategy,
+                fuzzing_target, seed, &binary_out, &transformations_applied) ||
+          !WriteOutput(prefix + "_" + std::to_string(seed) + extension,
+                       binary_out, &transformations_applied)) {
+        spvtools::Error(
+            FuzzDiagnostic, nullptr, {},
+            ("Fuzzing with seed " + std::to_string(seed) + " failed").c_str());
+        success = false;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < std::min(num_jobs, num_seeds); ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) thread.join();
+  return success;
+}
+
 }  // namespace
 
 // Dumps |binary| to file |filename|. Useful for interactive debugging.
@@ -695,6 +847,8 @@ int main(int argc, const char** argv) {
   std::string shrink_temp_file_prefix = "temp_";
   spvtools::fuzz::RepeatedPassStrategy repeated_pass_strategy;
   auto fuzzing_target = FuzzingTarget::kSpirv;
+  uint32_t num_seeds = 1;
+  uint32_t num_jobs = 1;
 
   spvtools::FuzzerOptions fuzzer_options;
   spvtools::ValidatorOptions validator_options;
@@ -703,8 +857,8 @@ int main(int argc, const char** argv) {
       ParseFlags(argc, argv, &in_binary_file, &out_binary_file, &donors_file,
                  &replay_transformations_file, &interestingness_test,
                  &shrink_transformations_file, &shrink_temp_file_prefix,
-                 &repeated_pass_strategy, &fuzzing_target, &fuzzer_options,
-                 &validator_options);
+                 &repeated_pass_strategy, &fuzzing_target, &num_seeds,
+                 &num_jobs, &fuzzer_options, &validator_options);
 
   if (status.action == FuzzActions::STOP) {
     return status.code;
@@ -748,13 +902,32 @@ int main(int argc, const char** argv) {
         return 1;
       }
       break;
-    case FuzzActions::FUZZ:
+    case FuzzActions::FUZZ: {
+      std::vector<spvtools::fuzz::fuzzerutil::ModuleSupplier> donor_suppliers;
+      if (!ReadDonors(target_env, donors_file, &donor_suppliers)) {
+        return 1;
+      }
+      auto const_fuzzer_options =
+          static_cast<spv_const_fuzzer_options>(fuzzer_options);
+      const uint32_t seed =
+          const_fuzzer_options->has_random_seed
+              ? const_fuzzer_options->random_seed
+              : static_cast<uint32_t>(std::random_device()());
+      if (num_seeds > 1) {
+        // Every run writes out its own results.
+        return FuzzSeeds(target_env, fuzzer_options, validator_options,
+                         binary_in, initial_facts, donor_suppliers,
+                         repeated_pass_strategy, fuzzing_target, seed,
+                         num_seeds, num_jobs, out_binary_file)
+                   ? 0
+                   : 1;
+      }
       if (!Fuzz(target_env, fuzzer_options, validator_options, binary_in,
-                initial_facts, donors_file, repeated_pass_strategy,
-                fuzzing_target, &binary_out, &transformations_applied)) {
+                initial_facts, donor_suppliers, repeated_pass_strategy,
+                fuzzing_target, seed, &binary_out, &transformations_applied)) {
         return 1;
       }
-      break;
+    } break;
     case FuzzActions::REPLAY:
       if (!Replay(target_env, fuzzer_options, validator_options, binary_in,
                   initial_facts, replay_transformations_file, &binary_out,
@@ -775,46 +948,12 @@ int main(int argc, const char** argv) {
       break;
   }
 
-  if (!WriteFile<uint32_t>(out_binary_file.c_str(), "wb", binary_out.data(),
-                           binary_out.size())) {
-    spvtools::Error(FuzzDiagnostic, nullptr, {}, "Error writing out binary");
+  if (!WriteOutput(out_binary_file, binary_out,
+                   status.action == FuzzActions::FORCE_RENDER_RED
+                       ? nullptr
+                       : &transformations_applied)) {
     return 1;
   }
 
-  if (status.action != FuzzActions::FORCE_RENDER_RED) {
-    // If not found, dot_pos will be std::string::npos, which can be used in
-    // substr to mean "the end of the string"; there is no need to check the
-    // result.
-    dot_pos = out_binary_file.rfind('.');
-    std::string output_file_prefix = out_binary_file.substr(0, dot_pos);
-    std::ofstream transformations_file;
-    transformations_file.open(output_file_prefix + ".transformations",
-                              std::ios::out | std::ios::binary);
-    bool success =
-        transformations_applied.SerializeToOstream(&transformations_file);
-    transformations_file.close();
-    if (!success) {
-      spvtools::Error(FuzzDiagnostic, nullptr, {},
-                      "Error writing out transformations binary");
-      return 1;
-    }
-
-    std::string json_string;
-    auto json_options = google::protobuf::util::JsonPrintOptions();
-    json_options.add_whitespace = true;
-    auto json_generation_status = google::protobuf::util::MessageToJsonString(
-        transformations_applied, &json_string, json_options);
-    if (!json_generation_status.ok()) {
-      spvtools::Error(FuzzDiagnostic, nullptr, {},
-                      "Error writing out transformations in JSON format");
-      return 1;
-    }
-
-    std::ofstream transformations_json_file(output_file_prefix +
-                                            ".transformations_json");
-    transformations_json_file << json_string;
-    transformations_json_file.close();
-  }
-
   return 0;
 }
@@ -35,6 +35,15 @@
 #define SET_STDOUT_MODE(mode)
 #endif
 
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SPIRV_TOOLS_MMAP_INPUT
+#endif
+
 namespace {
 // Appends the contents of the |file| to |data|, assuming each element in the
 // file is of type |T|.
@@ -98,8 +107,9 @@ enum class HexMode {
 // end-of-file.
 bool IsSpace(char c) { return isspace(c) || c == ',' || c == '\0'; }
 
-bool IsHexStream(const std::vector<char>& stream) {
-  for (char c : stream) {
+bool IsHexStream(const char* begin, const char* end) {
+  for (const char* it = begin; it != end; ++it) {
+    const char c = *it;
     if (IsSpace(c)) {
       continue;
     }
@@ -113,6 +123,10 @@ bool IsHexStream(const std::vector<char>& stream) {
   return false;
 }
 
+bool IsHexStream(const std::vector<char>& stream) {
+  return IsHexStream(stream.data(), stream.data() + stream.size());
+}
+
 bool MatchIgnoreCase(const char* token, const char* expect, size_t len) {
   for (size_t i = 0; i < len; ++i) {
     if (tolower(token[i]) != tolower(expect[i])) {
@@ -388,6 +402,65 @@ bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data) {
   return succeeded;
 }
 
+#if defined(SPIRV_TOOLS_MMAP_INPUT)
+namespace {
+// Maps the regular file |filename| into memory and sets |data| and |size| to
+// the mapping.  Returns false, without writing any error message, if the file
+// is better read by the regular path: it is not a regular file, it is empty,
+// it is not a whole number of words, it is a hex stream or it cannot be
+// mapped.
+bool MapBinaryFile(const char* filename, const uint32_t** data, size_t* size) {
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat info;
+  void* mapping = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 &&
+      info.st_size % sizeof(uint32_t) == 0) {
+    mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                   MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (mapping == MAP_FAILED) return false;
+
+  const size_t mapped_size = static_cast<size_t>(info.st_size);
+  const char* bytes = static_cast<const char*>(mapping);
+  if (IsHexStream(bytes, bytes + mapped_size)) {
+    munmap(mapping, mapped_size);
+    return false;
+  }
+
+  // The module is parsed front to back, exactly once.
+  madvise(mapping, mapped_size, MADV_SEQUENTIAL);
+  *data = static_cast<const uint32_t*>(mapping);
+  *size = mapped_size;
+  return true;
+}
+}  // namespace
+#endif
+
+BinaryFileContents::~BinaryFileContents() {
+#if defined(SPIRV_TOOLS_MMAP_INPUT)
+  if (mapped_ != nullptr) {
+    munmap(const_cast<uint32_t*>(mapped_), mapped_size_);
+  }
+#endif
+}
+
+bool ReadBinaryFile(const char* filename, BinaryFileContents* contents) {
+  assert(contents->empty());
+
+#if defined(SPIRV_TOOLS_MMAP_INPUT)
+  const bool use_file = filename && strcmp("-", filename);
+  if (use_file &&
+      MapBinaryFile(filename, &contents->mapped_, &contents->mapped_size_)) {
+    return true;
+  }
+#endif
+
+  return ReadBinaryFile(filename, &contents->words_);
+}
+
 bool ConvertHexToBinary(const std::vector<char>& stream,
                         std::vector<uint32_t>* data) {
   HexTokenizer tokenizer("<input string>", stream, data);
@@ -461,6 +534,12 @@ bool WriteFile(const char* filename, const char* mode, const T* data,
     return false;
   }
 
+  // A single write of the whole buffer gains nothing from stdio buffering,
+  // which would only copy large outputs through a small buffer.
+  if (strchr(mode, 'b') && fp != stdout) {
+    setvbuf(fp, nullptr, _IONBF, 0);
+  }
+
   size_t written = fwrite(data, sizeof(T), count, fp);
   if (count != written) {
     fprintf(stderr, "error: could not write to file '%s'\n", filename);
@@ -41,6 +41,43 @@
 //    little-endian order
 bool ReadBinaryFile(const char* filename, std::vector<uint32_t>* data);
 
+// The words of a SPIR-V binary read by |ReadBinaryFile|.  On Linux, a binary
+// file is mapped into memory rather than copied, so that the tools can hand
+// the mapping straight to the parser.  Hex streams, standard input and other
+// platforms fall back to a vector of words.  The words must not be accessed
+// once the file they came from has been overwritten.
+class BinaryFileContents {
+ public:
+  BinaryFileContents() = default;
+  BinaryFileContents(const BinaryFileContents&) = delete;
+  BinaryFileContents& operator=(const BinaryFileContents&) = delete;
+  ~BinaryFileContents();
+
+  const uint32_t* data() const {
+    return mapped_ != nullptr ? mapped_ : words_.data();
+  }
+  size_t size() const {
+    return mapped_ != nullptr ? mapped_size_ / sizeof(uint32_t)
+                              : words_.size();
+  }
+  bool empty() const { return size() == 0; }
+
+  // Returns true if the words are backed by a memory mapping of the file.
+  bool is_mapped() const { return mapped_ != nullptr; }
+
+ private:
+  friend bool ReadBinaryFile(const char* filename,
+                             BinaryFileContents* contents);
+
+  const uint32_t* mapped_ = nullptr;
+  size_t mapped_size_ = 0;
+  std::vector<uint32_t> words_;
+};
+
+// Same as above, but reads the binary into |contents|, which must be empty.
+// The file is memory mapped if possible.
+bool ReadBinaryFile(const char* filename, BinaryFileContents* contents);
+
 // The hex->binary logic of |ReadBinaryFile| applied to a pre-loaded stream of
 // bytes.  Used by tests to avoid having to call |ReadBinaryFile| with temp
 // files.  Returns false in case of parse errors.
@@ -58,6 +95,9 @@ bool ReadTextFile(const char* filename, std::vector<char>* data);
 // |mode|, assuming |data| is an array of |count| elements of type |T|. If
 // |filename| is nullptr or "-", writes to standard output. If any error occurs,
 // returns false and outputs error message to standard error.
+//
+// Binary data is written straight from |data|, without being staged through
+// a stdio buffer.
 template <typename T>
 bool WriteFile(const char* filename, const char* mode, const T* data,
                size_t count);
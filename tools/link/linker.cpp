@@ -56,6 +56,14 @@ Options (in lexicographical order):
                Link the binaries into a library, keeping all exported symbols.
   -h, --help
                Print this help.
+  --streaming
+               Load and merge the input modules one at a time, moving their
+               instructions into the linked module and merging identical
+               types as they are read, to reduce the memory used when linking
+               many or large modules. The output is the same as without this
+               option, except for the ids when the inputs have NonSemantic
+               DebugLine or DebugNoLine instructions. Ignored when
+               --fnvar-targets or --fnvar-architectures is used.
   --target-env <env>
                Set the environment used for interpreting the inputs. Without
                this option the environment defaults to spv1.6. <env> must be
@@ -97,6 +105,7 @@ FLAG_LONG_bool(   verify_ids,             /* default_value= */ false,
 FLAG_LONG_bool(   create_library,         /* default_value= */ false,               /* required= */ false);
 FLAG_LONG_bool(   allow_partial_linkage,  /* default_value= */ false,               /* required= */ false);
 FLAG_LONG_bool(   allow_pointer_mismatch, /* default_value= */ false,               /* required= */ false);
+FLAG_LONG_bool(   streaming,              /* default_value= */ false,               /* required= */ false);
 FLAG_SHORT_string(o,                      /* default_value= */ "",                  /* required= */ false);
 FLAG_LONG_string( target_env,             /* default_value= */ kDefaultEnvironment, /* required= */ false);
 FLAG_LONG_string( fnvar_targets,          /* default_value= */ "",                  /* required= */ false);
@@ -147,6 +156,7 @@ int main(int, const char* argv[]) {
   options.SetCreateLibrary(flags::create_library.value());
   options.SetVerifyIds(flags::verify_ids.value());
   options.SetUseHighestVersion(flags::use_highest_version.value());
+  options.SetStreaming(flags::streaming.value());
 
   if (inFiles.empty()) {
     fprintf(stderr, "error: No input file specified\n");
@@ -180,9 +190,13 @@ int main(int, const char* argv[]) {
 
   options.SetHasFnVarCapabilities(flags::fnvar_capabilities.value());
 
-  std::vector<std::vector<uint32_t>> contents(inFiles.size());
+  std::vector<BinaryFileContents> contents(inFiles.size());
+  std::vector<const uint32_t*> binaries(inFiles.size());
+  std::vector<size_t> binary_sizes(inFiles.size());
   for (size_t i = 0u; i < inFiles.size(); ++i) {
     if (!ReadBinaryFile(inFiles[i].c_str(), &contents[i])) return 1;
+    binaries[i] = contents[i].data();
+    binary_sizes[i] = contents[i].size();
   }
 
   const spvtools::MessageConsumer consumer = [](spv_message_level_t level,
@@ -211,7 +225,11 @@ int main(int, const char* argv[]) {
   context.SetMessageConsumer(consumer);
 
   std::vector<uint32_t> linkingResult;
-  spv_result_t status = Link(context, contents, &linkingResult, options);
+  spv_result_t status =
+      Link(context, binaries.data(), binary_sizes.data(), binaries.size(),
+           &linkingResult, options);
+  // Release the inputs before writing, in case the output is one of them.
+  contents.clear();
   if (status != SPV_SUCCESS && status != SPV_WARNING) return 1;
 
   if (!WriteFile<uint32_t>(outFile.c_str(), "wb", linkingResult.data(),
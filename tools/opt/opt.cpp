@@ -13,13 +13,17 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "source/opt/log.h"
@@ -40,6 +44,25 @@ struct OptStatus {
   int code;
 };
 
+// Settings of the --batch mode.
+struct BatchOptions {
+  bool enabled = false;
+  // Number of modules optimized at the same time.  Zero means one per
+  // hardware thread.
+  uint32_t num_jobs = 0;
+  // Whether a flag that prints reports to standard error while optimizing was
+  // given.  Reports of concurrent runs would be interleaved.
+  bool has_report_flag = false;
+};
+
+// Settings of --pass-profile and --pass-trace.
+struct ProfileOptions {
+  // The file the profile is written to.  Empty if passes are not profiled.
+  std::string file;
+  // Whether the profile is written as Chrome trace events instead of JSON.
+  bool chrome_trace = false;
+};
+
 // Message consumer for this tool.  Used to emit diagnostics during
 // initialization and setup. Note that |source| and |position| are irrelevant
 // here because we are still not processing a SPIR-V input file.
@@ -86,22 +109,40 @@ void PrintUsage(const char* program) {
       R"(%s - Optimize a SPIR-V binary file.
 
 USAGE: %s [options] [<input>] -o <output>
+       %s --batch [options] <manifest or directory> -o <output directory>
 
 The SPIR-V binary is read from <input>. If no file is specified,
 or if <input> is "-", then the binary is read from standard input.
 if <output> is "-", then the optimized output is written to
 standard output.
 
+With --batch, many modules are optimized with the same options in a
+single run.  See --batch below.
+
 NOTE: The optimizer is a work in progress.
 
 Options (in lexicographical order):)",
-      program, program);
+      program, program, program);
   printf(R"(
   --amd-ext-to-khr
                Replaces the extensions VK_AMD_shader_ballot, VK_AMD_gcn_shader,
                and VK_AMD_shader_trinary_minmax with equivalent code using core
                instructions and capabilities.)");
   printf(R"(
+  --batch
+               Optimize every module listed by <input> instead of a single
+               module, on several threads.  If <input> is a directory, every
+               .spv file below it is optimized and written to the same
+               relative path below the output directory.  Otherwise <input>
+               is a manifest with one module per line, given as
+               "<input file> [<output file>]".  A module without an output
+               file is written to the output directory under its file name.
+               Empty lines and lines starting with '#' are ignored.  One
+               "<input file>: ok" or "<input file>: failed" line is printed
+               for each module, in order, and the exit code is non-zero if
+               any module failed.  Diagnostics are printed to standard error,
+               prefixed with the input file.)");
+  printf(R"(
   --before-hlsl-legalization
                Forwards this option to the validator.  See the validator help
                for details.)");
@@ -269,6 +310,10 @@ Options (in lexicographical order):)",
                functions. Currently does not inline calls to functions with
                early return in a loop.)");
   printf(R"(
+  --jobs=<n>
+               Number of modules optimized at the same time in --batch mode.
+               Defaults to the number of hardware threads.)");
+  printf(R"(
   --legalize-hlsl
                Runs a series of optimizations that attempts to take SPIR-V
                generated by an HLSL front-end and generates legal Vulkan SPIR-V.
@@ -406,6 +451,17 @@ Options (in lexicographical order):)",
                --merge-blocks followed by all the transformations implied by
                -O.)");
   printf(R"(
+  --pass-profile=<file>
+               Write a profile of the passes to <file> as JSON.  For every
+               pass, it records the wall time, the analyses built and
+               invalidated, the instructions created and killed, the bytes
+               allocated for instructions and basic blocks, and the def-use
+               updates.)");
+  printf(R"(
+  --pass-trace=<file>
+               Same as --pass-profile, but write the profile as Chrome trace
+               events, which can be loaded in chrome://tracing or Perfetto.)");
+  printf(R"(
   --preserve-bindings
                Ensure that the optimizer preserves all bindings declared within
                the module, even when those bindings are unused.)");
@@ -655,20 +711,25 @@ OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
                      const char** out_file,
                      spvtools::ValidatorOptions* validator_options,
-                     spvtools::OptimizerOptions* optimizer_options);
+                     spvtools::OptimizerOptions* optimizer_options,
+                     BatchOptions* batch_options,
+                     ProfileOptions* profile_options);
 
 // Parses and handles the -Oconfig flag. |prog_name| contains the name of
 // the spirv-opt binary (used to build a new argv vector for the recursive
 // invocation to ParseFlags). |opt_flag| contains the -Oconfig=FILENAME flag.
-// |optimizer|, |in_file|, |out_file|, |validator_options|, and
-// |optimizer_options| are as in ParseFlags.
+// |optimizer|, |in_file|, |out_file|, |validator_options|,
+// |optimizer_options|, |batch_options| and |profile_options| are as in
+// ParseFlags.
 //
 // This returns the same OptStatus instance returned by ParseFlags.
 OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
                            spvtools::Optimizer* optimizer, const char** in_file,
                            const char** out_file,
                            spvtools::ValidatorOptions* validator_options,
-                           spvtools::OptimizerOptions* optimizer_options) {
+                           spvtools::OptimizerOptions* optimizer_options,
+                           BatchOptions* batch_options,
+                           ProfileOptions* profile_options) {
   std::vector<std::string> flags;
   flags.push_back(prog_name);
 
@@ -691,9 +752,9 @@ OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
     new_argv[i] = flags[i].c_str();
   }
 
-  auto ret_val =
-      ParseFlags(static_cast<int>(flags.size()), new_argv, optimizer, in_file,
-                 out_file, validator_options, optimizer_options);
+  auto ret_val = ParseFlags(static_cast<int>(flags.size()), new_argv,
+                            optimizer, in_file, out_file, validator_options,
+                            optimizer_options, batch_options, profile_options);
   delete[] new_argv;
   return ret_val;
 }
@@ -743,14 +804,17 @@ std::string CanonicalizeFlag(const char** argv, int argc, int* argi) {
 // Optimizer instance used to optimize the program.
 //
 // On return, this function stores the name of the input program in |in_file|.
-// The name of the output file in |out_file|. The return value indicates whether
-// optimization should continue and a status code indicating an error or
-// success.
+// The name of the output file in |out_file|, the --batch settings in
+// |batch_options| and the profile settings in |profile_options|. The return
+// value indicates whether optimization should continue and a status code
+// indicating an error or success.
 OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
                      const char** out_file,
                      spvtools::ValidatorOptions* validator_options,
-                     spvtools::OptimizerOptions* optimizer_options) {
+                     spvtools::OptimizerOptions* optimizer_options,
+                     BatchOptions* batch_options,
+                     ProfileOptions* profile_options) {
   std::vector<std::string> pass_flags;
   bool preserve_interface = false;
   for (int argi = 1; argi < argc; ++argi) {
@@ -780,22 +844,42 @@ OptStatus ParseFlags(int argc, const char** argv,
           return {OPT_STOP, 1};
         }
       } else if (0 == strncmp(cur_arg, "-Oconfig=", sizeof("-Oconfig=") - 1)) {
-        OptStatus status =
-            ParseOconfigFlag(argv[0], cur_arg, optimizer, in_file, out_file,
-                             validator_options, optimizer_options);
+        OptStatus status = ParseOconfigFlag(
+            argv[0], cur_arg, optimizer, in_file, out_file, validator_options,
+            optimizer_options, batch_options, profile_options);
         if (status.action != OPT_CONTINUE) {
           return status;
         }
       } else if (0 == strcmp(cur_arg, "--skip-validation")) {
         optimizer_options->set_run_validator(false);
+      } else if (0 == strcmp(cur_arg, "--batch")) {
+        batch_options->enabled = true;
+      } else if (0 == strncmp(cur_arg, "--jobs=", sizeof("--jobs=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        if (1 != sscanf(split_flag.second.c_str(), "%u",
+                        &batch_options->num_jobs)) {
+          spvtools::Error(opt_diagnostic, nullptr, {},
+                          "Invalid value passed to --jobs");
+          return {OPT_STOP, 1};
+        }
+      } else if (0 == strncmp(cur_arg, "--pass-profile=",
+                              sizeof("--pass-profile=") - 1) ||
+                 0 == strncmp(cur_arg, "--pass-trace=",
+                              sizeof("--pass-trace=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        profile_options->file = split_flag.second;
+        profile_options->chrome_trace = split_flag.first == "pass-trace";
+        batch_options->has_report_flag = true;
       } else if (0 == strcmp(cur_arg, "--print-all")) {
         optimizer->SetPrintAll(&std::cerr);
+        batch_options->has_report_flag = true;
       } else if (0 == strcmp(cur_arg, "--preserve-bindings")) {
         optimizer_options->set_preserve_bindings(true);
       } else if (0 == strcmp(cur_arg, "--preserve-spec-constants")) {
         optimizer_options->set_preserve_spec_constants(true);
       } else if (0 == strcmp(cur_arg, "--time-report")) {
         optimizer->SetTimeReport(&std::cerr);
+        batch_options->has_report_flag = true;
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         validator_options->SetRelaxStructStore(true);
       } else if (0 == strncmp(cur_arg, "--max-id-bound=",
@@ -873,6 +957,197 @@ OptStatus ParseFlags(int argc, const char** argv,
   return {OPT_CONTINUE, 0};
 }
 
+// A module optimized in --batch mode.
+struct BatchModule {
+  std::string input;
+  std::string output;
+  bool ok = false;
+  // Diagnostics emitted while optimizing the module, one per line.
+  std::string messages;
+};
+
+// Returns |path| as a string.  The copy is needed because in C++20 the result
+// type of std::filesystem::path::u8string changes from std::string to
+// std::u8string.
+std::string PathToString(const std::filesystem::path& path) {
+  const auto path_u8str = path.u8string();
+  return std::string(path_u8str.begin(), path_u8str.end());
+}
+
+// Lists in |modules| the modules named by the --batch input |batch_input|,
+// which is either a directory or a manifest file, with the outputs placed in
+// |out_dir| unless the manifest says otherwise.  Returns false and reports an
+// error if the modules cannot be listed.
+bool CollectBatchModules(const char* batch_input, const char* out_dir,
+                         std::vector<BatchModule>* modules) {
+  const std::filesystem::path out_path(out_dir);
+  std::error_code ec;
+  if (std::filesystem::is_directory(batch_input, ec)) {
+    const std::filesystem::path dir(batch_input);
+    for (const auto& entry :
+         std::filesystem::recursive_directory_iterator(dir, ec)) {
+      if (!entry.is_regular_file() || entry.path().extension() != ".spv") {
+        continue;
+      }
+      BatchModule module;
+      module.input = PathToString(entry.path());
+      module.output = PathToString(
+          out_path / entry.path().lexically_relative(dir));
+      modules->push_back(std::move(module));
+    }
+    if (ec) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {},
+                       "Could not list directory '%s'", batch_input);
+      return false;
+    }
+    // Directory iteration order is unspecified.
+    std::sort(modules->begin(), modules->end(),
+              [](const BatchModule& a, const BatchModule& b) {
+                return a.input < b.input;
+              });
+  } else {
+    std::ifstream manifest(batch_input);
+    if (manifest.fail()) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {}, "Could not open file '%s'",
+                       batch_input);
+      return false;
+    }
+    std::string line;
+    while (std::getline(manifest, line)) {
+      BatchModule module;
+      std::istringstream iss(line);
+      if (!(iss >> module.input) || module.input[0] == '#') continue;
+      if (!(iss >> module.output)) {
+        module.output = PathToString(
+            out_path / std::filesystem::path(module.input).filename());
+      }
+      modules->push_back(std::move(module));
+    }
+  }
+
+  // Modules are written concurrently, so they must not share an output.
+  std::set<std::string> outputs;
+  for (const BatchModule& module : *modules) {
+    if (!outputs.insert(PathToString(std::filesystem::path(module.output)
+                                         .lexically_normal()))
+             .second) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {},
+                       "More than one module is written to '%s'",
+                       module.output.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+// Optimizes |module| with |optimizer| and writes the result to its output
+// file.  Returns true on success.
+bool OptimizeBatchModule(const spvtools::Optimizer& optimizer,
+                         const spvtools::OptimizerOptions& optimizer_options,
+                         const BatchModule& module) {
+  std::vector<uint32_t> binary;
+  {
+    BinaryFileContents contents;
+    if (!ReadBinaryFile(module.input.c_str(), &contents) ||
+        !optimizer.Run(contents.data(), contents.size(), &binary,
+                       optimizer_options)) {
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  const std::filesystem::path output_dir =
+      std::filesystem::path(module.output).parent_path();
+  if (!output_dir.empty()) std::filesystem::create_directories(output_dir, ec);
+  return WriteFile<uint32_t>(module.output.c_str(), "wb", binary.data(),
+                             binary.size());
+}
+
+// Runs the --batch mode: optimizes every module listed by |batch_input| with
+// the options in |argc| and |argv|, on |num_jobs| threads.  Every thread has
+// an Optimizer of its own, set up by parsing the flags again, because passes
+// keep state while they run.  Returns the exit code of the tool.
+int RunBatch(int argc, const char** argv, const char* batch_input,
+             const char* out_dir, uint32_t num_jobs) {
+  std::vector<BatchModule> modules;
+  if (!CollectBatchModules(batch_input, out_dir, &modules)) return 1;
+
+  if (num_jobs == 0) {
+    num_jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_jobs = static_cast<uint32_t>(
+      std::max<size_t>(1, std::min<size_t>(num_jobs, modules.size())));
+
+  // The module each worker is optimizing, so that its diagnostics can be
+  // attributed to it.
+  std::vector<BatchModule*> current(num_jobs, nullptr);
+  std::vector<std::unique_ptr<spvtools::Optimizer>> optimizers;
+  std::vector<spvtools::OptimizerOptions> optimizer_options(num_jobs);
+  for (uint32_t i = 0; i < num_jobs; ++i) {
+    optimizers.push_back(
+        std::make_unique<spvtools::Optimizer>(kDefaultEnvironment));
+    optimizers[i]->SetMessageConsumer(
+        [&module = current[i]](spv_message_level_t level, const char*,
+                               const spv_position_t& position,
+                               const char* message) {
+          std::ostringstream line;
+          switch (level) {
+            case SPV_MSG_FATAL:
+            case SPV_MSG_INTERNAL_ERROR:
+            case SPV_MSG_ERROR:
+              line << "error: ";
+              break;
+            case SPV_MSG_WARNING:
+              line << "warning: ";
+              break;
+            case SPV_MSG_INFO:
+              line << "info: ";
+              break;
+            default:
+              return;
+          }
+          line << module->input << ":" << position.index << ": " << message
+               << "\n";
+          module->messages += line.str();
+        });
+
+    const char* in_file = nullptr;
+    const char* out_file = nullptr;
+    spvtools::ValidatorOptions validator_options;
+    BatchOptions batch_options;
+    ProfileOptions profile_options;
+    OptStatus status = ParseFlags(
+        argc, argv, optimizers[i].get(), &in_file, &out_file,
+        &validator_options, &optimizer_options[i], &batch_options,
+        &profile_options);
+    if (status.action == OPT_STOP) return status.code;
+    optimizer_options[i].set_validator_options(validator_options);
+  }
+
+  std::atomic<size_t> next_module(0);
+  auto worker = [&](uint32_t job) {
+    for (size_t i = next_module++; i < modules.size(); i = next_module++) {
+      current[job] = &modules[i];
+      modules[i].ok = OptimizeBatchModule(*optimizers[job],
+                                          optimizer_options[job], modules[i]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (uint32_t job = 1; job < num_jobs; ++job) {
+    threads.emplace_back(worker, job);
+  }
+  worker(0);
+  for (auto& thread : threads) thread.join();
+
+  bool ok = true;
+  for (const BatchModule& module : modules) {
+    fputs(module.messages.c_str(), stderr);
+    printf("%s: %s\n", module.input.c_str(), module.ok ? "ok" : "failed");
+    ok &= module.ok;
+  }
+  return ok ? 0 : 1;
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
@@ -886,8 +1161,11 @@ int main(int argc, const char** argv) {
 
   spvtools::ValidatorOptions validator_options;
   spvtools::OptimizerOptions optimizer_options;
+  BatchOptions batch_options;
+  ProfileOptions profile_options;
   OptStatus status = ParseFlags(argc, argv, &optimizer, &in_file, &out_file,
-                                &validator_options, &optimizer_options);
+                                &validator_options, &optimizer_options,
+                                &batch_options, &profile_options);
   optimizer_options.set_validator_options(validator_options);
 
   if (status.action == OPT_STOP) {
@@ -899,15 +1177,46 @@ int main(int argc, const char** argv) {
     return 1;
   }
 
-  std::vector<uint32_t> binary;
-  if (!ReadBinaryFile(in_file, &binary)) {
-    return 1;
+  if (batch_options.enabled) {
+    if (in_file == nullptr || 0 == strcmp(in_file, "-") ||
+        0 == strcmp(out_file, "-")) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      "--batch requires an input manifest or directory and an "
+                      "output directory");
+      return 1;
+    }
+    if (batch_options.has_report_flag) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      "--print-all, --time-report, --pass-profile and "
+                      "--pass-trace cannot be used with --batch");
+      return 1;
+    }
+    return RunBatch(argc, argv, in_file, out_file, batch_options.num_jobs);
+  }
+
+  std::ofstream profile_stream;
+  if (!profile_options.file.empty()) {
+    profile_stream.open(profile_options.file);
+    if (profile_stream.fail()) {
+      spvtools::Errorf(opt_diagnostic, nullptr, {}, "Could not open file '%s'",
+                       profile_options.file.c_str());
+      return 1;
+    }
+    optimizer.SetPassProfile(&profile_stream, profile_options.chrome_trace);
   }
 
-  // By using the same vector as input and output, we save time in the case
-  // that there was no change.
-  bool ok =
-      optimizer.Run(binary.data(), binary.size(), &binary, optimizer_options);
+  std::vector<uint32_t> binary;
+  bool ok = false;
+  {
+    // The input may be mapped from |in_file|, which can also be the output
+    // file, so it is released before the output is written.
+    BinaryFileContents contents;
+    if (!ReadBinaryFile(in_file, &contents)) {
+      return 1;
+    }
+    ok = optimizer.Run(contents.data(), contents.size(), &binary,
+                       optimizer_options);
+  }
 
   if (!WriteFile<uint32_t>(out_file, "wb", binary.data(), binary.size())) {
     return 1;
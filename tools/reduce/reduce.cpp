@@ -12,11 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
 #include "source/opt/build_module.h"
@@ -28,6 +32,14 @@
 #include "tools/io.h"
 #include "tools/util/cli_consumer.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define SPIRV_REDUCE_PERSISTENT_TEST
+#endif
+
 namespace {
 
 // Execute a command using the shell.
@@ -42,6 +54,194 @@ bool ExecuteCommand(const std::string& command) {
   return status == 0;
 }
 
+#if defined(SPIRV_REDUCE_PERSISTENT_TEST)
+// Writes all |size| bytes at |data| to |fd|.  Returns false on error.
+bool WriteAll(int fd, const void* data, size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t written = write(fd, bytes, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+// Reads exactly |size| bytes from |fd| into |data|.  Returns false on error or
+// end of file.  Blocks for as long as the writer keeps |fd| open.
+bool ReadAll(int fd, void* data, size_t size) {
+  char* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    const ssize_t num_read = read(fd, bytes, size);
+    if (num_read < 0 && errno == EINTR) continue;
+    if (num_read <= 0) return false;
+    bytes += num_read;
+    size -= static_cast<size_t>(num_read);
+  }
+  return true;
+}
+
+// An interestingness test that runs as a long-lived process, which is sent
+// candidate binaries through a pipe.  See --persistent-test in PrintUsage.
+class PersistentTest {
+ public:
+  // Starts |command| with the shell.  Returns nullptr on failure.
+  static std::unique_ptr<PersistentTest> Start(const std::string& command) {
+    int to_child[2];
+    int from_child[2];
+    if (pipe(to_child) != 0) return nullptr;
+    if (pipe(from_child) != 0) {
+      close(to_child[0]);
+      close(to_child[1]);
+      return nullptr;
+    }
+    const pid_t pid = fork();
+    if (pid == 0) {
+      dup2(to_child[0], STDIN_FILENO);
+      dup2(from_child[1], STDOUT_FILENO);
+      close(to_child[0]);
+      close(to_child[1]);
+      close(from_child[0]);
+      close(from_child[1]);
+      execl("/bin/sh", "sh", "-c", command.c_str(),
+            static_cast<char*>(nullptr));
+      _exit(127);
+    }
+    close(to_child[0]);
+    close(from_child[1]);
+    if (pid < 0) {
+      close(to_child[1]);
+      close(from_child[0]);
+      return nullptr;
+    }
+    // Keep our ends of the pipes out of the processes started after this one,
+    // so that each process sees the end of its input when we close it.
+    fcntl(to_child[1], F_SETFD, FD_CLOEXEC);
+    fcntl(from_child[0], F_SETFD, FD_CLOEXEC);
+    return std::unique_ptr<PersistentTest>(
+        new PersistentTest(pid, to_child[1], from_child[0]));
+  }
+
+  PersistentTest(const PersistentTest&) = delete;
+  PersistentTest& operator=(const PersistentTest&) = delete;
+
+  // Closes the input of the process, which should make it exit, and waits for
+  // it.  A process that broke the protocol is killed instead.
+  ~PersistentTest() {
+    close(to_child_);
+    close(from_child_);
+    if (broken_) kill(pid_, SIGKILL);
+    int status = 0;
+    while (waitpid(pid_, &status, 0) < 0 && errno == EINTR) {
+    }
+  }
+
+  // Sends |binary| to the process and stores its verdict in |interesting|.
+  // Returns false if the process could not be talked to, in which case it
+  // must not be used again.
+  bool Test(const std::vector<uint32_t>& binary, bool* interesting) {
+    const size_t num_bytes = binary.size() * sizeof(uint32_t);
+    const unsigned char header[4] = {
+        static_cast<unsigned char>(num_bytes),
+        static_cast<unsigned char>(num_bytes >> 8),
+        static_cast<unsigned char>(num_bytes >> 16),
+        static_cast<unsigned char>(num_bytes >> 24)};
+    unsigned char verdict = 0;
+    if (!WriteAll(to_child_, header, sizeof(header)) ||
+        !WriteAll(to_child_, binary.data(), num_bytes) ||
+        !ReadAll(from_child_, &verdict, 1)) {
+      broken_ = true;
+      return false;
+    }
+    *interesting = verdict != 0;
+    return true;
+  }
+
+ private:
+  PersistentTest(pid_t pid, int to_child, int from_child)
+      : pid_(pid), to_child_(to_child), from_child_(from_child) {}
+
+  const pid_t pid_;
+  const int to_child_;
+  const int from_child_;
+  bool broken_ = false;
+};
+
+// A set of persistent test processes, one for each candidate that may be
+// tested concurrently.
+class PersistentTestPool {
+ public:
+  // Starts |count| processes running |command|.  Returns false on failure.
+  bool Start(const std::string& command, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      std::unique_ptr<PersistentTest> test = PersistentTest::Start(command);
+      if (!test) return false;
+      idle_.push_back(std::move(test));
+    }
+    live_ = idle_.size();
+    return true;
+  }
+
+  // Tests |binary| with an idle process, waiting for one if needed.  If a
+  // process fails, it is shut down, the failure is reported and the binary is
+  // deemed not interesting.
+  bool IsInteresting(const std::vector<uint32_t>& binary) {
+    std::unique_ptr<PersistentTest> test;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      idle_available_.wait(lock,
+                           [this]() { return !idle_.empty() || live_ == 0; });
+      if (idle_.empty()) return false;
+      test = std::move(idle_.back());
+      idle_.pop_back();
+    }
+
+    bool interesting = false;
+    const bool ok = test->Test(binary, &interesting);
+    if (!ok) test.reset();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (ok) {
+        idle_.push_back(std::move(test));
+      } else {
+        --live_;
+        if (!failed_) {
+          spvtools::utils::CLIMessageConsumer(
+              SPV_MSG_ERROR, nullptr, {},
+              "The persistent interestingness test exited or closed its "
+              "output.");
+        }
+        failed_ = true;
+      }
+    }
+    if (ok) {
+      idle_available_.notify_one();
+    } else {
+      // Waiters must give up if no process is left.
+      idle_available_.notify_all();
+    }
+    return interesting;
+  }
+
+  // Returns true if any of the processes failed.
+  bool failed() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable idle_available_;
+  std::vector<std::unique_ptr<PersistentTest>> idle_;
+  size_t live_ = 0;
+  bool failed_ = false;
+};
+#endif
+
 // Status and actions to perform after parsing command-line arguments.
 enum ReduceActions { REDUCE_CONTINUE, REDUCE_STOP };
 
@@ -95,6 +295,28 @@ Options (in lexicographical order):
                SPIR-V module that fails to validate.
   -h, --help
                Print this help.
+  --jobs=
+               32-bit unsigned integer specifying how many candidate reduction
+               steps may be evaluated concurrently, each with its own run of
+               the interestingness test.  The default is 1.  For a
+               deterministic interestingness test, the reduced binary does not
+               depend on this number.
+  --persistent-test
+               Run the interestingness test as a long-lived process instead
+               of once per candidate.  The test is started once for each job
+               (see --jobs), without the path of a binary.  It reads requests
+               from its standard input until the end of the input, and answers
+               each one on its standard output:
+                 - a request is the size of a SPIR-V binary in bytes, as a
+                   4-byte little-endian integer, followed by the binary, in the
+                   same form as a .spv file;
+                 - the answer is a single byte, which is 1 if the binary is
+                   interesting and 0 otherwise.  The test must flush its
+                   output after each answer.
+               No temporary files are written in this mode.  The reduction
+               fails if a test process exits or closes its output; as with the
+               default mode, there is no time limit on an answer, so a test
+               that hangs makes the reducer wait.  Not available on Windows.
   --step-limit=
                32-bit unsigned integer specifying maximum number of steps the
                reducer will take before giving up.
@@ -142,6 +364,7 @@ ReduceStatus ParseFlags(int argc, const char** argv,
                         std::string* out_binary_file,
                         std::vector<std::string>* interestingness_test,
                         std::string* temp_file_prefix,
+                        bool* persistent_test,
                         spvtools::ReducerOptions* reducer_options,
                         spvtools::ValidatorOptions* validator_options) {
   uint32_t positional_arg_index = 0;
@@ -173,6 +396,14 @@ ReduceStatus ParseFlags(int argc, const char** argv,
             static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
         assert(end != split_flag.second.c_str() && errno == 0);
         reducer_options->set_step_limit(step_limit);
+      } else if (0 == strncmp(cur_arg, "--jobs=", sizeof("--jobs=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        char* end = nullptr;
+        errno = 0;
+        const auto num_threads =
+            static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
+        assert(end != split_flag.second.c_str() && errno == 0);
+        reducer_options->set_num_threads(num_threads);
       } else if (0 == strncmp(cur_arg, "--target-function=",
                               sizeof("--target-function=") - 1)) {
         const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
@@ -182,6 +413,15 @@ ReduceStatus ParseFlags(int argc, const char** argv,
             static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
         assert(end != split_flag.second.c_str() && errno == 0);
         reducer_options->set_target_function(target_function);
+      } else if (0 == strcmp(cur_arg, "--persistent-test")) {
+#if defined(SPIRV_REDUCE_PERSISTENT_TEST)
+        *persistent_test = true;
+#else
+        (void)persistent_test;
+        spvtools::Error(ReduceDiagnostic, nullptr, {},
+                        "--persistent-test is not supported on this platform");
+        return {REDUCE_STOP, 1};
+#endif
       } else if (0 == strcmp(cur_arg, "--fail-on-validation-error")) {
         reducer_options->set_fail_on_validation_error(true);
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
@@ -264,6 +504,7 @@ int main(int argc, const char** argv) {
   std::string out_binary_file;
   std::vector<std::string> interestingness_test;
   std::string temp_file_prefix = "temp_";
+  bool persistent_test = false;
 
   spv_target_env target_env = kDefaultEnvironment;
   spvtools::ReducerOptions reducer_options;
@@ -271,7 +512,8 @@ int main(int argc, const char** argv) {
 
   ReduceStatus status = ParseFlags(
       argc, argv, &in_binary_file, &out_binary_file, &interestingness_test,
-      &temp_file_prefix, &reducer_options, &validator_options);
+      &temp_file_prefix, &persistent_test, &reducer_options,
+      &validator_options);
 
   if (status.action == REDUCE_STOP) {
     return status.code;
@@ -286,21 +528,45 @@ int main(int argc, const char** argv) {
   }
   std::string interestingness_command_joined = joined.str();
 
-  reducer.SetInterestingnessFunction(
-      [interestingness_command_joined, temp_file_prefix](
-          std::vector<uint32_t> binary, uint32_t reductions_applied) -> bool {
-        std::stringstream ss;
-        ss << temp_file_prefix << std::setw(4) << std::setfill('0')
-           << reductions_applied << ".spv";
-        const auto spv_file = ss.str();
-        const std::string command =
-            interestingness_command_joined + " " + spv_file;
-        auto write_file_succeeded =
-            WriteFile(spv_file.c_str(), "wb", &binary[0], binary.size());
-        (void)(write_file_succeeded);
-        assert(write_file_succeeded);
-        return ExecuteCommand(command);
-      });
+#if defined(SPIRV_REDUCE_PERSISTENT_TEST)
+  PersistentTestPool persistent_tests;
+#endif
+  if (persistent_test) {
+#if defined(SPIRV_REDUCE_PERSISTENT_TEST)
+    // A process that exits early must not kill the reducer when it writes the
+    // next request; the failed write is reported instead.
+    signal(SIGPIPE, SIG_IGN);
+    if (!persistent_tests.Start(
+            interestingness_command_joined,
+            std::max(1u, (*reducer_options).num_threads))) {
+      spvtools::Error(ReduceDiagnostic, nullptr, {},
+                      "Failed to start the interestingness test");
+      return 1;
+    }
+    reducer.SetInterestingnessFunction(
+        [&persistent_tests](const std::vector<uint32_t>& binary,
+                            uint32_t) -> bool {
+          return persistent_tests.IsInteresting(binary);
+        });
+#endif
+  } else {
+    reducer.SetInterestingnessFunction(
+        [interestingness_command_joined, temp_file_prefix](
+            std::vector<uint32_t> binary,
+            uint32_t reductions_applied) -> bool {
+          std::stringstream ss;
+          ss << temp_file_prefix << std::setw(4) << std::setfill('0')
+             << reductions_applied << ".spv";
+          const auto spv_file = ss.str();
+          const std::string command =
+              interestingness_command_joined + " " + spv_file;
+          auto write_file_succeeded =
+              WriteFile(spv_file.c_str(), "wb", &binary[0], binary.size());
+          (void)(write_file_succeeded);
+          assert(write_file_succeeded);
+          return ExecuteCommand(command);
+        });
+  }
 
   reducer.AddDefaultReductionPasses();
 
@@ -344,6 +610,12 @@ int main(int argc, const char** argv) {
     return 1;
   }
 
+#if defined(SPIRV_REDUCE_PERSISTENT_TEST)
+  if (persistent_tests.failed()) {
+    return 1;
+  }
+#endif
+
   // These are the only successful statuses.
   switch (reduction_status) {
     case spvtools::reduce::Reducer::ReductionResultStatus::kComplete:
@@ -76,6 +76,13 @@ Options:
                                    not be allowed by the target environment.
   --before-hlsl-legalization       Allows code patterns that are intended to be
                                    fixed by spirv-opt's legalization passes.
+  --jobs                           <number of threads used to check function bodies>
+                                   Defaults to 1. The reported diagnostic does not depend
+                                   on the number of threads.
+  --level                          {full|fast}
+                                   The set of checks to run. Defaults to full. The fast level
+                                   only runs the structural checks, skipping the image, built-in,
+                                   block layout and ray tracing checks.
   --version                        Display validator version information.
   --target-env                     {%s}
                                    Use validation rules from the specified environment.
@@ -86,7 +93,7 @@ Options:
 bool process_single_file(const char* filename, spv_target_env& target_env,
                          spvtools::ValidatorOptions& options,
                          bool use_default_msg_consumer) {
-  std::vector<uint32_t> contents;
+  BinaryFileContents contents;
   if (!ReadBinaryFile(filename, &contents)) return false;
 
   spvtools::SpirvTools tools(target_env);
@@ -200,6 +207,34 @@ int main(int argc, char** argv) {
           continue_processing = false;
           return_code = 1;
         }
+      } else if (0 == strcmp(cur_arg, "--jobs")) {
+        uint32_t num_threads = 0;
+        if (argi + 1 < argc &&
+            1 == sscanf(argv[++argi], "%u", &num_threads)) {
+          options.SetNumThreads(num_threads);
+        } else {
+          fprintf(stderr, "error: Missing argument to --jobs\n");
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--level")) {
+        if (argi + 1 < argc) {
+          const char* level_str = argv[++argi];
+          if (0 == strcmp(level_str, "full")) {
+            options.SetLevel(SPV_VALIDATOR_LEVEL_FULL);
+          } else if (0 == strcmp(level_str, "fast")) {
+            options.SetLevel(SPV_VALIDATOR_LEVEL_FAST);
+          } else {
+            fprintf(stderr, "error: Unrecognized validator level: %s\n",
+                    level_str);
+            continue_processing = false;
+            return_code = 1;
+          }
+        } else {
+          fprintf(stderr, "error: Missing argument to --level\n");
+          continue_processing = false;
+          return_code = 1;
+        }
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
         options.SetBeforeHlslLegalization(true);
       } else if (0 == strcmp(cur_arg, "--relax-logical-pointer")) {